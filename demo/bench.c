@@ -0,0 +1,1045 @@
+/* Benchmark of the public functions.
+ *
+ * Every operation of the registry below is timed over a sweep of operand
+ * sizes. For each size the inputs are drawn from a deterministic stream,
+ * the number of calls per sample is doubled until a sample takes at least
+ * the minimum time, then the warmup samples are discarded and the median,
+ * the 99th percentile, the mean and a 95% confidence interval of the median
+ * are computed from the remaining ones. The results are printed as a table,
+ * as CSV or JSON, or written to logs/<name>.log in the two column format of
+ * the gnuplot scripts in logs/.
+ *
+ * With -d the operations are also run by the MPI library of mtest/ on the
+ * same inputs, the results are compared and both timings are reported with
+ * the speedup over MPI. An operation which is significantly slower than MPI,
+ * i.e. whose confidence interval lies above the one of MPI, is flagged.
+ *
+ * With -p the hardware counters are read around the measured samples, and
+ * the instructions per cycle, the branch misses per call and the L1D and
+ * LLC misses per digit are reported as well.
+ *
+ * bench -l lists the operations, bench -h the options.
+ */
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <sched.h>
+#endif
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <tommath.h>
+
+#include "bench_mpi.h"
+#include "perf_counters.h"
+
+#ifndef MP_VERSION
+#define MP_BENCH_VERSION ""
+#else
+#define MP_BENCH_VERSION "-" MP_VERSION
+#endif
+
+#define CHECK_OK(x) do { mp_err err; if ((err = (x)) != MP_OKAY) { fprintf(stderr, "%d: CHECK_OK(%s) failed: %s\n", __LINE__, #x, mp_error_to_string(err)); exit(EXIT_FAILURE); } }while(0)
+
+#define BENCH_MAX_SIZES 64
+#define BENCH_MAX_REPS  1001
+
+/* the operands of an operation, set up for "bits" by its setup function */
+typedef struct bench_op bench_op;
+
+typedef struct {
+   mp_int a, b, c, d, m, r;
+   int bits;
+   unsigned char *buf;
+   char *str;
+   size_t size;
+   mp_rng rng;
+   const bench_op *op;
+   bench_mpi *mpi;
+} bench_ctx;
+
+struct bench_op {
+   const char *name;
+   const char *log;           /* the name of the log file, if it differs */
+   int max_bits;              /* the default end of the sweep */
+   mp_err(*setup)(bench_ctx *ctx);
+   mp_err(*run)(bench_ctx *ctx);
+   bench_mpi_op ref;          /* the same operation in MPI, if any */
+};
+
+#define BENCH_PERF 4
+
+typedef struct {
+   double median, p99, mean, stddev, ci_low, ci_high;
+   /* IPC, branch misses per call, L1D and LLC misses per digit, -1 if not counted */
+   double perf[BENCH_PERF];
+   unsigned long iters;
+   int reps;
+} bench_stats;
+
+typedef enum {
+   BENCH_TEXT,
+   BENCH_CSV,
+   BENCH_JSON,
+   BENCH_LOG
+} bench_format;
+
+typedef struct {
+   bench_format format;
+   FILE *out;
+   int sizes[BENCH_MAX_SIZES], nsizes, lo, hi, step;
+   int reps, warmup, cpu;
+   double min_ns;
+   unsigned long seed;
+   int diff;
+   perf_counters *perf;       /* NULL without -p */
+} bench_opts;
+
+/* ---> Inputs <--- */
+
+static mp_err s_rand(bench_ctx *ctx, mp_int *a, int bits)
+{
+   mp_err err;
+   if ((err = mp_rand_bits(&ctx->rng, a, bits - 1)) != MP_OKAY) {
+      return err;
+   }
+   /* exactly "bits" bits */
+   return mp_add(a, &ctx->m, a);
+}
+
+static mp_err s_top(bench_ctx *ctx, int bits)
+{
+   return mp_2expt(&ctx->m, bits - 1);
+}
+
+static mp_err s_two(bench_ctx *ctx, int abits, int bbits)
+{
+   mp_err err;
+   if ((err = s_top(ctx, abits)) != MP_OKAY) return err;
+   if ((err = s_rand(ctx, &ctx->a, abits)) != MP_OKAY) return err;
+   if ((err = s_top(ctx, bbits)) != MP_OKAY) return err;
+   return s_rand(ctx, &ctx->b, bbits);
+}
+
+static mp_err s_buf(bench_ctx *ctx, size_t size)
+{
+   free(ctx->buf);
+   ctx->size = size;
+   ctx->buf = (unsigned char *)malloc(size);
+   ctx->str = (char *)ctx->buf;
+   return (ctx->buf == NULL) ? MP_MEM : MP_OKAY;
+}
+
+static mp_err setup_ab(bench_ctx *ctx)
+{
+   return s_two(ctx, ctx->bits, ctx->bits);
+}
+
+static mp_err setup_div(bench_ctx *ctx)
+{
+   return s_two(ctx, 2 * ctx->bits, ctx->bits);
+}
+
+static mp_err setup_a2(bench_ctx *ctx)
+{
+   return s_two(ctx, 2 * ctx->bits, 8);
+}
+
+/* b is a prime of "bits" bits */
+static mp_err s_prime(bench_ctx *ctx, mp_int *p)
+{
+   mp_err err;
+   if ((err = s_top(ctx, ctx->bits)) != MP_OKAY) return err;
+   if ((err = s_rand(ctx, p, ctx->bits)) != MP_OKAY) return err;
+   return mp_prime_next_prime(p, mp_prime_rabin_miller_trials(ctx->bits), false);
+}
+
+static mp_err setup_invmod(bench_ctx *ctx)
+{
+   mp_err err;
+   if ((err = setup_ab(ctx)) != MP_OKAY) return err;
+   do {
+      if ((err = mp_add_d(&ctx->b, 1u, &ctx->b)) != MP_OKAY) return err;
+      if ((err = mp_gcd(&ctx->a, &ctx->b, &ctx->c)) != MP_OKAY) return err;
+   } while (mp_cmp_d(&ctx->c, 1u) != MP_EQ);
+   return MP_OKAY;
+}
+
+static mp_err setup_exptmod(bench_ctx *ctx)
+{
+   mp_err err;
+   if ((err = setup_ab(ctx)) != MP_OKAY) return err;
+   /* an odd modulus in d, Montgomery reduction */
+   if ((err = s_rand(ctx, &ctx->d, ctx->bits)) != MP_OKAY) return err;
+   ctx->d.dp[0] |= 1u;
+   return mp_mod(&ctx->a, &ctx->d, &ctx->a);
+}
+
+static mp_err setup_prime(bench_ctx *ctx)
+{
+   return s_prime(ctx, &ctx->a);
+}
+
+static mp_err setup_next_prime(bench_ctx *ctx)
+{
+   mp_err err;
+   if ((err = s_top(ctx, ctx->bits)) != MP_OKAY) return err;
+   return s_rand(ctx, &ctx->b, ctx->bits);
+}
+
+/* a quadratic residue a modulo the prime d */
+static mp_err setup_sqrtmod(bench_ctx *ctx)
+{
+   mp_err err;
+   if ((err = s_prime(ctx, &ctx->d)) != MP_OKAY) return err;
+   if ((err = s_rand(ctx, &ctx->b, ctx->bits)) != MP_OKAY) return err;
+   return mp_sqrmod(&ctx->b, &ctx->d, &ctx->a);
+}
+
+static mp_err setup_kronecker(bench_ctx *ctx)
+{
+   mp_err err;
+   if ((err = setup_ab(ctx)) != MP_OKAY) return err;
+   ctx->b.dp[0] |= 1u;
+   return MP_OKAY;
+}
+
+static mp_err setup_expt(bench_ctx *ctx)
+{
+   mp_err err;
+   if ((err = s_top(ctx, (ctx->bits + 15) / 16)) != MP_OKAY) return err;
+   return s_rand(ctx, &ctx->a, (ctx->bits + 15) / 16);
+}
+
+static mp_err setup_to_radix(bench_ctx *ctx)
+{
+   mp_err err;
+   if ((err = setup_ab(ctx)) != MP_OKAY) return err;
+   return s_buf(ctx, (size_t)ctx->bits + 2u);
+}
+
+static mp_err s_setup_read_radix(bench_ctx *ctx, int radix)
+{
+   mp_err err;
+   if ((err = setup_to_radix(ctx)) != MP_OKAY) return err;
+   return mp_to_radix(&ctx->a, ctx->str, ctx->size, NULL, radix);
+}
+
+static mp_err setup_read_dec(bench_ctx *ctx)
+{
+   return s_setup_read_radix(ctx, 10);
+}
+
+static mp_err setup_read_hex(bench_ctx *ctx)
+{
+   return s_setup_read_radix(ctx, 16);
+}
+
+static mp_err setup_from_ubin(bench_ctx *ctx)
+{
+   mp_err err;
+   if ((err = setup_to_radix(ctx)) != MP_OKAY) return err;
+   return mp_to_ubin(&ctx->a, ctx->buf, ctx->size, NULL);
+}
+
+static mp_err setup_unpack(bench_ctx *ctx)
+{
+   mp_err err;
+   if ((err = setup_to_radix(ctx)) != MP_OKAY) return err;
+   return mp_pack(ctx->buf, ctx->size / 8u, NULL, MP_LSB_FIRST, 8u, MP_NATIVE_ENDIAN, 0u, &ctx->a);
+}
+
+/* ---> Operations <--- */
+
+static mp_err run_add(bench_ctx *ctx)
+{
+   return mp_add(&ctx->a, &ctx->b, &ctx->c);
+}
+
+static mp_err run_sub(bench_ctx *ctx)
+{
+   return mp_sub(&ctx->a, &ctx->b, &ctx->c);
+}
+
+static mp_err run_mul(bench_ctx *ctx)
+{
+   return mp_mul(&ctx->a, &ctx->b, &ctx->c);
+}
+
+static mp_err run_sqr(bench_ctx *ctx)
+{
+   return mp_sqr(&ctx->a, &ctx->c);
+}
+
+static mp_err run_div(bench_ctx *ctx)
+{
+   return mp_div(&ctx->a, &ctx->b, &ctx->c, &ctx->r);
+}
+
+static mp_err run_mod(bench_ctx *ctx)
+{
+   return mp_mod(&ctx->a, &ctx->b, &ctx->c);
+}
+
+static mp_err run_div_d(bench_ctx *ctx)
+{
+   mp_digit r;
+   return mp_div_d(&ctx->a, (mp_digit)10007u, &ctx->c, &r);
+}
+
+static mp_err run_mul_2d(bench_ctx *ctx)
+{
+   return mp_mul_2d(&ctx->a, (ctx->bits / 3) + 7, &ctx->c);
+}
+
+static mp_err run_div_2d(bench_ctx *ctx)
+{
+   return mp_div_2d(&ctx->a, (ctx->bits / 3) + 7, &ctx->c, NULL);
+}
+
+static mp_err run_gcd(bench_ctx *ctx)
+{
+   return mp_gcd(&ctx->a, &ctx->b, &ctx->c);
+}
+
+static mp_err run_lcm(bench_ctx *ctx)
+{
+   return mp_lcm(&ctx->a, &ctx->b, &ctx->c);
+}
+
+static mp_err run_invmod(bench_ctx *ctx)
+{
+   return mp_invmod(&ctx->a, &ctx->b, &ctx->c);
+}
+
+static mp_err run_exptmod(bench_ctx *ctx)
+{
+   return mp_exptmod(&ctx->a, &ctx->b, &ctx->d, &ctx->c);
+}
+
+static mp_err run_sqrt(bench_ctx *ctx)
+{
+   return mp_sqrt(&ctx->a, &ctx->c);
+}
+
+static mp_err run_root_n(bench_ctx *ctx)
+{
+   return mp_root_n(&ctx->a, 3, &ctx->c);
+}
+
+static mp_err run_is_square(bench_ctx *ctx)
+{
+   bool r;
+   return mp_is_square(&ctx->a, &r);
+}
+
+static mp_err run_expt_n(bench_ctx *ctx)
+{
+   return mp_expt_n(&ctx->a, 16, &ctx->c);
+}
+
+static mp_err run_log_n(bench_ctx *ctx)
+{
+   int r;
+   return mp_log_n(&ctx->a, 10, &r);
+}
+
+static mp_err run_kronecker(bench_ctx *ctx)
+{
+   int r;
+   return mp_kronecker(&ctx->a, &ctx->b, &r);
+}
+
+static mp_err run_is_prime(bench_ctx *ctx)
+{
+   bool r;
+   return mp_prime_is_prime(&ctx->a, mp_prime_rabin_miller_trials(ctx->bits), &r);
+}
+
+/* includes the copy of the start value */
+static mp_err run_next_prime(bench_ctx *ctx)
+{
+   mp_err err;
+   if ((err = mp_copy(&ctx->b, &ctx->a)) != MP_OKAY) {
+      return err;
+   }
+   return mp_prime_next_prime(&ctx->a, mp_prime_rabin_miller_trials(ctx->bits), false);
+}
+
+static mp_err run_sqrtmod(bench_ctx *ctx)
+{
+   return mp_sqrtmod_prime(&ctx->a, &ctx->d, &ctx->c);
+}
+
+static mp_err run_to_dec(bench_ctx *ctx)
+{
+   return mp_to_radix(&ctx->a, ctx->str, ctx->size, NULL, 10);
+}
+
+static mp_err run_to_hex(bench_ctx *ctx)
+{
+   return mp_to_radix(&ctx->a, ctx->str, ctx->size, NULL, 16);
+}
+
+static mp_err run_read_dec(bench_ctx *ctx)
+{
+   return mp_read_radix(&ctx->c, ctx->str, 10);
+}
+
+static mp_err run_read_hex(bench_ctx *ctx)
+{
+   return mp_read_radix(&ctx->c, ctx->str, 16);
+}
+
+static mp_err run_to_ubin(bench_ctx *ctx)
+{
+   return mp_to_ubin(&ctx->a, ctx->buf, ctx->size, NULL);
+}
+
+static mp_err run_from_ubin(bench_ctx *ctx)
+{
+   return mp_from_ubin(&ctx->c, ctx->buf, mp_ubin_size(&ctx->a));
+}
+
+static mp_err run_pack(bench_ctx *ctx)
+{
+   return mp_pack(ctx->buf, ctx->size / 8u, NULL, MP_LSB_FIRST, 8u, MP_NATIVE_ENDIAN, 0u, &ctx->a);
+}
+
+static mp_err run_unpack(bench_ctx *ctx)
+{
+   return mp_unpack(&ctx->c, mp_pack_count(&ctx->a, 0u, 8u), MP_LSB_FIRST, 8u, MP_NATIVE_ENDIAN, 0u, ctx->buf);
+}
+
+static const bench_op s_ops[] = {
+   { "add",        NULL,     16384, setup_ab,         run_add,         BENCH_MPI_ADD },
+   { "sub",        NULL,     16384, setup_ab,         run_sub,         BENCH_MPI_SUB },
+   { "mul",        "mult",   16384, setup_ab,         run_mul,         BENCH_MPI_MUL },
+   { "sqr",        NULL,     16384, setup_ab,         run_sqr,         BENCH_MPI_SQR },
+   { "div",        NULL,      8192, setup_div,        run_div,         BENCH_MPI_DIV },
+   { "mod",        NULL,      8192, setup_div,        run_mod,         BENCH_MPI_MOD },
+   { "div_d",      NULL,     16384, setup_ab,         run_div_d,       BENCH_MPI_DIV_D },
+   { "mul_2d",     NULL,     16384, setup_ab,         run_mul_2d,      BENCH_MPI_MUL_2D },
+   { "div_2d",     NULL,     16384, setup_ab,         run_div_2d,      BENCH_MPI_DIV_2D },
+   { "gcd",        NULL,      4096, setup_ab,         run_gcd,         BENCH_MPI_GCD },
+   { "lcm",        NULL,      4096, setup_ab,         run_lcm,         BENCH_MPI_LCM },
+   { "invmod",     NULL,      4096, setup_invmod,     run_invmod,      BENCH_MPI_INVMOD },
+   { "exptmod",    "expt",    2048, setup_exptmod,    run_exptmod,     BENCH_MPI_EXPTMOD },
+   { "sqrt",       NULL,      8192, setup_a2,         run_sqrt,        BENCH_MPI_SQRT },
+   { "root_n",     NULL,      4096, setup_a2,         run_root_n,      BENCH_MPI_NONE },
+   { "is_square",  NULL,      8192, setup_a2,         run_is_square,   BENCH_MPI_NONE },
+   { "expt_n",     NULL,     16384, setup_expt,       run_expt_n,      BENCH_MPI_NONE },
+   { "log_n",      NULL,      8192, setup_ab,         run_log_n,       BENCH_MPI_NONE },
+   { "kronecker",  NULL,      4096, setup_kronecker,  run_kronecker,   BENCH_MPI_NONE },
+   { "is_prime",   NULL,      1024, setup_prime,      run_is_prime,    BENCH_MPI_NONE },
+   { "next_prime", NULL,      1024, setup_next_prime, run_next_prime,  BENCH_MPI_NONE },
+   { "sqrtmod",    NULL,      1024, setup_sqrtmod,    run_sqrtmod,     BENCH_MPI_NONE },
+   { "to_dec",     NULL,      8192, setup_to_radix,   run_to_dec,      BENCH_MPI_TO_DEC },
+   { "to_hex",     NULL,     16384, setup_to_radix,   run_to_hex,      BENCH_MPI_TO_HEX },
+   { "read_dec",   NULL,      8192, setup_read_dec,   run_read_dec,    BENCH_MPI_READ_DEC },
+   { "read_hex",   NULL,     16384, setup_read_hex,   run_read_hex,    BENCH_MPI_READ_HEX },
+   { "to_ubin",    NULL,     16384, setup_to_radix,   run_to_ubin,     BENCH_MPI_TO_UBIN },
+   { "from_ubin",  NULL,     16384, setup_from_ubin,  run_from_ubin,   BENCH_MPI_FROM_UBIN },
+   { "pack",       NULL,     16384, setup_to_radix,   run_pack,        BENCH_MPI_NONE },
+   { "unpack",     NULL,     16384, setup_unpack,     run_unpack,      BENCH_MPI_NONE }
+};
+
+#define BENCH_OPS (int)(sizeof(s_ops) / sizeof(s_ops[0]))
+
+/* ---> Measurement <--- */
+
+static double s_now_ns(void)
+{
+#if defined(CLOCK_MONOTONIC)
+   struct timespec ts;
+   if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+      return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+   }
+#endif
+   {
+      clock_t c = clock();
+      return ((double)c * 1e9) / (double)CLOCKS_PER_SEC;
+   }
+}
+
+/* the operation in MPI, with the operands of ctx->mpi */
+static mp_err s_run_ref(bench_ctx *ctx)
+{
+   return (bench_mpi_run(ctx->mpi, ctx->op->ref, ctx->bits) == 0) ? MP_OKAY : MP_ERR;
+}
+
+/* the time of "iters" calls in ns */
+static double s_time(mp_err(*run)(bench_ctx *ctx), bench_ctx *ctx, unsigned long iters)
+{
+   unsigned long i;
+   double t = s_now_ns();
+   for (i = 0; i < iters; ++i) {
+      CHECK_OK(run(ctx));
+   }
+   return s_now_ns() - t;
+}
+
+static int s_cmp_double(const void *a, const void *b)
+{
+   double x = *(const double *)a, y = *(const double *)b;
+   return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+/* the value at the 1-based rank "r" of the sorted samples, rounded down */
+static double s_rank(const double *t, int n, double r)
+{
+   int k = (int)r;
+   return t[(k < 1) ? 0 : ((k > n) ? (n - 1) : (k - 1))];
+}
+
+/* "perf" counts the measured samples if not NULL */
+static void s_measure(mp_err(*run)(bench_ctx *ctx), bench_ctx *ctx, const bench_opts *opts, perf_counters *perf,
+                      bench_stats *st)
+{
+   static double t[BENCH_MAX_REPS];
+   unsigned long iters = 1;
+   double sum = 0.0, sq = 0.0, h, calls, digits;
+   int i, n = opts->reps;
+
+   /* calls per sample such that a sample takes at least min_ns */
+   while ((s_time(run, ctx, iters) < opts->min_ns) && (iters < (1uL << 30))) {
+      iters *= 2u;
+   }
+   for (i = 0; i < opts->warmup; ++i) {
+      (void)s_time(run, ctx, iters);
+   }
+   if (perf != NULL) {
+      perf_counters_start(perf);
+   }
+   for (i = 0; i < n; ++i) {
+      t[i] = s_time(run, ctx, iters) / (double)iters;
+      sum += t[i];
+   }
+   for (i = 0; i < BENCH_PERF; ++i) {
+      st->perf[i] = -1.0;
+   }
+   if (perf != NULL) {
+      perf_counters_stop(perf);
+      calls = (double)n * (double)iters;
+      digits = (double)((ctx->bits + MP_DIGIT_BIT - 1) / MP_DIGIT_BIT);
+      st->perf[0] = perf_counters_ipc(perf);
+      st->perf[1] = perf_counters_per(perf, PERF_BRANCH_MISSES, calls);
+      st->perf[2] = perf_counters_per(perf, PERF_L1D_MISSES, calls * digits);
+      st->perf[3] = perf_counters_per(perf, PERF_LLC_MISSES, calls * digits);
+   }
+   qsort(t, (size_t)n, sizeof(t[0]), s_cmp_double);
+
+   st->iters = iters;
+   st->reps = n;
+   st->mean = sum / (double)n;
+   for (i = 0; i < n; ++i) {
+      sq += (t[i] - st->mean) * (t[i] - st->mean);
+   }
+   st->stddev = (n > 1) ? sqrt(sq / (double)(n - 1)) : 0.0;
+   st->median = ((n & 1) == 1) ? t[n / 2] : ((t[(n / 2) - 1] + t[n / 2]) / 2.0);
+   st->p99 = s_rank(t, n, ceil(0.99 * (double)n));
+
+   /* the ranks around the median which cover it with 95% probability,
+    * from the normal approximation of the binomial distribution
+    */
+   h = 1.96 * sqrt((double)n) / 2.0;
+   st->ci_low = s_rank(t, n, ((double)n / 2.0) - h);
+   st->ci_high = s_rank(t, n, ceil(((double)n / 2.0) + h) + 1.0);
+}
+
+/* ---> Output <--- */
+
+static const char *const s_perf_names[BENCH_PERF][2] = {
+   { "IPC", "ipc" },
+   { "br/call", "branch_misses_per_call" },
+   { "L1D/digit", "l1d_misses_per_digit" },
+   { "LLC/digit", "llc_misses_per_digit" }
+};
+
+/* the counters of st, or their names if st is NULL, at the end of a line of text or CSV */
+static void s_print_perf(const bench_opts *opts, const bench_stats *st)
+{
+   int i;
+   if (opts->perf == NULL) {
+      return;
+   }
+   for (i = 0; i < BENCH_PERF; ++i) {
+      if (opts->format == BENCH_TEXT) {
+         if ((st == NULL) || (st->perf[i] < 0.0)) {
+            fprintf(opts->out, " %10s", (st == NULL) ? s_perf_names[i][0] : "-");
+         } else {
+            fprintf(opts->out, " %10.4f", st->perf[i]);
+         }
+      } else if (opts->format == BENCH_CSV) {
+         if (st == NULL) {
+            fprintf(opts->out, ",%s", s_perf_names[i][1]);
+         } else if (st->perf[i] < 0.0) {
+            fprintf(opts->out, ",");
+         } else {
+            fprintf(opts->out, ",%.4f", st->perf[i]);
+         }
+      } else if (opts->format == BENCH_JSON) {
+         if (st->perf[i] < 0.0) {
+            fprintf(opts->out, ", \"%s\": null", s_perf_names[i][1]);
+         } else {
+            fprintf(opts->out, ", \"%s\": %.4f", s_perf_names[i][1], st->perf[i]);
+         }
+      }
+   }
+}
+
+static void s_begin(const bench_opts *opts)
+{
+   if (opts->diff != 0) {
+      switch (opts->format) {
+      case BENCH_TEXT:
+         fprintf(opts->out, "%-12s %7s %14s %14s %14s %14s %9s", "op", "bits", "median ns",
+                 "ci low ns", "mpi ns", "mpi ci high ns", "speedup");
+         s_print_perf(opts, NULL);
+         fprintf(opts->out, "\n");
+         return;
+      case BENCH_CSV:
+         fprintf(opts->out, "op,bits,digit_bit,reps,median_ns,ci_low_ns,ci_high_ns,"
+                 "ref_median_ns,ref_ci_low_ns,ref_ci_high_ns,speedup,slower");
+         s_print_perf(opts, NULL);
+         fprintf(opts->out, "\n");
+         return;
+      default:
+         break;
+      }
+   }
+   switch (opts->format) {
+   case BENCH_TEXT:
+      fprintf(opts->out, "%-12s %7s %14s %14s %14s %14s %12s", "op", "bits", "median ns",
+              "p99 ns", "ci low ns", "ci high ns", "ops/sec");
+      s_print_perf(opts, NULL);
+      fprintf(opts->out, "\n");
+      break;
+   case BENCH_CSV:
+      fprintf(opts->out, "op,bits,digit_bit,reps,iters,median_ns,p99_ns,mean_ns,stddev_ns,ci_low_ns,ci_high_ns");
+      s_print_perf(opts, NULL);
+      fprintf(opts->out, "\n");
+      break;
+   case BENCH_JSON:
+      fprintf(opts->out, "{\n  \"digit_bit\": %d,\n  \"seed\": %lu,\n  \"reps\": %d,\n  \"warmup\": %d,\n"
+              "  \"cpu\": %d,\n  \"reference\": \"%s\",\n  \"results\": [", MP_DIGIT_BIT, opts->seed, opts->reps,
+              opts->warmup, opts->cpu, (opts->diff != 0) ? "mpi" : "none");
+      break;
+   case BENCH_LOG:
+      break;
+   }
+}
+
+/* "ref" are the timings of MPI with -d, otherwise NULL. "lf" and "rf" are
+ * the log files of ours and of MPI.
+ */
+static void s_print(const bench_opts *opts, FILE *lf, FILE *rf, const bench_op *op, int bits,
+                    const bench_stats *st, const bench_stats *ref)
+{
+   static int first = 1;
+
+   if (ref != NULL) {
+      double speedup = ref->median / st->median;
+      int slower = (st->ci_low > ref->ci_high) ? 1 : 0;
+      switch (opts->format) {
+      case BENCH_TEXT:
+         fprintf(opts->out, "%-12s %7d %14.1f %14.1f %14.1f %14.1f %8.2fx", op->name, bits, st->median,
+                 st->ci_low, ref->median, ref->ci_high, speedup);
+         s_print_perf(opts, st);
+         fprintf(opts->out, "%s\n", (slower != 0) ? " SLOWER" : "");
+         return;
+      case BENCH_CSV:
+         fprintf(opts->out, "%s,%d,%d,%d,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.3f,%d", op->name, bits, MP_DIGIT_BIT,
+                 st->reps, st->median, st->ci_low, st->ci_high, ref->median, ref->ci_low, ref->ci_high,
+                 speedup, slower);
+         s_print_perf(opts, st);
+         fprintf(opts->out, "\n");
+         return;
+      case BENCH_JSON:
+         fprintf(opts->out, "%s\n    { \"op\": \"%s\", \"bits\": %d, \"median_ns\": %.1f, \"ci_low_ns\": %.1f, "
+                 "\"ci_high_ns\": %.1f, \"ref_median_ns\": %.1f, \"ref_ci_low_ns\": %.1f, "
+                 "\"ref_ci_high_ns\": %.1f, \"speedup\": %.3f, \"slower\": %s", first ? "" : ",",
+                 op->name, bits, st->median, st->ci_low, st->ci_high, ref->median, ref->ci_low,
+                 ref->ci_high, speedup, (slower != 0) ? "true" : "false");
+         s_print_perf(opts, st);
+         fprintf(opts->out, " }");
+         first = 0;
+         return;
+      case BENCH_LOG:
+         fprintf(rf, "%6d %12.1f\n", bits, ref->median);
+         fflush(rf);
+         break;
+      }
+   }
+
+   switch (opts->format) {
+   case BENCH_TEXT:
+      fprintf(opts->out, "%-12s %7d %14.1f %14.1f %14.1f %14.1f %12.0f", op->name, bits, st->median,
+              st->p99, st->ci_low, st->ci_high, 1e9 / st->median);
+      s_print_perf(opts, st);
+      fprintf(opts->out, "\n");
+      break;
+   case BENCH_CSV:
+      fprintf(opts->out, "%s,%d,%d,%d,%lu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f", op->name, bits, MP_DIGIT_BIT,
+              st->reps, st->iters, st->median, st->p99, st->mean, st->stddev, st->ci_low, st->ci_high);
+      s_print_perf(opts, st);
+      fprintf(opts->out, "\n");
+      break;
+   case BENCH_JSON:
+      fprintf(opts->out, "%s\n    { \"op\": \"%s\", \"bits\": %d, \"iters\": %lu, \"median_ns\": %.1f, "
+              "\"p99_ns\": %.1f, \"mean_ns\": %.1f, \"stddev_ns\": %.1f, \"ci_low_ns\": %.1f, "
+              "\"ci_high_ns\": %.1f", first ? "" : ",", op->name, bits, st->iters, st->median,
+              st->p99, st->mean, st->stddev, st->ci_low, st->ci_high);
+      s_print_perf(opts, st);
+      fprintf(opts->out, " }");
+      first = 0;
+      break;
+   case BENCH_LOG:
+      /* the two columns of the gnuplot scripts */
+      fprintf(lf, "%6d %12.1f\n", bits, st->median);
+      fflush(lf);
+      printf("\r%-12s %7d bits => %12.1f ns", op->name, bits, st->median);
+      fflush(stdout);
+      break;
+   }
+}
+
+static void s_end(const bench_opts *opts)
+{
+   if (opts->format == BENCH_JSON) {
+      fprintf(opts->out, "\n  ]\n}\n");
+   }
+}
+
+/* ---> Driver <--- */
+
+/* passes operand "i" of ours to MPI */
+static void s_export(bench_ctx *ctx, int i, const mp_int *x)
+{
+   size_t size = mp_ubin_size(x), n = 0;
+   unsigned char *buf = (unsigned char *)malloc(size + 1u);
+   if ((buf == NULL) || mp_isneg(x)) {
+      fprintf(stderr, "can't pass the operands of %s to MPI\n", ctx->op->name);
+      exit(EXIT_FAILURE);
+   }
+   CHECK_OK(mp_to_ubin(x, buf, size, &n));
+   if (bench_mpi_set(ctx->mpi, i, buf, n) != 0) {
+      fprintf(stderr, "MPI can't read the operands of %s\n", ctx->op->name);
+      exit(EXIT_FAILURE);
+   }
+   free(buf);
+}
+
+/* compares the results in c, the output of the conversions to a string or
+ * bytes is not in c and not compared
+ */
+static void s_verify(bench_ctx *ctx)
+{
+   size_t size = mp_ubin_size(&ctx->c), n = 0;
+   unsigned char *x, *y;
+   int neg = 0, k;
+   mp_err err;
+
+   if ((ctx->op->ref == BENCH_MPI_TO_DEC) || (ctx->op->ref == BENCH_MPI_TO_HEX) ||
+       (ctx->op->ref == BENCH_MPI_TO_UBIN)) {
+      return;
+   }
+   x = (unsigned char *)malloc(size + 1u);
+   y = (unsigned char *)malloc(size + 1u);
+   if ((x == NULL) || (y == NULL)) {
+      fprintf(stderr, "out of memory\n");
+      exit(EXIT_FAILURE);
+   }
+   err = mp_to_ubin(&ctx->c, x, size, &n);
+   k = bench_mpi_result(ctx->mpi, y, size + 1u, &neg);
+   if ((err != MP_OKAY) || (k < 0) || ((size_t)k != n) || (memcmp(x, y, n) != 0) ||
+       (neg != (mp_isneg(&ctx->c) ? 1 : 0))) {
+      fprintf(stderr, "%s of %d bits: the result differs from MPI\n", ctx->op->name, ctx->bits);
+      exit(EXIT_FAILURE);
+   }
+   free(x);
+   free(y);
+}
+
+static FILE *s_open_log(const char *name, const char *suffix)
+{
+   char path[256];
+   FILE *f;
+   sprintf(path, "logs/%.64s%s" MP_BENCH_VERSION ".log", name, suffix);
+   if ((f = fopen(path, "w")) == NULL) {
+      fprintf(stderr, "can't open %s\n", path);
+      exit(EXIT_FAILURE);
+   }
+   return f;
+}
+
+/* returns the number of sizes at which ours is slower than MPI */
+static int s_bench(const bench_op *op, const bench_opts *opts)
+{
+   int sizes[BENCH_MAX_SIZES], n = 0, i, slower = 0;
+   bench_ctx ctx;
+   bench_stats st, ref;
+   FILE *lf = NULL, *rf = NULL;
+
+   if (opts->nsizes > 0) {
+      for (i = 0; i < opts->nsizes; ++i) {
+         sizes[n++] = opts->sizes[i];
+      }
+   } else {
+      int hi = (opts->hi > 0) ? opts->hi : op->max_bits;
+      for (i = opts->lo; (i <= hi) && (n < BENCH_MAX_SIZES); i = (opts->step > 0) ? (i + opts->step) : (2 * i)) {
+         sizes[n++] = i;
+      }
+   }
+
+   if (opts->format == BENCH_LOG) {
+      lf = s_open_log((op->log != NULL) ? op->log : op->name, "");
+      if (opts->diff != 0) {
+         rf = s_open_log((op->log != NULL) ? op->log : op->name, "-mpi");
+      }
+   }
+
+   CHECK_OK(mp_init_multi(&ctx.a, &ctx.b, &ctx.c, &ctx.d, &ctx.m, &ctx.r, NULL));
+   ctx.buf = NULL;
+   ctx.str = NULL;
+   ctx.size = 0;
+   ctx.op = op;
+   ctx.mpi = NULL;
+   if ((opts->diff != 0) && ((ctx.mpi = bench_mpi_new()) == NULL)) {
+      fprintf(stderr, "out of memory\n");
+      exit(EXIT_FAILURE);
+   }
+   for (i = 0; i < n; ++i) {
+      /* the same inputs for the same seed and size, whatever ran before */
+      mp_rng_init(&ctx.rng, (uint64_t)opts->seed, (uint64_t)sizes[i]);
+      ctx.bits = sizes[i];
+      CHECK_OK(op->setup(&ctx));
+      s_measure(op->run, &ctx, opts, opts->perf, &st);
+      if (ctx.mpi == NULL) {
+         s_print(opts, lf, rf, op, sizes[i], &st, NULL);
+         continue;
+      }
+      s_export(&ctx, 0, &ctx.a);
+      s_export(&ctx, 1, &ctx.b);
+      s_export(&ctx, 2, &ctx.d);
+      if (bench_mpi_setup(ctx.mpi, op->ref, ctx.bits) != 0) {
+         fprintf(stderr, "MPI can't set up %s\n", op->name);
+         exit(EXIT_FAILURE);
+      }
+      s_measure(s_run_ref, &ctx, opts, NULL, &ref);
+      s_verify(&ctx);
+      s_print(opts, lf, rf, op, sizes[i], &st, &ref);
+      if (st.ci_low > ref.ci_high) {
+         ++slower;
+      }
+   }
+   mp_clear_multi(&ctx.a, &ctx.b, &ctx.c, &ctx.d, &ctx.m, &ctx.r, NULL);
+   free(ctx.buf);
+   bench_mpi_free(ctx.mpi);
+
+   if (lf != NULL) {
+      fclose(lf);
+      printf("\n");
+   }
+   if (rf != NULL) {
+      fclose(rf);
+   }
+   return slower;
+}
+
+static void s_pin(int cpu)
+{
+#ifdef __linux__
+   cpu_set_t set;
+   CPU_ZERO(&set);
+   CPU_SET(cpu, &set);
+   if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+      fprintf(stderr, "can't pin to cpu %d, continuing unpinned\n", cpu);
+   }
+#else
+   fprintf(stderr, "pinning to cpu %d is not supported here, continuing unpinned\n", cpu);
+#endif
+}
+
+static void s_usage(const char *name)
+{
+   printf("usage: %s [options] [operation...]\n\n"
+          "  -f text|csv|json|log  output format, log writes logs/<op>.log for gnuplot\n"
+          "  -o file               write to file instead of stdout\n"
+          "  -b lo:hi[:step]       sweep of operand sizes in bits, doubling without step\n"
+          "  -b n,n,...            list of operand sizes in bits\n"
+          "  -r reps               measured samples per size (default 31)\n"
+          "  -w warmup             discarded samples per size (default 3)\n"
+          "  -t ns                 minimum time of a sample (default 100000)\n"
+          "  -c cpu                pin to the cpu\n"
+          "  -s seed               seed of the inputs (default 23)\n"
+          "  -d                    compare with MPI of mtest/, only the operations it has\n"
+          "  -p                    read the hardware counters, IPC and misses per call or digit\n"
+          "  -l                    list the operations\n\n"
+          "An operation is run if its name contains one of the arguments.\n", name);
+}
+
+static void s_parse_sizes(bench_opts *opts, const char *arg)
+{
+   if (strchr(arg, ':') != NULL) {
+      opts->step = 0;
+      opts->hi = 0;
+      if (sscanf(arg, "%d:%d:%d", &opts->lo, &opts->hi, &opts->step) < 2) {
+         fprintf(stderr, "bad sweep %s\n", arg);
+         exit(EXIT_FAILURE);
+      }
+   } else {
+      const char *p = arg;
+      opts->nsizes = 0;
+      while ((*p != '\0') && (opts->nsizes < BENCH_MAX_SIZES)) {
+         opts->sizes[opts->nsizes++] = atoi(p);
+         if ((p = strchr(p, ',')) == NULL) {
+            break;
+         }
+         ++p;
+      }
+   }
+   if ((opts->lo < 8) || ((opts->nsizes == 0) && (opts->hi != 0) && (opts->hi < opts->lo))) {
+      fprintf(stderr, "bad sizes %s\n", arg);
+      exit(EXIT_FAILURE);
+   }
+}
+
+static int s_selected(const char *name, int argc, char **argv, int first)
+{
+   int j;
+   if (first >= argc) {
+      return 1;
+   }
+   for (j = first; j < argc; ++j) {
+      if (strstr(name, argv[j]) != NULL) {
+         return 1;
+      }
+   }
+   return 0;
+}
+
+int main(int argc, char **argv)
+{
+   bench_opts opts;
+   perf_counters perf;
+   int i, j, slower = 0;
+
+   opts.format = BENCH_TEXT;
+   opts.out = stdout;
+   opts.nsizes = 0;
+   opts.lo = 64;
+   opts.hi = 0;
+   opts.step = 0;
+   opts.reps = 31;
+   opts.warmup = 3;
+   opts.cpu = -1;
+   opts.min_ns = 100000.0;
+   opts.seed = 23uL;
+   opts.diff = 0;
+   opts.perf = NULL;
+
+   for (i = 1; (i < argc) && (argv[i][0] == '-'); ++i) {
+      char o = argv[i][1];
+      const char *arg;
+      if (o == 'l') {
+         for (j = 0; j < BENCH_OPS; ++j) {
+            printf("%-12s up to %5d bits\n", s_ops[j].name, s_ops[j].max_bits);
+         }
+         return EXIT_SUCCESS;
+      }
+      if (o == 'd') {
+         opts.diff = 1;
+         continue;
+      }
+      if (o == 'p') {
+         if (perf_counters_open(&perf) != 0) {
+            opts.perf = &perf;
+         } else {
+            fprintf(stderr, "hardware counters are not available, timing only\n");
+         }
+         continue;
+      }
+      if ((o == 'h') || ((i + 1) >= argc)) {
+         s_usage(argv[0]);
+         return (o == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+      }
+      arg = argv[++i];
+      switch (o) {
+      case 'f':
+         if (strcmp(arg, "text") == 0) {
+            opts.format = BENCH_TEXT;
+         } else if (strcmp(arg, "csv") == 0) {
+            opts.format = BENCH_CSV;
+         } else if (strcmp(arg, "json") == 0) {
+            opts.format = BENCH_JSON;
+         } else if (strcmp(arg, "log") == 0) {
+            opts.format = BENCH_LOG;
+         } else {
+            s_usage(argv[0]);
+            return EXIT_FAILURE;
+         }
+         break;
+      case 'o':
+         if ((opts.out = fopen(arg, "w")) == NULL) {
+            fprintf(stderr, "can't open %s\n", arg);
+            return EXIT_FAILURE;
+         }
+         break;
+      case 'b':
+         s_parse_sizes(&opts, arg);
+         break;
+      case 'r':
+         opts.reps = atoi(arg);
+         break;
+      case 'w':
+         opts.warmup = atoi(arg);
+         break;
+      case 't':
+         opts.min_ns = atof(arg);
+         break;
+      case 'c':
+         opts.cpu = atoi(arg);
+         break;
+      case 's':
+         opts.seed = strtoul(arg, NULL, 0);
+         break;
+      default:
+         s_usage(argv[0]);
+         return EXIT_FAILURE;
+      }
+   }
+   if ((opts.reps < 1) || (opts.reps > BENCH_MAX_REPS) || (opts.warmup < 0)) {
+      fprintf(stderr, "reps must be in 1..%d\n", BENCH_MAX_REPS);
+      return EXIT_FAILURE;
+   }
+   if (opts.cpu >= 0) {
+      s_pin(opts.cpu);
+   }
+
+   s_begin(&opts);
+   for (j = 0; j < BENCH_OPS; ++j) {
+      if ((opts.diff != 0) && (s_ops[j].ref == BENCH_MPI_NONE)) {
+         continue;
+      }
+      if (s_selected(s_ops[j].name, argc, argv, i) != 0) {
+         slower += s_bench(&s_ops[j], &opts);
+      }
+   }
+   s_end(&opts);
+
+   if (opts.out != stdout) {
+      fclose(opts.out);
+   }
+   if (opts.perf != NULL) {
+      perf_counters_close(opts.perf);
+   }
+   if (slower != 0) {
+      fprintf(stderr, "%d measurements slower than MPI\n", slower);
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+}
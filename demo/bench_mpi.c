@@ -0,0 +1,270 @@
+/* The MPI library in mtest/, renamed such that it can be linked with ours.
+ * See bench_mpi.h.
+ */
+#include "bench_mpi.h"
+
+/* the separate squaring of MPI is wrong for large operands, mtest filters
+ * its results as well, hence squares are multiplications here
+ */
+#define MP_SQUARE 0
+
+#define mp_2expt             bench_mpi_mp_2expt
+#define mp_abs               bench_mpi_mp_abs
+#define mp_add               bench_mpi_mp_add
+#define mp_add_d             bench_mpi_mp_add_d
+#define mp_addmod            bench_mpi_mp_addmod
+#define mp_char2value        bench_mpi_mp_char2value
+#define mp_clear             bench_mpi_mp_clear
+#define mp_clear_array       bench_mpi_mp_clear_array
+#define mp_cmp               bench_mpi_mp_cmp
+#define mp_cmp_d             bench_mpi_mp_cmp_d
+#define mp_cmp_int           bench_mpi_mp_cmp_int
+#define mp_cmp_mag           bench_mpi_mp_cmp_mag
+#define mp_cmp_z             bench_mpi_mp_cmp_z
+#define mp_copy              bench_mpi_mp_copy
+#define mp_count_bits        bench_mpi_mp_count_bits
+#define mp_div               bench_mpi_mp_div
+#define mp_div_2             bench_mpi_mp_div_2
+#define mp_div_2d            bench_mpi_mp_div_2d
+#define mp_div_d             bench_mpi_mp_div_d
+#define mp_exch              bench_mpi_mp_exch
+#define mp_expt              bench_mpi_mp_expt
+#define mp_expt_d            bench_mpi_mp_expt_d
+#define mp_exptmod           bench_mpi_mp_exptmod
+#define mp_exptmod_d         bench_mpi_mp_exptmod_d
+#define mp_gcd               bench_mpi_mp_gcd
+#define mp_get_prec          bench_mpi_mp_get_prec
+#define mp_init              bench_mpi_mp_init
+#define mp_init_array        bench_mpi_mp_init_array
+#define mp_init_copy         bench_mpi_mp_init_copy
+#define mp_init_size         bench_mpi_mp_init_size
+#define mp_invmod            bench_mpi_mp_invmod
+#define mp_iseven            bench_mpi_mp_iseven
+#define mp_isodd             bench_mpi_mp_isodd
+#define mp_lcm               bench_mpi_mp_lcm
+#define mp_mod               bench_mpi_mp_mod
+#define mp_mod_d             bench_mpi_mp_mod_d
+#define mp_mul               bench_mpi_mp_mul
+#define mp_mul_2             bench_mpi_mp_mul_2
+#define mp_mul_2d            bench_mpi_mp_mul_2d
+#define mp_mul_d             bench_mpi_mp_mul_d
+#define mp_mulmod            bench_mpi_mp_mulmod
+#define mp_neg               bench_mpi_mp_neg
+#define mp_radix_size        bench_mpi_mp_radix_size
+#define mp_read_radix        bench_mpi_mp_read_radix
+#define mp_read_signed_bin   bench_mpi_mp_read_signed_bin
+#define mp_read_unsigned_bin bench_mpi_mp_read_unsigned_bin
+#define mp_set               bench_mpi_mp_set
+#define mp_set_int           bench_mpi_mp_set_int
+#define mp_set_prec          bench_mpi_mp_set_prec
+#define mp_signed_bin_size   bench_mpi_mp_signed_bin_size
+#define mp_sqrt              bench_mpi_mp_sqrt
+#define mp_strerror          bench_mpi_mp_strerror
+#define mp_sub               bench_mpi_mp_sub
+#define mp_sub_d             bench_mpi_mp_sub_d
+#define mp_submod            bench_mpi_mp_submod
+#define mp_to_signed_bin     bench_mpi_mp_to_signed_bin
+#define mp_to_unsigned_bin   bench_mpi_mp_to_unsigned_bin
+#define mp_toradix           bench_mpi_mp_toradix
+#define mp_unsigned_bin_size bench_mpi_mp_unsigned_bin_size
+#define mp_value_radix_size  bench_mpi_mp_value_radix_size
+#define mp_xgcd              bench_mpi_mp_xgcd
+#define mp_zero              bench_mpi_mp_zero
+#define s_logv_2             bench_mpi_s_logv_2
+#define s_mp_2expt           bench_mpi_s_mp_2expt
+#define s_mp_add             bench_mpi_s_mp_add
+#define s_mp_add_d           bench_mpi_s_mp_add_d
+#define s_mp_clamp           bench_mpi_s_mp_clamp
+#define s_mp_cmp             bench_mpi_s_mp_cmp
+#define s_mp_cmp_d           bench_mpi_s_mp_cmp_d
+#define s_mp_div             bench_mpi_s_mp_div
+#define s_mp_div_2           bench_mpi_s_mp_div_2
+#define s_mp_div_2d          bench_mpi_s_mp_div_2d
+#define s_mp_div_d           bench_mpi_s_mp_div_d
+#define s_mp_exch            bench_mpi_s_mp_exch
+#define s_mp_grow            bench_mpi_s_mp_grow
+#define s_mp_ispow2          bench_mpi_s_mp_ispow2
+#define s_mp_ispow2d         bench_mpi_s_mp_ispow2d
+#define s_mp_lshd            bench_mpi_s_mp_lshd
+#define s_mp_mod_2d          bench_mpi_s_mp_mod_2d
+#define s_mp_mul             bench_mpi_s_mp_mul
+#define s_mp_mul_2           bench_mpi_s_mp_mul_2
+#define s_mp_mul_2d          bench_mpi_s_mp_mul_2d
+#define s_mp_mul_d           bench_mpi_s_mp_mul_d
+#define s_mp_norm            bench_mpi_s_mp_norm
+#define s_mp_outlen          bench_mpi_s_mp_outlen
+#define s_mp_pad             bench_mpi_s_mp_pad
+#define s_mp_reduce          bench_mpi_s_mp_reduce
+#define s_mp_rshd            bench_mpi_s_mp_rshd
+#define s_mp_sub             bench_mpi_s_mp_sub
+#define s_mp_sub_d           bench_mpi_s_mp_sub_d
+#define s_mp_todigit         bench_mpi_s_mp_todigit
+#define s_mp_tovalue         bench_mpi_s_mp_tovalue
+
+#include "../mtest/mpi.c"
+
+struct bench_mpi {
+   mp_int a, b, c, d, r;
+   unsigned char *buf;
+   int size;
+};
+
+bench_mpi *bench_mpi_new(void)
+{
+   bench_mpi *ctx = (bench_mpi *)calloc(1u, sizeof(*ctx));
+   if (ctx == NULL) {
+      return NULL;
+   }
+   if ((mp_init(&ctx->a) != MP_OKAY) || (mp_init(&ctx->b) != MP_OKAY) || (mp_init(&ctx->c) != MP_OKAY) ||
+       (mp_init(&ctx->d) != MP_OKAY) || (mp_init(&ctx->r) != MP_OKAY)) {
+      bench_mpi_free(ctx);
+      return NULL;
+   }
+   return ctx;
+}
+
+void bench_mpi_free(bench_mpi *ctx)
+{
+   if (ctx == NULL) {
+      return;
+   }
+   /* mp_clear of MPI accepts an mp_int which was not initialized if it is zeroed */
+   mp_clear(&ctx->a);
+   mp_clear(&ctx->b);
+   mp_clear(&ctx->c);
+   mp_clear(&ctx->d);
+   mp_clear(&ctx->r);
+   free(ctx->buf);
+   free(ctx);
+}
+
+int bench_mpi_set(bench_mpi *ctx, int i, const unsigned char *buf, size_t size)
+{
+   mp_int *x = (i == 0) ? &ctx->a : ((i == 1) ? &ctx->b : &ctx->d);
+   if (size == 0u) {
+      mp_zero(x);
+      return 0;
+   }
+   return (mp_read_unsigned_bin(x, (unsigned char *)buf, (int)size) == MP_OKAY) ? 0 : -1;
+}
+
+static int s_buf(bench_mpi *ctx, int size)
+{
+   free(ctx->buf);
+   ctx->size = size;
+   ctx->buf = (unsigned char *)malloc((size_t)size);
+   return (ctx->buf == NULL) ? -1 : 0;
+}
+
+int bench_mpi_setup(bench_mpi *ctx, bench_mpi_op op, int bits)
+{
+   (void)bits;
+   switch (op) {
+   case BENCH_MPI_TO_DEC:
+   case BENCH_MPI_READ_DEC:
+      if (s_buf(ctx, mp_radix_size(&ctx->a, 10) + 1) != 0) {
+         return -1;
+      }
+      return (mp_toradix(&ctx->a, (char *)ctx->buf, 10) == MP_OKAY) ? 0 : -1;
+   case BENCH_MPI_TO_HEX:
+   case BENCH_MPI_READ_HEX:
+      if (s_buf(ctx, mp_radix_size(&ctx->a, 16) + 1) != 0) {
+         return -1;
+      }
+      return (mp_toradix(&ctx->a, (char *)ctx->buf, 16) == MP_OKAY) ? 0 : -1;
+   case BENCH_MPI_TO_UBIN:
+   case BENCH_MPI_FROM_UBIN:
+      if (s_buf(ctx, mp_unsigned_bin_size(&ctx->a) + 1) != 0) {
+         return -1;
+      }
+      return (mp_to_unsigned_bin(&ctx->a, ctx->buf) == MP_OKAY) ? 0 : -1;
+   default:
+      return 0;
+   }
+}
+
+int bench_mpi_run(bench_mpi *ctx, bench_mpi_op op, int bits)
+{
+   mp_digit r;
+   mp_err err;
+
+   switch (op) {
+   case BENCH_MPI_ADD:
+      err = mp_add(&ctx->a, &ctx->b, &ctx->c);
+      break;
+   case BENCH_MPI_SUB:
+      err = mp_sub(&ctx->a, &ctx->b, &ctx->c);
+      break;
+   case BENCH_MPI_MUL:
+      err = mp_mul(&ctx->a, &ctx->b, &ctx->c);
+      break;
+   case BENCH_MPI_SQR:
+      err = mp_sqr(&ctx->a, &ctx->c);
+      break;
+   case BENCH_MPI_DIV:
+      err = mp_div(&ctx->a, &ctx->b, &ctx->c, &ctx->r);
+      break;
+   case BENCH_MPI_MOD:
+      err = mp_mod(&ctx->a, &ctx->b, &ctx->c);
+      break;
+   case BENCH_MPI_DIV_D:
+      err = mp_div_d(&ctx->a, (mp_digit)10007u, &ctx->c, &r);
+      break;
+   case BENCH_MPI_MUL_2D:
+      err = mp_mul_2d(&ctx->a, (mp_digit)((bits / 3) + 7), &ctx->c);
+      break;
+   case BENCH_MPI_DIV_2D:
+      err = mp_div_2d(&ctx->a, (mp_digit)((bits / 3) + 7), &ctx->c, NULL);
+      break;
+   case BENCH_MPI_GCD:
+      err = mp_gcd(&ctx->a, &ctx->b, &ctx->c);
+      break;
+   case BENCH_MPI_LCM:
+      err = mp_lcm(&ctx->a, &ctx->b, &ctx->c);
+      break;
+   case BENCH_MPI_INVMOD:
+      err = mp_invmod(&ctx->a, &ctx->b, &ctx->c);
+      break;
+   case BENCH_MPI_EXPTMOD:
+      err = mp_exptmod(&ctx->a, &ctx->b, &ctx->d, &ctx->c);
+      break;
+   case BENCH_MPI_SQRT:
+      err = mp_sqrt(&ctx->a, &ctx->c);
+      break;
+   case BENCH_MPI_TO_DEC:
+      err = mp_toradix(&ctx->a, (char *)ctx->buf, 10);
+      break;
+   case BENCH_MPI_TO_HEX:
+      err = mp_toradix(&ctx->a, (char *)ctx->buf, 16);
+      break;
+   case BENCH_MPI_READ_DEC:
+      err = mp_read_radix(&ctx->c, ctx->buf, 10);
+      break;
+   case BENCH_MPI_READ_HEX:
+      err = mp_read_radix(&ctx->c, ctx->buf, 16);
+      break;
+   case BENCH_MPI_TO_UBIN:
+      err = mp_to_unsigned_bin(&ctx->a, ctx->buf);
+      break;
+   case BENCH_MPI_FROM_UBIN:
+      err = mp_read_unsigned_bin(&ctx->c, ctx->buf, mp_unsigned_bin_size(&ctx->a));
+      break;
+   default:
+      err = MP_BADARG;
+      break;
+   }
+   return (err == MP_OKAY) ? 0 : -1;
+}
+
+int bench_mpi_result(bench_mpi *ctx, unsigned char *buf, size_t size, int *neg)
+{
+   int n = mp_unsigned_bin_size(&ctx->c);
+   if ((size_t)n > size) {
+      return -1;
+   }
+   *neg = (SIGN(&ctx->c) == MP_NEG) ? 1 : 0;
+   if (mp_cmp_z(&ctx->c) == MP_EQ) {
+      return 0;
+   }
+   return (mp_to_unsigned_bin(&ctx->c, buf) == MP_OKAY) ? n : -1;
+}
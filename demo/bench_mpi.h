@@ -0,0 +1,55 @@
+/* The MPI library in mtest/ as the reference of bench -d.
+ *
+ * It has functions and types of the same names as ours, hence it is compiled
+ * on its own in bench_mpi.c and reached only through the functions below.
+ * Operands are passed as big endian magnitudes.
+ */
+#ifndef BENCH_MPI_H_
+#define BENCH_MPI_H_
+
+#include <stddef.h>
+
+typedef enum {
+   BENCH_MPI_NONE = 0,
+   BENCH_MPI_ADD,
+   BENCH_MPI_SUB,
+   BENCH_MPI_MUL,
+   BENCH_MPI_SQR,
+   BENCH_MPI_DIV,
+   BENCH_MPI_MOD,
+   BENCH_MPI_DIV_D,
+   BENCH_MPI_MUL_2D,
+   BENCH_MPI_DIV_2D,
+   BENCH_MPI_GCD,
+   BENCH_MPI_LCM,
+   BENCH_MPI_INVMOD,
+   BENCH_MPI_EXPTMOD,
+   BENCH_MPI_SQRT,
+   BENCH_MPI_TO_DEC,
+   BENCH_MPI_TO_HEX,
+   BENCH_MPI_READ_DEC,
+   BENCH_MPI_READ_HEX,
+   BENCH_MPI_TO_UBIN,
+   BENCH_MPI_FROM_UBIN
+} bench_mpi_op;
+
+typedef struct bench_mpi bench_mpi;
+
+bench_mpi *bench_mpi_new(void);
+void bench_mpi_free(bench_mpi *ctx);
+
+/* operand "i", 0 for a, 1 for b and 2 for the modulus d */
+int bench_mpi_set(bench_mpi *ctx, int i, const unsigned char *buf, size_t size);
+
+/* prepares "op" on the operands for "bits", e.g. the strings to be read */
+int bench_mpi_setup(bench_mpi *ctx, bench_mpi_op op, int bits);
+
+/* returns 0 on success */
+int bench_mpi_run(bench_mpi *ctx, bench_mpi_op op, int bits);
+
+/* the magnitude of the result c into buf, returns its size or -1 if it
+ * does not fit. "neg" is set if it is negative.
+ */
+int bench_mpi_result(bench_mpi *ctx, unsigned char *buf, size_t size, int *neg);
+
+#endif
@@ -6,6 +6,17 @@
 #define LTM_MTEST_RAND_SEED  23
 #endif
 
+/* a deterministic stream, such that a failing run can be repeated */
+static mp_rng s_rng;
+
+
+static unsigned int s_rand(void)
+{
+   uint8_t b[2];
+   mp_rng_bytes(&s_rng, b, sizeof(b));
+   return ((unsigned int)b[1] << 8) | (unsigned int)b[0];
+}
+
 static void draw(const mp_int *a)
 {
    ndraw(a, "");
@@ -24,10 +35,11 @@ static int mtest_opponent(void)
    int ix;
    unsigned rr;
    mp_int a, b, c, d, e, f;
+   mp_cutoffs low;
    unsigned long expt_n, add_n, sub_n, mul_n, div_n, sqr_n, mul2d_n, div2d_n,
             gcd_n, lcm_n, inv_n, div2_n, mul2_n, add_d_n, sub_d_n;
 
-   srand(LTM_MTEST_RAND_SEED);
+   mp_rng_init(&s_rng, (uint64_t)LTM_MTEST_RAND_SEED, 0u);
 
    if (mp_init_multi(&a, &b, &c, &d, &e, &f, NULL)!= MP_OKAY)
       return EXIT_FAILURE;
@@ -35,15 +47,20 @@ static int mtest_opponent(void)
    div2_n = mul2_n = inv_n = expt_n = lcm_n = gcd_n = add_n =
                                          sub_n = mul_n = div_n = sqr_n = mul2d_n = div2d_n = add_d_n = sub_d_n = 0;
 
-#ifndef MP_FIXED_CUTOFFS
    /* force KARA and TOOM to enable despite cutoffs */
-   MP_SQR_KARATSUBA_CUTOFF = MP_MUL_KARATSUBA_CUTOFF = 8;
-   MP_SQR_TOOM_CUTOFF = MP_MUL_TOOM_CUTOFF = 16;
+   mp_cutoffs_get(&low);
+   low.mul_karatsuba = low.sqr_karatsuba = 8;
+   low.mul_toom = low.sqr_toom = 16;
+   if (mp_cutoffs_set_thread(&low) != MP_OKAY) {
+#ifndef MP_FIXED_CUTOFFS
+      MP_SQR_KARATSUBA_CUTOFF = MP_MUL_KARATSUBA_CUTOFF = low.mul_karatsuba;
+      MP_SQR_TOOM_CUTOFF = MP_MUL_TOOM_CUTOFF = low.mul_toom;
 #endif
+   }
 
    for (;;) {
       /* randomly clear and re-init one variable, this has the affect of triming the alloc space */
-      switch (abs(rand()) % 7) {
+      switch (s_rand() % 7u) {
       case 0:
          mp_clear(&a);
          DO(mp_init(&a));
@@ -140,7 +157,7 @@ static int mtest_opponent(void)
 
          rr = (unsigned)mp_sbin_size(&c);
          DO(mp_to_sbin(&c, (uint8_t *) cmd, (size_t)rr, NULL));
-         memset(cmd + rr, rand() & 0xFF, sizeof(cmd) - rr);
+         memset(cmd + rr, (int)(s_rand() & 0xFFu), sizeof(cmd) - rr);
          DO(mp_from_sbin(&d, (uint8_t *) cmd, (size_t)rr));
          if (mp_cmp(&c, &d) != MP_EQ) {
             printf("mp_signed_bin failure!\n");
@@ -151,7 +168,7 @@ static int mtest_opponent(void)
 
          rr = (unsigned)mp_ubin_size(&c);
          DO(mp_to_ubin(&c, (uint8_t *) cmd, (size_t)rr, NULL));
-         memset(cmd + rr, rand() & 0xFF, sizeof(cmd) - rr);
+         memset(cmd + rr, (int)(s_rand() & 0xFFu), sizeof(cmd) - rr);
          DO(mp_from_ubin(&d, (uint8_t *) cmd, (size_t)rr));
          if (mp_cmp_mag(&c, &d) != MP_EQ) {
             printf("mp_unsigned_bin failure!\n");
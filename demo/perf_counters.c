@@ -0,0 +1,178 @@
+/* See perf_counters.h. */
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <string.h>
+
+#include "perf_counters.h"
+
+#if defined(__linux__) && defined(__NR_perf_event_open)
+
+#define PERF_CACHE_MISS(c) ((uint64_t)(c) | ((uint64_t)PERF_COUNT_HW_CACHE_OP_READ << 8) | \
+                            ((uint64_t)PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const struct {
+   uint32_t type;
+   uint64_t config;
+} s_events[PERF_COUNT] = {
+   { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+   { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+   { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+   { PERF_TYPE_HW_CACHE, PERF_CACHE_MISS(PERF_COUNT_HW_CACHE_L1D) },
+   { PERF_TYPE_HW_CACHE, PERF_CACHE_MISS(PERF_COUNT_HW_CACHE_LL) }
+};
+
+int perf_counters_open(perf_counters *pc)
+{
+   int e, n = 0;
+
+   for (e = 0; e < PERF_COUNT; ++e) {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.type = s_events[e].type;
+      attr.size = sizeof(attr);
+      attr.config = s_events[e].config;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      /* more counters than the CPU has are multiplexed, scaled in perf_counters_stop() */
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      pc->fd[e] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0uL);
+      pc->value[e] = 0u;
+      if (pc->fd[e] >= 0) {
+         ++n;
+      } else {
+         pc->fd[e] = -1;
+      }
+   }
+   return n;
+}
+
+void perf_counters_close(perf_counters *pc)
+{
+   int e;
+   for (e = 0; e < PERF_COUNT; ++e) {
+      if (pc->fd[e] >= 0) {
+         close(pc->fd[e]);
+         pc->fd[e] = -1;
+      }
+   }
+}
+
+void perf_counters_start(perf_counters *pc)
+{
+   int e;
+   for (e = 0; e < PERF_COUNT; ++e) {
+      if (pc->fd[e] >= 0) {
+         ioctl(pc->fd[e], PERF_EVENT_IOC_RESET, 0);
+         ioctl(pc->fd[e], PERF_EVENT_IOC_ENABLE, 0);
+      }
+   }
+}
+
+void perf_counters_stop(perf_counters *pc)
+{
+   int e;
+   for (e = 0; e < PERF_COUNT; ++e) {
+      if (pc->fd[e] >= 0) {
+         ioctl(pc->fd[e], PERF_EVENT_IOC_DISABLE, 0);
+      }
+   }
+   for (e = 0; e < PERF_COUNT; ++e) {
+      /* value, time enabled, time running */
+      uint64_t r[3];
+      pc->value[e] = 0u;
+      if ((pc->fd[e] < 0) || (read(pc->fd[e], r, sizeof(r)) != (ssize_t)sizeof(r))) {
+         continue;
+      }
+      pc->value[e] = ((r[2] != 0u) && (r[2] < r[1])) ? (uint64_t)((double)r[0] * ((double)r[1] / (double)r[2])) : r[0];
+   }
+}
+
+#else
+
+int perf_counters_open(perf_counters *pc)
+{
+   int e;
+   for (e = 0; e < PERF_COUNT; ++e) {
+      pc->fd[e] = -1;
+      pc->value[e] = 0u;
+   }
+   return 0;
+}
+
+void perf_counters_close(perf_counters *pc)
+{
+   (void)pc;
+}
+
+void perf_counters_start(perf_counters *pc)
+{
+   (void)pc;
+}
+
+void perf_counters_stop(perf_counters *pc)
+{
+   (void)pc;
+}
+
+#endif
+
+int perf_counters_has(const perf_counters *pc, perf_event e)
+{
+   return (pc->fd[e] >= 0) ? 1 : 0;
+}
+
+const char *perf_counters_name(perf_event e)
+{
+   static const char *const names[PERF_COUNT] = {
+      "cycles", "instructions", "branch-misses", "L1D-misses", "LLC-misses"
+   };
+   return names[e];
+}
+
+double perf_counters_per(const perf_counters *pc, perf_event e, double n)
+{
+   if ((perf_counters_has(pc, e) == 0) || (n <= 0.0)) {
+      return -1.0;
+   }
+   return (double)pc->value[e] / n;
+}
+
+double perf_counters_ipc(const perf_counters *pc)
+{
+   if ((perf_counters_has(pc, PERF_CYCLES) == 0) || (perf_counters_has(pc, PERF_INSTRUCTIONS) == 0) ||
+       (pc->value[PERF_CYCLES] == 0u)) {
+      return -1.0;
+   }
+   return (double)pc->value[PERF_INSTRUCTIONS] / (double)pc->value[PERF_CYCLES];
+}
+
+static void s_fprint_value(FILE *f, const char *fmt, double v, const char *what)
+{
+   if (v < 0.0) {
+      fprintf(f, ", %s -", what);
+   } else {
+      fprintf(f, ", ");
+      fprintf(f, fmt, v);
+      fprintf(f, " %s", what);
+   }
+}
+
+void perf_counters_fprint(FILE *f, const perf_counters *pc, double calls, double digits)
+{
+   double ipc = perf_counters_ipc(pc);
+   if (ipc < 0.0) {
+      fprintf(f, "IPC -");
+   } else {
+      fprintf(f, "IPC %.2f", ipc);
+   }
+   s_fprint_value(f, "%.3f", perf_counters_per(pc, PERF_BRANCH_MISSES, calls), "branch-misses/call");
+   s_fprint_value(f, "%.4f", perf_counters_per(pc, PERF_L1D_MISSES, calls * digits), "L1D-misses/digit");
+   s_fprint_value(f, "%.4f", perf_counters_per(pc, PERF_LLC_MISSES, calls * digits), "LLC-misses/digit");
+}
@@ -0,0 +1,50 @@
+/* Hardware performance counters of timing, bench and etc/tune.
+ *
+ * On Linux the counters are read with perf_event_open(2) for the calling
+ * thread in user mode. A counter which the kernel, the CPU or the virtual
+ * machine does not offer is left out, elsewhere there are none at all.
+ * The tools then report the time only.
+ */
+#ifndef PERF_COUNTERS_H_
+#define PERF_COUNTERS_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum {
+   PERF_CYCLES = 0,
+   PERF_INSTRUCTIONS,
+   PERF_BRANCH_MISSES,
+   PERF_L1D_MISSES,
+   PERF_LLC_MISSES,
+   PERF_COUNT
+} perf_event;
+
+typedef struct {
+   int fd[PERF_COUNT];           /* -1 if the counter is not available */
+   uint64_t value[PERF_COUNT];   /* the counts of the last perf_counters_stop() */
+} perf_counters;
+
+/* returns the number of available counters, 0 if there are none */
+int perf_counters_open(perf_counters *pc);
+void perf_counters_close(perf_counters *pc);
+
+int perf_counters_has(const perf_counters *pc, perf_event e);
+const char *perf_counters_name(perf_event e);
+
+/* count from zero until perf_counters_stop() */
+void perf_counters_start(perf_counters *pc);
+void perf_counters_stop(perf_counters *pc);
+
+/* "e" per "n", e.g. per call or per digit, or -1.0 if it is not available */
+double perf_counters_per(const perf_counters *pc, perf_event e, double n);
+
+/* instructions per cycle, or -1.0 */
+double perf_counters_ipc(const perf_counters *pc);
+
+/* prints the IPC, the branch misses per call and the cache misses per digit
+ * of the last measurement of "calls" calls on operands of "digits" digits
+ */
+void perf_counters_fprint(FILE *f, const perf_counters *pc, double calls, double digits);
+
+#endif
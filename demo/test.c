@@ -1,6 +1,12 @@
 #include <inttypes.h>
 #include "shared.h"
 
+#if defined(__unix__) && defined(MP_THREAD_LOCAL)
+#include <sys/wait.h>
+#include <unistd.h>
+#define LTM_TEST_FORK
+#endif
+
 static long rand_long(void)
 {
    long x;
@@ -262,6 +268,459 @@ LBL_ERR:
    return EXIT_FAILURE;
 }
 
+static int test_mp_fwrite_limbs_mmap_load(void)
+{
+   const char *path = "test_limbs.tmp";
+   mp_int a, b, c;
+   FILE *tmp = NULL;
+   DOR(mp_init_multi(&a, &b, NULL));
+
+   DO(mp_rand(&a, 1000));
+   DO(mp_neg(&a, &a));
+   tmp = fopen(path, "wb");
+   EXPECT(tmp != NULL);
+   DO(mp_fwrite_limbs(&a, tmp));
+   fclose(tmp);
+   tmp = NULL;
+
+   /* copy */
+   DO(mp_mmap_load(&b, path, true));
+   EXPECT(mp_cmp(&a, &b) == MP_EQ);
+
+   /* map without copying */
+   if (mp_mmap_load(&c, path, false) == MP_OKAY) {
+      EXPECT(mp_cmp(&a, &c) == MP_EQ);
+      DO(mp_add(&a, &c, &b));
+      DO(mp_mul_2(&a, &a));
+      EXPECT(mp_cmp(&a, &b) == MP_EQ);
+      mp_mmap_unload(&c);
+      EXPECT(c.dp == NULL);
+   }
+
+   /* trailing garbage */
+   tmp = fopen(path, "ab");
+   EXPECT(tmp != NULL);
+   EXPECT(fputc(0, tmp) == 0);
+   fclose(tmp);
+   tmp = NULL;
+   EXPECT(mp_mmap_load(&b, path, true) == MP_VAL);
+
+   remove(path);
+   mp_clear_multi(&a, &b, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   if (tmp != NULL) fclose(tmp);
+   remove(path);
+   mp_clear_multi(&a, &b, NULL);
+   return EXIT_FAILURE;
+}
+
+#if defined(MP_RUNTIME_ALLOCATOR)
+typedef struct {
+   size_t calls, live;
+} counting_allocator_ctx;
+
+static void *counting_malloc(void *ctx, size_t size)
+{
+   counting_allocator_ctx *c = (counting_allocator_ctx *)ctx;
+   void *mem = malloc(size);
+   if (mem != NULL) {
+      c->calls++;
+      c->live += size;
+   }
+   return mem;
+}
+
+static void *counting_realloc(void *ctx, void *mem, size_t oldsize, size_t newsize)
+{
+   counting_allocator_ctx *c = (counting_allocator_ctx *)ctx;
+   void *p = realloc(mem, newsize);
+   if (p != NULL) {
+      c->calls++;
+      c->live += newsize - oldsize;
+   }
+   return p;
+}
+
+static void counting_free(void *ctx, void *mem, size_t size)
+{
+   counting_allocator_ctx *c = (counting_allocator_ctx *)ctx;
+   c->calls++;
+   c->live -= size;
+   free(mem);
+}
+
+static int test_mp_set_allocator(void)
+{
+   counting_allocator_ctx ctx = { 0u, 0u };
+   mp_allocator allocator;
+   mp_int a, b;
+
+   allocator.malloc_fn = counting_malloc;
+   allocator.realloc_fn = counting_realloc;
+   allocator.free_fn = NULL;
+   allocator.ctx = &ctx;
+   EXPECT(mp_set_allocator(&allocator) == MP_VAL);
+   allocator.free_fn = counting_free;
+   DOR(mp_set_allocator(&allocator));
+
+   if (mp_init_multi(&a, &b, NULL) != MP_OKAY) {
+      DOR(mp_set_allocator(NULL));
+      return EXIT_FAILURE;
+   }
+   DO(mp_rand(&a, 100));
+   DO(mp_sqr(&a, &b));
+   DO(mp_shrink(&b));
+   DO(mp_mul(&a, &b, &a));
+   EXPECT(ctx.live > 0u);
+   mp_clear_multi(&a, &b, NULL);
+   mp_digit_cache_flush();
+
+   EXPECT(ctx.calls > 0u);
+   EXPECT(ctx.live == 0u);
+
+   DOR(mp_set_allocator(NULL));
+   return EXIT_SUCCESS;
+LBL_ERR:
+   mp_clear_multi(&a, &b, NULL);
+   DOR(mp_set_allocator(NULL));
+   return EXIT_FAILURE;
+}
+#endif
+
+static int test_mp_digit_cache(void)
+{
+   mp_digit_cache_stats before, after;
+   mp_int a, b;
+
+   if (mp_digit_cache_stats_get(&before) != MP_OKAY) {
+      /* built without MP_DIGIT_CACHE */
+      return EXIT_SUCCESS;
+   }
+
+   mp_digit_cache_flush();
+   DOR(mp_digit_cache_stats_get(&before));
+   EXPECT(before.bytes == 0u);
+
+   DOR(mp_init_size(&a, MP_DEFAULT_DIGIT_COUNT));
+   if (mp_init_size(&b, MP_DEFAULT_DIGIT_COUNT) != MP_OKAY) {
+      mp_clear(&a);
+      return EXIT_FAILURE;
+   }
+   mp_clear(&b);
+   DO(mp_init_size(&b, MP_DEFAULT_DIGIT_COUNT));
+   DO(mp_digit_cache_stats_get(&after));
+   EXPECT(after.hits == (before.hits + 1u));
+   EXPECT(after.retained == (before.retained + 1u));
+
+   /* growing jumps to the next size class */
+   DO(mp_grow(&a, a.alloc + 1));
+   EXPECT(a.alloc == (2 * MP_DEFAULT_DIGIT_COUNT));
+   DO(mp_rand(&a, 3 * MP_DEFAULT_DIGIT_COUNT));
+   EXPECT(a.alloc == (4 * MP_DEFAULT_DIGIT_COUNT));
+   DO(mp_copy(&a, &b));
+   DO(mp_shrink(&b));
+   EXPECT(b.alloc == (4 * MP_DEFAULT_DIGIT_COUNT));
+
+   mp_clear_multi(&a, &b, NULL);
+   mp_digit_cache_flush();
+   DOR(mp_digit_cache_stats_get(&after));
+   EXPECT(after.bytes == 0u);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   mp_clear_multi(&a, &b, NULL);
+   return EXIT_FAILURE;
+}
+
+static int test_mp_alloc_stats(void)
+{
+   mp_alloc_stats st;
+   size_t mul;
+   mp_int a, b, c, d;
+
+   if (mp_alloc_stats_get(&st) != MP_OKAY) {
+      /* built without MP_ALLOC_STATS */
+      return EXIT_SUCCESS;
+   }
+
+   DOR(mp_init_multi(&a, &b, &c, &d, NULL));
+   DO(mp_rand(&a, 40));
+   DO(mp_rand(&b, 20));
+   DO(mp_scratch_reserve(0u));
+   mp_digit_cache_flush();
+
+   mp_alloc_stats_reset();
+   DO(mp_alloc_stats_get(&st));
+   EXPECT(st.op[MP_ALLOC_OP_MUL].allocs == 0u);
+   EXPECT(st.op[MP_ALLOC_OP_MUL].peak == 0u);
+
+   /* the result is grown and the temporaries are allocated by the operation */
+   DO(mp_mul(&a, &b, &c));
+   DO(mp_div(&c, &b, &d, NULL));
+   EXPECT(mp_cmp(&a, &d) == MP_EQ);
+   DO(mp_alloc_stats_get(&st));
+   EXPECT(st.op[MP_ALLOC_OP_MUL].allocs > 0u);
+   EXPECT(st.op[MP_ALLOC_OP_DIV].allocs > 0u);
+   EXPECT(st.op[MP_ALLOC_OP_DIV].bytes >= (20u * sizeof(mp_digit)));
+   EXPECT(st.op[MP_ALLOC_OP_DIV].peak >= st.op[MP_ALLOC_OP_MUL].peak);
+   EXPECT(st.op[MP_ALLOC_OP_NONE].allocs == 0u);
+
+   /* nested calls are attributed to the outermost function */
+   mul = st.op[MP_ALLOC_OP_MUL].allocs;
+   DO(mp_add_d(&b, (mp_isodd(&b) ? 0u : 1u), &b));
+   DO(mp_exptmod(&a, &a, &b, &d));
+   DO(mp_alloc_stats_get(&st));
+   EXPECT(st.op[MP_ALLOC_OP_EXPTMOD].allocs > 0u);
+   EXPECT(st.op[MP_ALLOC_OP_MUL].allocs == mul);
+
+   mp_clear_multi(&a, &b, &c, &d, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   mp_clear_multi(&a, &b, &c, &d, NULL);
+   return EXIT_FAILURE;
+}
+
+static int test_mp_stats(void)
+{
+   mp_stats st;
+   mp_int a, b, c, d;
+   uint64_t sum;
+   int n, k;
+
+   if (mp_stats_snapshot(&st) != MP_OKAY) {
+      /* built without MP_STATS */
+      return EXIT_SUCCESS;
+   }
+
+   DOR(mp_init_multi(&a, &b, &c, &d, NULL));
+   DO(mp_rand(&a, 4));
+   DO(mp_rand(&b, 3));
+
+   mp_stats_reset();
+   DO(mp_stats_snapshot(&st));
+   for (n = 0; n < (int)MP_STATS_PATH_COUNT; n++) {
+      EXPECT(st.calls[n] == 0u);
+   }
+
+   /* the size of a product is the smaller operand */
+   DO(mp_mul(&a, &b, &c));
+   DO(mp_sqr(&a, &d));
+   DO(mp_stats_snapshot(&st));
+   EXPECT((st.calls[MP_STATS_MUL_COMBA] + st.calls[MP_STATS_MUL_BASECASE]) == 1u);
+   EXPECT((st.size[MP_STATS_MUL_COMBA][1] + st.size[MP_STATS_MUL_BASECASE][1]) == 1u);
+   EXPECT((st.calls[MP_STATS_SQR_COMBA] + st.calls[MP_STATS_SQR_BASECASE]) == 1u);
+   EXPECT((st.size[MP_STATS_SQR_COMBA][2] + st.size[MP_STATS_SQR_BASECASE][2]) == 1u);
+
+   DO(mp_div(&b, &c, &d, NULL));
+   DO(mp_div(&c, &b, &d, NULL));
+   DO(mp_stats_snapshot(&st));
+   EXPECT(st.calls[MP_STATS_DIV_TRIVIAL] == 1u);
+   EXPECT((st.calls[MP_STATS_DIV_SCHOOL] + st.calls[MP_STATS_DIV_SMALL] + st.calls[MP_STATS_DIV_RECURSIVE]) == 1u);
+
+   /* the reduction of mp_exptmod by the form of the modulus */
+   DO(mp_rand(&b, 5));
+   b.dp[0] |= 1u;
+   DO(mp_exptmod(&a, &a, &b, &d));
+   DO(mp_2expt(&c, MP_DIGIT_BIT + 8));
+   DO(mp_sub_d(&c, 3u, &c));
+   DO(mp_exptmod(&a, &a, &c, &d));
+   DO(mp_2expt(&c, 4 * MP_DIGIT_BIT));
+   DO(mp_sub_d(&c, 3u, &c));
+   DO(mp_exptmod(&a, &a, &c, &d));
+   DO(mp_add_d(&b, 1u, &b));
+   DO(mp_exptmod(&a, &a, &b, &d));
+   DO(mp_stats_snapshot(&st));
+   EXPECT(st.calls[MP_STATS_EXPTMOD_MONTGOMERY] == 1u);
+   EXPECT(st.calls[MP_STATS_EXPTMOD_2K] == 1u);
+   EXPECT(st.calls[MP_STATS_EXPTMOD_2K_L] == 1u);
+   EXPECT(st.calls[MP_STATS_EXPTMOD_BARRETT] == 1u);
+   EXPECT(st.calls[MP_STATS_EXPTMOD_DR] == 0u);
+
+   for (n = 0; n < (int)MP_STATS_PATH_COUNT; n++) {
+      sum = 0u;
+      for (k = 0; k < MP_STATS_BUCKETS; k++) {
+         sum += st.size[n][k];
+      }
+      EXPECT(sum == st.calls[n]);
+   }
+
+   mp_clear_multi(&a, &b, &c, &d, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   mp_clear_multi(&a, &b, &c, &d, NULL);
+   return EXIT_FAILURE;
+}
+
+#if defined(MP_INLINE_DIGITS)
+static int test_mp_inline_digits(void)
+{
+   mp_int a, b, c;
+
+   DOR(mp_init_multi(&a, &b, &c, NULL));
+   EXPECT((a.dp == a.inl) && (a.alloc == MP_INLINE_DIGITS));
+
+   /* spill to the heap and back */
+   DO(mp_rand(&a, MP_INLINE_DIGITS + 1));
+   EXPECT(a.dp != a.inl);
+   DO(mp_copy(&a, &c));
+   DO(mp_mod_2d(&a, MP_DIGIT_BIT, &a));
+   DO(mp_shrink(&a));
+   EXPECT((a.dp == a.inl) && (a.alloc == MP_INLINE_DIGITS));
+   DO(mp_mod_2d(&c, MP_DIGIT_BIT, &b));
+   DO(mp_shrink(&b));
+   EXPECT(mp_cmp(&a, &b) == MP_EQ);
+
+   /* exchange inline with heap digits and inline with inline digits */
+   mp_exch(&a, &c);
+   EXPECT((c.dp == c.inl) && (a.dp != a.inl));
+   EXPECT(mp_cmp(&c, &b) == MP_EQ);
+   mp_exch(&b, &c);
+   EXPECT((b.dp == b.inl) && (c.dp == c.inl));
+   EXPECT(mp_cmp(&b, &c) == MP_EQ);
+
+   /* a shallow copy stays valid while the original spills */
+   mp_set(&b, 1u);
+   DO(mp_mul_2d(&b, (MP_INLINE_DIGITS * MP_DIGIT_BIT) - 1, &b));
+   DO(mp_shrink(&b));
+   EXPECT(b.dp == b.inl);
+   DO(mp_complement(&b, &b));
+   DO(mp_add_d(&b, 1u, &b));
+   DO(mp_neg(&b, &b));
+   mp_set(&c, 1u);
+   DO(mp_mul_2d(&c, (MP_INLINE_DIGITS * MP_DIGIT_BIT) - 1, &c));
+   EXPECT(mp_cmp(&b, &c) == MP_EQ);
+
+   mp_clear_multi(&a, &b, &c, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   mp_clear_multi(&a, &b, &c, NULL);
+   return EXIT_FAILURE;
+}
+#endif
+
+static int test_mp_scratch_reserve(void)
+{
+   /* region sizes in bytes: none, too small for the temporaries, large enough */
+   static const size_t sizes[] = { 0u, 64u, 1u << 16 };
+   mp_int a, b, e, p, q, r, q0, r0, y0;
+   size_t n;
+   int i;
+
+   DOR(mp_init_multi(&a, &b, &e, &p, &q, &r, &q0, &r0, &y0, NULL));
+
+   for (i = 0; i < 10; ++i) {
+      DO(mp_rand(&a, 8 * MP_MUL_KARATSUBA_CUTOFF));
+      DO(mp_rand(&b, 2 * MP_MUL_KARATSUBA_CUTOFF));
+      DO(mp_rand(&e, 8));
+      DO(mp_rand(&p, 8));
+      DO(mp_mul_2(&p, &p));
+      DO(mp_incr(&p));
+
+      DO(mp_scratch_reserve(0u));
+      DO(s_mp_div_school(&a, &b, &q0, &r0));
+      DO(mp_exptmod(&a, &e, &p, &y0));
+
+      for (n = 0u; n < (sizeof(sizes) / sizeof(sizes[0])); ++n) {
+         if (mp_scratch_reserve(sizes[n]) != MP_OKAY) {
+            /* no thread local storage, the heap is used throughout */
+            EXPECT(sizes[n] != 0u);
+            continue;
+         }
+         if (MP_HAS(S_MP_DIV_RECURSIVE)) {
+            DO(s_mp_div_recursive(&a, &b, &q, &r));
+            EXPECT(mp_cmp(&q, &q0) == MP_EQ);
+            EXPECT(mp_cmp(&r, &r0) == MP_EQ);
+         }
+         DO(mp_exptmod(&a, &e, &p, &q));
+         EXPECT(mp_cmp(&q, &y0) == MP_EQ);
+      }
+   }
+
+   DO(mp_scratch_reserve(0u));
+   mp_clear_multi(&a, &b, &e, &p, &q, &r, &q0, &r0, &y0, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   DOR(mp_scratch_reserve(0u));
+   mp_clear_multi(&a, &b, &e, &p, &q, &r, &q0, &r0, &y0, NULL);
+   return EXIT_FAILURE;
+}
+
+#if defined(MP_THREAD_LOCAL)
+static int test_mp_mul_div_exptmod_scratch(void)
+{
+   static const int sizes[] = { 1, 5, 40, 200 };
+   mp_int a, b, p, q, r, c, d;
+   mp_digit *scratch = NULL;
+   size_t n, itch;
+#if defined(MP_RUNTIME_ALLOCATOR)
+   counting_allocator_ctx ctx = { 0u, 0u };
+   mp_allocator allocator;
+   allocator.malloc_fn = counting_malloc;
+   allocator.realloc_fn = counting_realloc;
+   allocator.free_fn = counting_free;
+   allocator.ctx = &ctx;
+#endif
+
+   DOR(mp_init_multi(&a, &b, &p, &q, &r, &c, &d, NULL));
+
+   for (n = 0u; n < (sizeof(sizes) / sizeof(sizes[0])); ++n) {
+      int size = sizes[n];
+      DO(mp_rand(&a, 2 * size));
+      DO(mp_rand(&b, size));
+      DO(mp_rand(&p, size));
+      DO(mp_mul_2(&p, &p));
+      DO(mp_incr(&p));
+
+      itch = MP_MAX(mp_mul_itch(2 * size), MP_MAX(mp_div_itch(2 * size, size), mp_exptmod_itch(&p)));
+      free(scratch);
+      scratch = (mp_digit *)malloc(itch * sizeof(mp_digit));
+      EXPECT(scratch != NULL);
+
+      /* pre-grow the results, afterwards no heap allocation is allowed */
+      DO(mp_grow(&q, (3 * size) + 2));
+      DO(mp_grow(&r, size + 2));
+      DO(mp_mod(&a, &p, &d));
+#if defined(MP_RUNTIME_ALLOCATOR)
+      DOR(mp_set_allocator(&allocator));
+#endif
+      DO(mp_mul_scratch(&a, &b, &q, scratch, mp_mul_itch(2 * size)));
+      DO(mp_div_scratch(&q, &b, &q, &r, scratch, mp_div_itch(3 * size, size)));
+      EXPECT(mp_cmp(&q, &a) == MP_EQ);
+      EXPECT(mp_iszero(&r));
+      DO(mp_exptmod_scratch(&d, &b, &p, &q, scratch, mp_exptmod_itch(&p)));
+#if defined(MP_RUNTIME_ALLOCATOR)
+      DOR(mp_set_allocator(NULL));
+      EXPECT(ctx.calls == 0u);
+#endif
+      DO(mp_exptmod(&d, &b, &p, &c));
+      EXPECT(mp_cmp(&q, &c) == MP_EQ);
+
+      /* too small scratch region or result */
+      if (size > 1) {
+         EXPECT(mp_mul_scratch(&a, &a, &q, scratch, 0u) == MP_MEM);
+         EXPECT(mp_exptmod_scratch(&d, &b, &p, &q, scratch, (size_t)size) == MP_MEM);
+      }
+      DO(mp_mul(&a, &a, &c));
+      DO(mp_shrink(&d));
+      if (d.alloc < c.used) {
+         EXPECT(mp_mul_scratch(&a, &a, &d, scratch, itch) == MP_MEM);
+      }
+   }
+
+   free(scratch);
+   mp_clear_multi(&a, &b, &p, &q, &r, &c, &d, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+#if defined(MP_RUNTIME_ALLOCATOR)
+   DOR(mp_set_allocator(NULL));
+#endif
+   free(scratch);
+   mp_clear_multi(&a, &b, &p, &q, &r, &c, &d, NULL);
+   return EXIT_FAILURE;
+}
+
+#endif
+
 static mp_err very_random_source(void *out, size_t size)
 {
    memset(out, 0xff, size);
@@ -292,6 +751,129 @@ LBL_ERR:
    return (e == MP_OKAY) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
+static int test_mp_rng(void)
+{
+   /* RFC 8439, appendix A.1, test vector 1 */
+   static const uint8_t zero_key[16] = {
+      0x76, 0xb8, 0xe0, 0xad, 0xa0, 0xf1, 0x3d, 0x90, 0x40, 0x5d, 0x6a, 0xe5, 0x53, 0x86, 0xbd, 0x28
+   };
+   mp_rng r1, r2;
+   uint8_t b1[200], b2[200];
+   mp_int a, b, n;
+   int i;
+
+   DOR(mp_init_multi(&a, &b, &n, NULL));
+
+   mp_rng_init(&r1, 0u, 0u);
+   mp_rng_bytes(&r1, b1, 16u);
+   EXPECT(memcmp(b1, zero_key, 16u) == 0);
+
+   /* same seed and stream give the same bytes, however they are read */
+   mp_rng_init(&r1, 23u, 5u);
+   mp_rng_init(&r2, 23u, 5u);
+   mp_rng_bytes(&r1, b1, sizeof(b1));
+   mp_rng_bytes(&r2, b2, 7u);
+   mp_rng_bytes(&r2, b2 + 7, sizeof(b2) - 7u);
+   EXPECT(memcmp(b1, b2, sizeof(b1)) == 0);
+
+   /* jumping skips whole blocks */
+   mp_rng_init(&r2, 23u, 5u);
+   mp_rng_jump(&r2, 2u);
+   mp_rng_bytes(&r2, b2, 64u);
+   EXPECT(memcmp(b1 + 128, b2, 64u) == 0);
+
+   /* other streams are different */
+   mp_rng_init(&r2, 23u, 6u);
+   mp_rng_bytes(&r2, b2, sizeof(b2));
+   EXPECT(memcmp(b1, b2, sizeof(b1)) != 0);
+
+   mp_rng_init(&r1, 42u, 0u);
+   mp_rng_init(&r2, 42u, 0u);
+   DO(mp_rand_ex(&r1, &a, 20));
+   DO(mp_rand_ex(&r2, &b, 20));
+   EXPECT((a.used == 20) && (a.dp[19] != 0u));
+   EXPECT(mp_cmp(&a, &b) == MP_EQ);
+
+   for (i = 0; i < 200; i++) {
+      DO(mp_rand_bits(&r1, &a, i));
+      EXPECT(mp_count_bits(&a) <= i);
+   }
+   EXPECT(mp_rand_bits(&r1, &a, -1) == MP_VAL);
+   EXPECT(mp_rand_bits(&r1, &a, INT_MIN) == MP_VAL);
+   EXPECT(mp_rand_bits(&r1, &a, INT_MAX) == MP_OVF);
+
+   DO(mp_rand_ex(&r1, &n, 3));
+   for (i = 0; i < 100; i++) {
+      DO(mp_rand_range(&r1, &a, &n));
+      EXPECT(!mp_isneg(&a) && (mp_cmp(&a, &n) == MP_LT));
+   }
+   DO(mp_copy(&n, &b));
+   DO(mp_rand_range(NULL, &b, &b));
+   EXPECT(mp_cmp(&b, &n) == MP_LT);
+   mp_zero(&n);
+   EXPECT(mp_rand_range(&r1, &a, &n) == MP_VAL);
+
+   mp_clear_multi(&a, &b, &n, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   mp_clear_multi(&a, &b, &n, NULL);
+   return EXIT_FAILURE;
+}
+
+static int test_s_mp_rand_chacha(void)
+{
+   /* RFC 8439, section 2.3.2 */
+   static const uint32_t key[8] = {
+      0x03020100u, 0x07060504u, 0x0b0a0908u, 0x0f0e0d0cu,
+      0x13121110u, 0x17161514u, 0x1b1a1918u, 0x1f1e1d1cu
+   };
+   static const uint32_t nonce[3] = { 0x09000000u, 0x4a000000u, 0u };
+   static const uint8_t expected[64] = {
+      0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+      0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+      0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+      0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e
+   };
+   uint8_t out[64], big[3000];
+#ifdef LTM_TEST_FORK
+   uint8_t child[32];
+   int fd[2], status;
+   pid_t pid;
+#endif
+
+   s_mp_chacha20_block(key, 1u, nonce, out);
+   EXPECT(memcmp(out, expected, sizeof(out)) == 0);
+
+   /* consecutive requests, also across refills of the buffer */
+   DO(s_mp_rand_chacha(out, 32u));
+   DO(s_mp_rand_chacha(out + 32, 32u));
+   EXPECT(memcmp(out, out + 32, 32u) != 0);
+   DO(s_mp_rand_chacha(big, sizeof(big)));
+   EXPECT(memcmp(big, big + 1024, 32u) != 0);
+
+#ifdef LTM_TEST_FORK
+   /* the child must not repeat the buffered output of the parent */
+   EXPECT(pipe(fd) == 0);
+   pid = fork();
+   EXPECT(pid >= 0);
+   if (pid == 0) {
+      int ok = (s_mp_rand_chacha(child, sizeof(child)) == MP_OKAY)
+               && (write(fd[1], child, sizeof(child)) == (ssize_t)sizeof(child));
+      _exit(ok ? 0 : 1);
+   }
+   close(fd[1]);
+   EXPECT(read(fd[0], child, sizeof(child)) == (ssize_t)sizeof(child));
+   close(fd[0]);
+   EXPECT((waitpid(pid, &status, 0) == pid) && WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+   DO(s_mp_rand_chacha(out, 32u));
+   EXPECT(memcmp(out, child, 32u) != 0);
+#endif
+
+   return EXIT_SUCCESS;
+LBL_ERR:
+   return EXIT_FAILURE;
+}
+
 static int test_mp_kronecker(void)
 {
    struct mp_kronecker_st {
@@ -366,6 +948,11 @@ static int test_mp_complement(void)
       mp_set_l(&c, l);
 
       EXPECT(mp_cmp(&b, &c) == MP_EQ);
+
+      /* in place, without room for a carry */
+      DO(mp_shrink(&a));
+      DO(mp_complement(&a, &a));
+      EXPECT(mp_cmp(&a, &c) == MP_EQ);
    }
 
    mp_clear_multi(&a, &b, &c, NULL);
@@ -395,6 +982,8 @@ static int test_mp_signed_rsh(void)
 
       DO(mp_signed_rsh(&a, em, &b));
       EXPECT(mp_cmp(&b, &d) == MP_EQ);
+      DO(mp_signed_rsh(&a, em, &a));
+      EXPECT(mp_cmp(&a, &d) == MP_EQ);
    }
 
    mp_clear_multi(&a, &b, &d, NULL);
@@ -457,6 +1046,23 @@ static int test_mp_or(void)
       EXPECT(mp_cmp(&c, &d) == MP_EQ);
    }
 
+   /* longer non-negative operands, a | b = (a ^ b) + (a & b), also in place */
+   for (i = 0; i < 100; ++i) {
+      DO(mp_rand(&a, 1 + (abs(rand_int()) % 40)));
+      DO(mp_rand(&b, 1 + (abs(rand_int()) % 40)));
+      DO(mp_xor(&a, &b, &c));
+      DO(mp_and(&a, &b, &d));
+      DO(mp_add(&c, &d, &d));
+      DO(mp_or(&a, &b, &c));
+      EXPECT(mp_cmp(&c, &d) == MP_EQ);
+      DO(mp_or(&a, &b, &a));
+      EXPECT(mp_cmp(&a, &d) == MP_EQ);
+      /* (a | b) ^ b has no bits of b left */
+      DO(mp_xor(&a, &b, &a));
+      DO(mp_and(&b, &a, &a));
+      EXPECT(mp_iszero(&a));
+   }
+
    mp_clear_multi(&a, &b, &c, &d, NULL);
    return EXIT_SUCCESS;
 LBL_ERR:
@@ -752,6 +1358,247 @@ LBL_ERR:
    return EXIT_FAILURE;
 }
 
+static int s_batch_started[3];
+
+static void s_batch_start(void *ctx, int worker)
+{
+   (void)ctx;
+   s_batch_started[worker] = 1;
+}
+
+#if defined(MP_RUNTIME_ALLOCATOR) && defined(MP_HAS_PTHREAD)
+static pthread_mutex_t s_batch_alloc_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void *locked_counting_malloc(void *ctx, size_t size)
+{
+   void *mem;
+   (void)pthread_mutex_lock(&s_batch_alloc_lock);
+   mem = counting_malloc(ctx, size);
+   (void)pthread_mutex_unlock(&s_batch_alloc_lock);
+   return mem;
+}
+
+static void *locked_counting_realloc(void *ctx, void *mem, size_t oldsize, size_t newsize)
+{
+   void *p;
+   (void)pthread_mutex_lock(&s_batch_alloc_lock);
+   p = counting_realloc(ctx, mem, oldsize, newsize);
+   (void)pthread_mutex_unlock(&s_batch_alloc_lock);
+   return p;
+}
+
+static void locked_counting_free(void *ctx, void *mem, size_t size)
+{
+   (void)pthread_mutex_lock(&s_batch_alloc_lock);
+   counting_free(ctx, mem, size);
+   (void)pthread_mutex_unlock(&s_batch_alloc_lock);
+}
+
+/* the digits cached by the workers are returned when the allocator is replaced */
+static int s_batch_allocator(const mp_int *a, const mp_int *b, const mp_int *c)
+{
+   counting_allocator_ctx ctx = { 0u, 0u };
+   mp_allocator allocator;
+   mp_int x[8], y[8], z[8], r[8], t;
+   int i, n = 0;
+
+   allocator.malloc_fn = locked_counting_malloc;
+   allocator.realloc_fn = locked_counting_realloc;
+   allocator.free_fn = locked_counting_free;
+   allocator.ctx = &ctx;
+   DOR(mp_set_allocator(&allocator));
+
+   if (mp_init(&t) != MP_OKAY) {
+      DOR(mp_set_allocator(NULL));
+      return EXIT_FAILURE;
+   }
+   for (n = 0; n < 8; n++) {
+      DO(mp_init_copy(&x[n], &a[n]));
+      DO(mp_init_copy(&y[n], &b[n]));
+      DO(mp_init_copy(&z[n], &c[n]));
+      DO(mp_init(&r[n]));
+   }
+   DO(mp_batch_mulmod(x, y, z, r, NULL, 8u));
+   for (i = 0; i < 8; i++) {
+      DO(mp_mulmod(&x[i], &y[i], &z[i], &t));
+      EXPECT(mp_cmp(&t, &r[i]) == MP_EQ);
+   }
+
+   for (i = 0; i < n; i++) {
+      mp_clear_multi(&x[i], &y[i], &z[i], &r[i], NULL);
+   }
+   mp_clear(&t);
+   DOR(mp_set_allocator(NULL));
+   EXPECT(ctx.live == 0u);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   for (i = 0; i < n; i++) {
+      mp_clear_multi(&x[i], &y[i], &z[i], &r[i], NULL);
+   }
+   mp_clear(&t);
+   DOR(mp_set_allocator(NULL));
+   return EXIT_FAILURE;
+}
+
+typedef struct {
+   const mp_int *a, *e, *p;
+   mp_err err;
+} s_thread_exptmod_args;
+
+static void *s_thread_exptmod(void *arg)
+{
+   s_thread_exptmod_args *args = (s_thread_exptmod_args *)arg;
+   mp_int y;
+   if ((args->err = mp_init(&y)) == MP_OKAY) {
+      args->err = mp_exptmod(args->a, args->e, args->p, &y);
+      mp_clear(&y);
+   }
+   return NULL;
+}
+
+/* the scratch region and the digit cache of a thread are released when it exits */
+static int test_s_mp_thread_atexit(void)
+{
+   counting_allocator_ctx ctx = { 0u, 0u };
+   mp_allocator allocator;
+   s_thread_exptmod_args args;
+   pthread_t thread;
+   mp_int a, e, p;
+
+   DOR(mp_init_multi(&a, &e, &p, NULL));
+   DO(mp_rand(&a, 32));
+   DO(mp_rand(&e, 32));
+   DO(mp_rand(&p, 32));
+   p.dp[0] |= 1u;
+
+   allocator.malloc_fn = locked_counting_malloc;
+   allocator.realloc_fn = locked_counting_realloc;
+   allocator.free_fn = locked_counting_free;
+   allocator.ctx = &ctx;
+   DO(mp_set_allocator(&allocator));
+
+   args.a = &a;
+   args.e = &e;
+   args.p = &p;
+   EXPECT(pthread_create(&thread, NULL, s_thread_exptmod, &args) == 0);
+   (void)pthread_join(thread, NULL);
+   DO(args.err);
+   EXPECT(ctx.calls > 0u);
+   EXPECT(ctx.live == 0u);
+
+   DO(mp_set_allocator(NULL));
+   mp_clear_multi(&a, &e, &p, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   DOR(mp_set_allocator(NULL));
+   mp_clear_multi(&a, &e, &p, NULL);
+   return EXIT_FAILURE;
+}
+#endif
+
+static int test_mp_batch(void)
+{
+   mp_batch_config config = { 3, s_batch_start, NULL };
+   mp_int a[24], b[24], c[24], d[24];
+   mp_err errs[24];
+   bool result[24], res;
+   bool threads;
+   mp_err ret, first, e;
+   int i;
+
+   for (i = 0; i < 24; i++) {
+      DOR(mp_init_multi(&a[i], &b[i], &c[i], &d[i], NULL));
+   }
+
+   threads = (mp_batch_config_set(&config) == MP_OKAY);
+
+   for (i = 0; i < 24; i++) {
+      DO(mp_rand(&a[i], 1 + (abs(rand_int()) % 8)));
+      DO(mp_rand(&b[i], 1 + (abs(rand_int()) % 8)));
+      DO(mp_rand(&c[i], 1 + (abs(rand_int()) % 8)));
+      mp_set(&d[i], 0u);
+   }
+   /* the lowest failing element is reported */
+   DO(mp_neg(&c[17], &c[17]));
+   DO(mp_neg(&c[5], &c[5]));
+
+   EXPECT(mp_batch_exptmod(a, b, c, d, errs, 24u) == MP_VAL);
+   for (i = 0; i < 24; i++) {
+      if ((i == 5) || (i == 17)) {
+         EXPECT(errs[i] == MP_VAL);
+         continue;
+      }
+      EXPECT(errs[i] == MP_OKAY);
+      DO(mp_exptmod(&a[i], &b[i], &c[i], &a[i]));
+      EXPECT(mp_cmp(&a[i], &d[i]) == MP_EQ);
+   }
+   DO(mp_abs(&c[5], &c[5]));
+   DO(mp_abs(&c[17], &c[17]));
+
+   DO(mp_batch_mulmod(a, b, c, d, NULL, 24u));
+   for (i = 0; i < 24; i++) {
+      DO(mp_mulmod(&a[i], &b[i], &c[i], &a[i]));
+      EXPECT(mp_cmp(&a[i], &d[i]) == MP_EQ);
+   }
+
+   /* every fourth element shares the modulus as a factor and is not invertible */
+   for (i = 0; i < 24; i++) {
+      DO(mp_rand(&a[i], 1 + (abs(rand_int()) % 8)));
+      DO(mp_add_d(&c[i], 2u, &c[i]));
+      if ((i % 4) == 2) {
+         DO(mp_mul(&b[i], &c[i], &a[i]));
+      }
+   }
+   mp_set(&a[0], 1u);
+   ret = mp_batch_invmod(a, c, d, errs, 24u);
+   first = MP_OKAY;
+   for (i = 0; i < 24; i++) {
+      e = mp_invmod(&a[i], &c[i], &b[i]);
+      EXPECT(errs[i] == e);
+      if (e != MP_OKAY) {
+         if (first == MP_OKAY) {
+            first = e;
+         }
+         continue;
+      }
+      EXPECT(mp_cmp(&b[i], &d[i]) == MP_EQ);
+   }
+   EXPECT(errs[0] == MP_OKAY);
+   EXPECT(errs[2] == MP_VAL);
+   EXPECT(ret == first);
+#if defined(MP_RUNTIME_ALLOCATOR) && defined(MP_HAS_PTHREAD)
+   EXPECT(s_batch_allocator(a, b, c) == EXIT_SUCCESS);
+#endif
+
+   for (i = 0; i < 24; i++) {
+      mp_set_u32(&a[i], 1000003u + 2u * (uint32_t)i);
+   }
+   DO(mp_batch_prime_is_prime(a, 8, result, errs, 24u));
+   for (i = 0; i < 24; i++) {
+      EXPECT(errs[i] == MP_OKAY);
+      DO(mp_prime_is_prime(&a[i], 8, &res));
+      EXPECT(result[i] == res);
+   }
+
+   /* stopping the workers waits for them to exit */
+   if (threads) {
+      DO(mp_batch_config_set(NULL));
+      for (i = 0; i < 3; i++) {
+         EXPECT(s_batch_started[i] == 1);
+      }
+   }
+
+   for (i = 0; i < 24; i++) {
+      mp_clear_multi(&a[i], &b[i], &c[i], &d[i], NULL);
+   }
+   return EXIT_SUCCESS;
+LBL_ERR:
+   for (i = 0; i < 24; i++) {
+      mp_clear_multi(&a[i], &b[i], &c[i], &d[i], NULL);
+   }
+   return EXIT_FAILURE;
+}
+
 static int test_mp_prime_is_prime(void)
 {
    int ix;
@@ -1413,6 +2260,224 @@ LBL_ERR:
    return EXIT_FAILURE;
 }
 
+static int test_s_mp_add_sub_digs(void)
+{
+   static const int sizes[] = { 1, 2, 63, 64, 65, 129, 300 };
+   mp_int p, m, x, y, z;
+   int i, n;
+
+   DOR(mp_init_multi(&p, &m, &x, &y, &z, NULL));
+
+   for (i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+      n = sizes[i];
+
+      /* p = B^n, m = B^n - 1 has all digits set */
+      DO(mp_2expt(&p, n * MP_DIGIT_BIT));
+      DO(mp_sub_d(&p, 1u, &m));
+
+      /* x + (m - x) has no carries */
+      DO(mp_rand(&x, n));
+      DO(mp_sub(&m, &x, &y));
+      DO(mp_add(&x, &y, &z));
+      EXPECT(mp_cmp(&z, &m) == MP_EQ);
+
+      /* x + (m - x + 1) carries through all digits */
+      DO(mp_incr(&y));
+      DO(mp_add(&x, &y, &z));
+      EXPECT(mp_cmp(&z, &p) == MP_EQ);
+      DO(mp_add(&y, &x, &y));
+      EXPECT(mp_cmp(&y, &p) == MP_EQ);
+
+      /* p - (m - x + 1) borrows through all digits */
+      DO(mp_sub(&m, &x, &y));
+      DO(mp_incr(&y));
+      DO(mp_sub(&p, &y, &z));
+      EXPECT(mp_cmp(&z, &x) == MP_EQ);
+      DO(mp_sub(&p, &y, &y));
+      EXPECT(mp_cmp(&y, &x) == MP_EQ);
+
+      /* single digit carries and borrows */
+      DO(mp_add_d(&m, 1u, &z));
+      EXPECT(mp_cmp(&z, &p) == MP_EQ);
+      DO(mp_sub_d(&p, 1u, &z));
+      EXPECT(mp_cmp(&z, &m) == MP_EQ);
+      DO(mp_add_d(&x, 1u, &z));
+      DO(mp_sub_d(&z, 1u, &z));
+      EXPECT(mp_cmp(&z, &x) == MP_EQ);
+   }
+
+   mp_clear_multi(&p, &m, &x, &y, &z, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   mp_clear_multi(&p, &m, &x, &y, &z, NULL);
+   return EXIT_FAILURE;
+}
+
+static int test_mp_mul_div_2d(void)
+{
+   mp_int a, b, c, p, q, r;
+   int i, bits;
+
+   DOR(mp_init_multi(&a, &b, &c, &p, &q, &r, NULL));
+
+   for (i = 0; i < 200; i++) {
+      DO(mp_rand(&a, 1 + (abs(rand_int()) % 20)));
+      if ((i & 1) == 1) {
+         DO(mp_neg(&a, &a));
+      }
+      bits = abs(rand_int()) % (25 * MP_DIGIT_BIT);
+      DO(mp_2expt(&p, bits));
+
+      DO(mp_mul(&a, &p, &c));
+      DO(mp_mul_2d(&a, bits, &b));
+      EXPECT(mp_cmp(&b, &c) == MP_EQ);
+      DO(mp_copy(&a, &b));
+      DO(mp_mul_2d(&b, bits, &b));
+      EXPECT(mp_cmp(&b, &c) == MP_EQ);
+
+      /* the quotient is truncated and the remainder has the sign of a */
+      DO(mp_div(&a, &p, &q, &r));
+      DO(mp_div_2d(&a, bits, &b, &c));
+      EXPECT(mp_cmp(&b, &q) == MP_EQ);
+      EXPECT(mp_cmp(&c, &r) == MP_EQ);
+      DO(mp_copy(&a, &b));
+      DO(mp_div_2d(&b, bits, &b, NULL));
+      EXPECT(mp_cmp(&b, &q) == MP_EQ);
+      DO(mp_copy(&a, &c));
+      DO(mp_div_2d(&c, bits, &b, &c));
+      EXPECT(mp_cmp(&b, &q) == MP_EQ);
+      EXPECT(mp_cmp(&c, &r) == MP_EQ);
+   }
+
+   mp_clear_multi(&a, &b, &c, &p, &q, &r, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   mp_clear_multi(&a, &b, &c, &p, &q, &r, NULL);
+   return EXIT_FAILURE;
+}
+
+static mp_err digs_to_int(const mp_digit *d, int n, mp_int *a)
+{
+   mp_err err;
+   if ((err = mp_grow(a, n)) != MP_OKAY) {
+      return err;
+   }
+   mp_zero(a);
+   s_mp_copy_digs(a->dp, d, n);
+   a->used = n;
+   mp_clamp(a);
+   return MP_OKAY;
+}
+
+static int test_mpl(void)
+{
+   static const int sizes[] = { 1, 2, 17, 130 };
+   static mp_digit r[(2 * 130) + 1];
+   mp_int a, b, c, m, p, z;
+   mp_digit d, u, rho;
+   int i, n, k, bits;
+
+   DOR(mp_init_multi(&a, &b, &c, &m, &p, &z, NULL));
+
+   for (i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+      n = sizes[i];
+      k = sizes[(i + 1) % (int)(sizeof(sizes) / sizeof(sizes[0]))];
+      DO(mp_rand(&a, n));
+      DO(mp_rand(&b, n));
+      DO(mp_2expt(&p, n * MP_DIGIT_BIT));
+      d = (mp_digit)rand_long() & MP_MASK;
+
+      /* add_n, sub_n with the borrow worth B^n */
+      r[n] = mpl_add_n(a.dp, b.dp, r, n);
+      DO(digs_to_int(r, n + 1, &z));
+      DO(mp_add(&a, &b, &c));
+      EXPECT(mp_cmp(&z, &c) == MP_EQ);
+      u = mpl_sub_n(a.dp, b.dp, r, n);
+      EXPECT(u == ((mp_cmp(&a, &b) == MP_LT) ? 1u : 0u));
+      DO(digs_to_int(r, n, &z));
+      DO(mp_add(&a, &p, &c));
+      DO(mp_sub(&c, &b, &c));
+      DO(mp_mod_2d(&c, n * MP_DIGIT_BIT, &c));
+      EXPECT(mp_cmp(&z, &c) == MP_EQ);
+
+      /* mul_1, addmul_1, submul_1 */
+      r[n] = mpl_mul_1(a.dp, n, d, r);
+      DO(digs_to_int(r, n + 1, &z));
+      DO(mp_mul_d(&a, d, &c));
+      EXPECT(mp_cmp(&z, &c) == MP_EQ);
+      s_mp_copy_digs(r, b.dp, n);
+      r[n] = mpl_addmul_1(a.dp, n, d, r);
+      DO(digs_to_int(r, n + 1, &z));
+      DO(mp_add(&c, &b, &c));
+      EXPECT(mp_cmp(&z, &c) == MP_EQ);
+      s_mp_copy_digs(r, b.dp, n);
+      u = mpl_submul_1(a.dp, n, d, r);
+      DO(digs_to_int(r, n, &z));
+      DO(mp_mul_d(&a, d, &c));
+      DO(mp_sub(&b, &c, &c));
+      DO(mp_mul_d(&p, u, &m));
+      DO(mp_add(&c, &m, &c));
+      EXPECT(mp_cmp(&z, &c) == MP_EQ);
+
+      /* mul_basecase, sqr_basecase */
+      DO(mp_rand(&b, k));
+      mpl_mul_basecase(a.dp, n, b.dp, k, r);
+      DO(digs_to_int(r, n + k, &z));
+      DO(mp_mul(&a, &b, &c));
+      EXPECT(mp_cmp(&z, &c) == MP_EQ);
+      mpl_sqr_basecase(a.dp, n, r);
+      DO(digs_to_int(r, 2 * n, &z));
+      DO(mp_sqr(&a, &c));
+      EXPECT(mp_cmp(&z, &c) == MP_EQ);
+
+      /* divrem_1 in place */
+      d |= 1u;
+      s_mp_copy_digs(r, a.dp, n);
+      u = mpl_divrem_1(r, n, d, r);
+      DO(digs_to_int(r, n, &z));
+      DO(mp_div_d(&a, d, &c, &d));
+      EXPECT(mp_cmp(&z, &c) == MP_EQ);
+      EXPECT(u == d);
+
+      /* lshift, rshift */
+      bits = 1 + (abs(rand_int()) % (MP_DIGIT_BIT - 1));
+      r[n] = mpl_lshift(a.dp, n, bits, r);
+      DO(digs_to_int(r, n + 1, &z));
+      DO(mp_mul_2d(&a, bits, &c));
+      EXPECT(mp_cmp(&z, &c) == MP_EQ);
+      u = mpl_rshift(a.dp, n, bits, r);
+      DO(digs_to_int(r, n, &z));
+      DO(mp_div_2d(&a, bits, &c, &m));
+      EXPECT(mp_cmp(&z, &c) == MP_EQ);
+      EXPECT(mp_cmp_d(&m, u) == MP_EQ);
+
+      /* redc_1 in place against mp_montgomery_reduce, x < m * B^n */
+      DO(mp_rand(&m, n));
+      m.dp[0] |= 1u;
+      DO(mp_montgomery_setup(&m, &rho));
+      DO(mp_mul(&m, &p, &c));
+      DO(mp_rand(&z, 2 * n));
+      DO(mp_mod(&z, &c, &z));
+      s_mp_zero_digs(r, 2 * n);
+      s_mp_copy_digs(r, z.dp, z.used);
+      u = mpl_redc_1(r, m.dp, n, rho, r);
+      DO(mp_montgomery_reduce(&z, &m, rho));
+      DO(digs_to_int(r, n, &c));
+      DO(mp_mul_d(&p, u, &b));
+      DO(mp_add(&c, &b, &c));
+      if (mp_cmp(&c, &m) != MP_LT) {
+         DO(mp_sub(&c, &m, &c));
+      }
+      EXPECT(mp_cmp(&z, &c) == MP_EQ);
+   }
+
+   mp_clear_multi(&a, &b, &c, &m, &p, &z, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   mp_clear_multi(&a, &b, &c, &m, &p, &z, NULL);
+   return EXIT_FAILURE;
+}
+
 static int test_mp_decr(void)
 {
    mp_int a, b;
@@ -1760,7 +2825,7 @@ static int test_s_mp_mul_toom(void)
    int size;
 
 #if (MP_DIGIT_BIT == 60)
-   int tc_cutoff;
+   mp_cutoffs no_toom;
 #endif
 
    DOR(mp_init_multi(&a, &b, &c, &d, NULL));
@@ -1775,12 +2840,14 @@ static int test_s_mp_mul_toom(void)
    DO(mp_2expt(&c, 99000 - 1000));
    DO(mp_add(&b, &c, &b));
 
-   tc_cutoff = MP_MUL_TOOM_CUTOFF;
-   MP_MUL_TOOM_CUTOFF = INT_MAX;
-   DO(mp_mul(&a, &b, &c));
-   MP_MUL_TOOM_CUTOFF = tc_cutoff;
-   DO(mp_mul(&a, &b, &d));
-   EXPECT(mp_cmp(&c, &d) == MP_EQ);
+   mp_cutoffs_get(&no_toom);
+   no_toom.mul_toom = INT_MAX;
+   if (mp_cutoffs_set_thread(&no_toom) == MP_OKAY) {
+      DO(mp_mul(&a, &b, &c));
+      DO(mp_cutoffs_set_thread(NULL));
+      DO(mp_mul(&a, &b, &d));
+      EXPECT(mp_cmp(&c, &d) == MP_EQ);
+   }
 #endif
 
    for (size = MP_MUL_TOOM_CUTOFF; size < (MP_MUL_TOOM_CUTOFF + 20); size++) {
@@ -1819,6 +2886,206 @@ LBL_ERR:
 }
 
 
+static int test_mp_cutoffs_set_thread(void)
+{
+   mp_cutoffs dflt, low, bad, cur;
+   mp_stats st;
+   mp_int a, b, c, d, e, q, r;
+   int size;
+
+   mp_cutoffs_get(&dflt);
+   if (mp_cutoffs_set_thread(NULL) != MP_OKAY) {
+      /* fixed cutoffs or no thread local storage */
+      return EXIT_SUCCESS;
+   }
+
+   /* Karatsuba, Toom-Cook, the baseline, the recursive division and the largest window forced */
+   low = dflt;
+   low.mul_karatsuba = low.sqr_karatsuba = 8;
+   low.mul_toom = low.sqr_toom = 16;
+   low.mul_comba = low.sqr_comba = 0;
+   low.div_recursive = 16;
+   low.exptmod_win3 = low.exptmod_win4 = low.exptmod_win5 = 0;
+   low.exptmod_win6 = low.exptmod_win7 = low.exptmod_win8 = 0;
+
+   DOR(mp_init_multi(&a, &b, &c, &d, &e, &q, &r, NULL));
+   bad = low;
+   bad.sqr_toom = 2;
+   EXPECT(mp_cutoffs_set_thread(&bad) == MP_VAL);
+   bad = low;
+   bad.mul_balance = 1;
+   EXPECT(mp_cutoffs_set_thread(&bad) == MP_VAL);
+   bad = low;
+   bad.exptmod_win5 = 100;
+   EXPECT(mp_cutoffs_set_thread(&bad) == MP_VAL);
+   mp_cutoffs_get(&cur);
+   EXPECT(cur.sqr_toom == dflt.sqr_toom);
+
+   for (size = 20; size < 200; size += 23) {
+      DO(mp_rand(&a, size));
+      DO(mp_rand(&b, size - 3));
+      DO(mp_rand(&e, 2));
+      DO(mp_mul(&a, &b, &c));
+      DO(mp_sqr(&a, &d));
+      DO(mp_div(&d, &b, &q, NULL));
+      DO(mp_exptmod(&a, &e, &b, &r));
+
+      /* the same results with the low cutoffs */
+      DO(mp_cutoffs_set_thread(&low));
+      DO(mp_exptmod(&a, &e, &b, &e));
+      EXPECT(mp_cmp(&e, &r) == MP_EQ);
+      DO(mp_div(&d, &b, &r, NULL));
+      EXPECT(mp_cmp(&r, &q) == MP_EQ);
+      DO(mp_mul(&a, &b, &b));
+      EXPECT(mp_cmp(&b, &c) == MP_EQ);
+      DO(mp_sqr(&a, &a));
+      EXPECT(mp_cmp(&a, &d) == MP_EQ);
+      DO(mp_cutoffs_set_thread(NULL));
+   }
+
+   /* the global cutoffs are left alone */
+   DO(mp_cutoffs_set_thread(&low));
+   mp_cutoffs_get(&cur);
+   EXPECT((cur.mul_karatsuba == 8) && (cur.sqr_toom == 16) && (cur.div_recursive == 16));
+#ifndef MP_FIXED_CUTOFFS
+   EXPECT(MP_MUL_KARATSUBA_CUTOFF == dflt.mul_karatsuba);
+   EXPECT(MP_SQR_TOOM_CUTOFF == dflt.sqr_toom);
+   EXPECT(MP_DIV_RECURSIVE_CUTOFF == dflt.div_recursive);
+#endif
+   DO(mp_cutoffs_set_thread(NULL));
+   mp_cutoffs_get(&cur);
+   EXPECT((cur.mul_toom == dflt.mul_toom) && (cur.exptmod_win8 == dflt.exptmod_win8));
+
+   /* the baseline instead of Comba */
+   low = dflt;
+   low.mul_comba = low.sqr_comba = 0;
+   for (size = 1; size < 60; size += 7) {
+      DO(mp_rand(&a, size));
+      DO(mp_rand(&b, size + 3));
+      DO(mp_mul(&a, &b, &c));
+      DO(mp_cutoffs_set_thread(&low));
+      mp_stats_reset();
+      DO(mp_mul(&a, &b, &d));
+      if (mp_stats_snapshot(&st) == MP_OKAY) {
+         EXPECT((st.calls[MP_STATS_MUL_BASECASE] == 1u) && (st.calls[MP_STATS_MUL_COMBA] == 0u));
+      }
+      DO(mp_cutoffs_set_thread(NULL));
+      EXPECT(mp_cmp(&c, &d) == MP_EQ);
+   }
+   /* zero with the baseline squaring */
+   mp_zero(&a);
+   DO(mp_cutoffs_set_thread(&low));
+   DO(mp_sqr(&a, &d));
+   DO(mp_cutoffs_set_thread(NULL));
+   EXPECT(mp_iszero(&d));
+
+   mp_clear_multi(&a, &b, &c, &d, &e, &q, &r, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   mp_clear_multi(&a, &b, &c, &d, &e, &q, &r, NULL);
+   return EXIT_FAILURE;
+}
+
+static int s_write_cutoffs(const char *path, const char *text)
+{
+   FILE *tmp = fopen(path, "w");
+   if (tmp == NULL) {
+      return 0;
+   }
+   fputs(text, tmp);
+   return (fclose(tmp) == 0) ? 1 : 0;
+}
+
+static int test_mp_cutoffs_load_save(void)
+{
+   const char *path = "test_cutoffs.tmp", *saved = "test_cutoffs_saved.tmp";
+   static const char *const bad[] = {
+      "MUL_KARATSUBA_CUTOFF = 2\n",
+      "NO_SUCH_CUTOFF = 100\n",
+      "MUL_TOOM_CUTOFF = -100\n",
+      "MUL_TOOM_CUTOFF = 99999999999\n",
+      "MUL_TOOM_CUTOFF 100\n",
+      "MUL_TOOM_CUTOFF = 100 200\n",
+      "EXPTMOD_WIN4_CUTOFF = 0\n"
+   };
+   mp_cutoffs dflt, cur;
+   mp_int a, b, c, d;
+   size_t i;
+
+   DOR(mp_init_multi(&a, &b, &c, &d, NULL));
+   mp_cutoffs_get(&dflt);
+   DO(mp_cutoffs_save(saved));
+   if (mp_cutoffs_load(saved) != MP_OKAY) {
+      /* fixed cutoffs */
+      EXPECT(mp_cutoffs_autotune() == MP_ERR);
+      remove(saved);
+      mp_clear_multi(&a, &b, &c, &d, NULL);
+      return EXIT_SUCCESS;
+   }
+   mp_cutoffs_get(&cur);
+   EXPECT(memcmp(&cur, &dflt, sizeof(cur)) == 0);
+   EXPECT(mp_cutoffs_load("test_cutoffs_missing.tmp") == MP_ERR);
+
+   /* comments, blanks and the cutoffs which are not listed are kept */
+   EXPECT(s_write_cutoffs(path, "# tuned\n\n  MUL_KARATSUBA_CUTOFF = 77\nSQR_TOOM_CUTOFF=300 \r\n"));
+   DO(mp_cutoffs_load(path));
+   mp_cutoffs_get(&cur);
+   EXPECT((cur.mul_karatsuba == 77) && (cur.sqr_toom == 300));
+   EXPECT((cur.mul_toom == dflt.mul_toom) && (cur.exptmod_win8 == dflt.exptmod_win8));
+#ifndef MP_FIXED_CUTOFFS
+   EXPECT(MP_MUL_KARATSUBA_CUTOFF == 77);
+#endif
+
+   /* a bad file changes nothing */
+   for (i = 0; i < (sizeof(bad) / sizeof(bad[0])); ++i) {
+      EXPECT(s_write_cutoffs(path, bad[i]));
+      EXPECT(mp_cutoffs_load(path) == MP_VAL);
+      mp_cutoffs_get(&cur);
+      EXPECT((cur.mul_karatsuba == 77) && (cur.mul_toom == dflt.mul_toom));
+   }
+   /* a NUL at the start and in the middle of a line */
+   for (i = 0; i < 2u; ++i) {
+      static const char lead[] = "\0MUL_TOOM_CUTOFF = 100\n", mid[] = "MUL_TOOM_CUTOFF = 1\0" "00\n";
+      FILE *tmp = fopen(path, "wb");
+      EXPECT(tmp != NULL);
+      if (i == 0u) {
+         EXPECT(fwrite(lead, 1u, sizeof(lead) - 1u, tmp) == (sizeof(lead) - 1u));
+      } else {
+         EXPECT(fwrite(mid, 1u, sizeof(mid) - 1u, tmp) == (sizeof(mid) - 1u));
+      }
+      fclose(tmp);
+      EXPECT(mp_cutoffs_load(path) == MP_VAL);
+      mp_cutoffs_get(&cur);
+      EXPECT(cur.mul_toom == dflt.mul_toom);
+   }
+
+   DO(mp_cutoffs_load(saved));
+   mp_cutoffs_get(&cur);
+   EXPECT(memcmp(&cur, &dflt, sizeof(cur)) == 0);
+
+   /* the measured cutoffs are valid and give the same results */
+   DO(mp_rand(&a, 300));
+   DO(mp_rand(&b, 250));
+   DO(mp_mul(&a, &b, &c));
+   DO(mp_cutoffs_autotune());
+   mp_cutoffs_get(&cur);
+   DO(s_mp_cutoffs_check(&cur));
+   DO(mp_mul(&a, &b, &d));
+   EXPECT(mp_cmp(&c, &d) == MP_EQ);
+   DO(mp_cutoffs_load(saved));
+
+   remove(path);
+   remove(saved);
+   mp_clear_multi(&a, &b, &c, &d, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   remove(path);
+   remove(saved);
+   mp_clear_multi(&a, &b, &c, &d, NULL);
+   return EXIT_FAILURE;
+}
+
+
 static int test_mp_radix_size(void)
 {
    mp_int a;
@@ -1862,6 +3129,60 @@ LBL_ERR:
 #define PRINTERR_V(...)
 
 /* Some larger values to test the fast division algorithm */
+static int test_mp_mod_multi(void)
+{
+   mp_int a, r, m[300], res[300];
+   size_t i, n;
+   int k;
+
+   DOR(mp_init_multi(&a, &r, NULL));
+   for (i = 0u; i < 300u; i++) {
+      DOR(mp_init_multi(&m[i], &res[i], NULL));
+   }
+   for (i = 0u; i < 300u; i++) {
+      DO(mp_rand(&m[i], 1 + (abs(rand_int()) % 4)));
+      if ((i % 7u) == 3u) {
+         DO(mp_neg(&m[i], &m[i]));
+      }
+   }
+
+   for (k = 0; k < 6; k++) {
+      /* larger and smaller than the product of the moduli, of both signs */
+      DO(mp_rand(&a, (k < 3) ? 1000 : 20));
+      if ((k & 1) == 1) {
+         DO(mp_neg(&a, &a));
+      }
+      n = (k < 2) ? 300u : (size_t)(abs(rand_int()) % 300);
+      DO(mp_mod_multi(&a, m, n, res));
+      for (i = 0u; i < n; i++) {
+         DO(mp_mod(&a, &m[i], &r));
+         EXPECT(mp_cmp(&r, &res[i]) == MP_EQ);
+      }
+      DO(mp_mod_multi_stream(&a, m, n, res, (size_t)(1 + k * 9)));
+      for (i = 0u; i < n; i++) {
+         DO(mp_mod(&a, &m[i], &r));
+         EXPECT(mp_cmp(&r, &res[i]) == MP_EQ);
+      }
+   }
+
+   mp_zero(&m[120]);
+   EXPECT(mp_mod_multi(&a, m, 300u, res) == MP_VAL);
+   EXPECT(mp_mod_multi_stream(&a, m, 100u, res, 0u) == MP_VAL);
+   DO(mp_mod_multi(&a, m, 0u, res));
+
+   for (i = 0u; i < 300u; i++) {
+      mp_clear_multi(&m[i], &res[i], NULL);
+   }
+   mp_clear_multi(&a, &r, NULL);
+   return EXIT_SUCCESS;
+LBL_ERR:
+   for (i = 0u; i < 300u; i++) {
+      mp_clear_multi(&m[i], &res[i], NULL);
+   }
+   mp_clear_multi(&a, &r, NULL);
+   return EXIT_FAILURE;
+}
+
 static int test_s_mp_div_recursive(void)
 {
    mp_int a, b, c_q, c_r, d_q, d_r;
@@ -2143,25 +3464,41 @@ static int unit_tests(int argc, char **argv)
       T1(mp_cnt_lsb, MP_CNT_LSB),
       T1(mp_complement, MP_COMPLEMENT),
       T1(mp_decr, MP_SUB_D),
+      T2(s_mp_add_sub_digs, S_MP_ADD_DIGS, S_MP_SUB_DIGS),
+      T2(mp_mul_div_2d, MP_MUL_2D, MP_DIV_2D),
+      T2(mpl, MPL_ADD_N, MPL_REDC_1),
       T1(s_mp_div_3, S_MP_DIV_3),
       T1(mp_dr_reduce, MP_DR_REDUCE),
+      T2(mp_digit_cache, MP_DIGIT_CACHE_STATS_GET, MP_DIGIT_CACHE_FLUSH),
+      T2(mp_alloc_stats, MP_ALLOC_STATS_GET, MP_ALLOC_STATS_RESET),
+      T2(mp_stats, MP_STATS_SNAPSHOT, MP_STATS_RESET),
       T2(mp_pack_unpack,MP_PACK, MP_UNPACK),
       T2(mp_fread_fwrite, MP_FREAD, MP_FWRITE),
+      T2(mp_fwrite_limbs_mmap_load, MP_FWRITE_LIMBS, MP_MMAP_LOAD),
       T1(mp_get_u32, MP_GET_I32),
       T1(mp_get_u64, MP_GET_I64),
       T1(mp_get_ul, MP_GET_L),
       T1(mp_log_n, MP_LOG_N),
       T1(mp_incr, MP_ADD_D),
+#if defined(MP_INLINE_DIGITS)
+      T2(mp_inline_digits, MP_SHRINK, MP_COMPLEMENT),
+#endif
       T1(mp_invmod, MP_INVMOD),
       T1(mp_is_square, MP_IS_SQUARE),
       T1(mp_kronecker, MP_KRONECKER),
       T1(mp_montgomery_reduce, MP_MONTGOMERY_REDUCE),
       T1(mp_root_n, MP_ROOT_N),
       T1(mp_or, MP_OR),
+      T2(mp_batch, MP_BATCH_EXPTMOD, MP_BATCH_PRIME_IS_PRIME),
+#if defined(MP_RUNTIME_ALLOCATOR) && defined(MP_HAS_PTHREAD)
+      T1(s_mp_thread_atexit, S_MP_THREAD_ATEXIT),
+#endif
       T1(mp_prime_is_prime, MP_PRIME_IS_PRIME),
       T1(mp_prime_next_prime, MP_PRIME_NEXT_PRIME),
       T1(mp_prime_rand, MP_PRIME_RAND),
       T1(mp_rand, MP_RAND),
+      T1(s_mp_rand_chacha, S_MP_RAND_CHACHA),
+      T2(mp_rng, MP_RNG_BYTES, MP_RAND_RANGE),
       T1(mp_read_radix, MP_READ_RADIX),
       T1(mp_read_write_ubin, MP_TO_UBIN),
       T1(mp_read_write_sbin, MP_TO_SBIN),
@@ -2172,17 +3509,27 @@ static int unit_tests(int argc, char **argv)
 #if defined(MP_HAS_SET_DOUBLE)
       T1(mp_set_double, MP_SET_DOUBLE),
 #endif
+#if defined(MP_RUNTIME_ALLOCATOR)
+      T1(mp_set_allocator, MP_SET_ALLOCATOR),
+#endif
+#if defined(MP_THREAD_LOCAL)
+      T2(mp_mul_div_exptmod_scratch, MP_MUL_SCRATCH, MP_EXPTMOD_SCRATCH),
+#endif
+      T2(mp_scratch_reserve, MP_SCRATCH_RESERVE, S_MP_DIV_SCHOOL),
       T1(mp_signed_rsh, MP_SIGNED_RSH),
       T2(mp_sqrt, MP_SQRT, MP_ROOT_N),
       T1(mp_sqrtmod_prime, MP_SQRTMOD_PRIME),
       T1(mp_xor, MP_XOR),
+      T2(mp_mod_multi, MP_MOD_MULTI, MP_MOD_MULTI_STREAM),
       T2(s_mp_div_recursive, S_MP_DIV_RECURSIVE, S_MP_DIV_SCHOOL),
       T2(s_mp_div_small, S_MP_DIV_SMALL, S_MP_DIV_SCHOOL),
       T1(s_mp_mul_balance, S_MP_MUL_BALANCE),
       T1(s_mp_mul_karatsuba, S_MP_MUL_KARATSUBA),
       T1(s_mp_sqr_karatsuba, S_MP_SQR_KARATSUBA),
       T1(s_mp_mul_toom, S_MP_MUL_TOOM),
-      T1(s_mp_sqr_toom, S_MP_SQR_TOOM)
+      T1(s_mp_sqr_toom, S_MP_SQR_TOOM),
+      T2(mp_cutoffs_set_thread, MP_CUTOFFS_SET_THREAD, MP_CUTOFFS_GET),
+      T2(mp_cutoffs_load_save, MP_CUTOFFS_LOAD, MP_CUTOFFS_SAVE)
 #undef T2
 #undef T1
    };
@@ -0,0 +1,386 @@
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <type_traits>
+
+#include "tommath.hpp"
+#if __cplusplus >= 201402L
+#include "tommath_fixed.hpp"
+#endif
+
+using tommath::integer;
+
+#define EXPECT(a) do { if (!(a)) { fprintf(stderr, "%s, line %d: EXPECT(%s) failed\n", __func__, __LINE__, #a); return EXIT_FAILURE; } } while(0)
+
+static_assert(std::is_nothrow_move_constructible<integer>::value, "integer must move without throwing");
+static_assert(std::is_nothrow_move_assignable<integer>::value, "integer must move without throwing");
+
+static const mp_digit *digits(const integer &a)
+{
+   return a.get()->dp;
+}
+
+static int test_construct(void)
+{
+   integer a, b(-12345), c(18446744073709551615u), d("-123456789012345678901234567890"), e("ff", 16);
+
+   EXPECT(a.is_zero());
+   EXPECT(b.to_i64() == -12345);
+   EXPECT(c.to_u64() == 18446744073709551615u);
+   EXPECT(d.to_string() == "-123456789012345678901234567890");
+   EXPECT(e == 255);
+   EXPECT(integer(e.to_string(16), 16) == e);
+
+   try {
+      integer f("12x4", 10);
+      EXPECT(false);
+   } catch (const tommath::error &err) {
+      EXPECT(err.code() == MP_VAL);
+   }
+   return EXIT_SUCCESS;
+}
+
+static int test_copy(void)
+{
+   integer a("123456789012345678901234567890"), b(a), c;
+   const mp_digit *dp;
+
+   EXPECT(b == a);
+   EXPECT(digits(b) != digits(a));
+   ++b;
+   EXPECT(b != a);
+
+   /* copy assignment writes into the digits already allocated */
+   c.reserve(32);
+   dp = digits(c);
+   c = a;
+   EXPECT(c == a);
+   EXPECT(digits(c) == dp);
+   return EXIT_SUCCESS;
+}
+
+static int test_move(void)
+{
+   /* large enough to be on the heap with MP_INLINE_DIGITS */
+   integer a = (integer(1) << 1000) - 1, c, d(a);
+   const mp_digit *dp = digits(a);
+
+   /* construction steals the digits */
+   integer b(std::move(a));
+   EXPECT(digits(b) == dp);
+   EXPECT(b == d);
+
+   /* the moved from integer is zero and can be used again */
+   EXPECT(a.is_zero());
+   EXPECT(a.to_string() == "0");
+   a += 5;
+   EXPECT(a == 5);
+
+   /* assignment exchanges the digits */
+   c = std::move(b);
+   EXPECT(digits(c) == dp);
+   c = integer(7);
+   EXPECT(c == 7);
+
+   swap(a, c);
+   EXPECT((a == 7) && (c == 5));
+   return EXIT_SUCCESS;
+}
+
+static int test_reuse(void)
+{
+   integer a("987654321098765432109876543210"), b("123456789012345678901234567890"), r;
+   const mp_digit *dp;
+
+   /* compound assignments keep the digits if they are large enough */
+   r.reserve(64);
+   EXPECT(r.capacity() >= 64);
+   dp = digits(r);
+   r += a;
+   r *= b;
+   r -= a;
+   r <<= 100;
+   r >>= 50;
+   EXPECT(digits(r) == dp);
+
+   /* rvalue operands lend their digits to the result */
+   r = a;
+   dp = digits(r);
+   integer s = std::move(r) + b;
+   EXPECT(digits(s) == dp);
+   EXPECT(s == a + b);
+   dp = digits(s);
+   integer t = a - std::move(s);
+   EXPECT(digits(t) == dp);
+   EXPECT(t == -b);
+
+   /* nothing is lent by an operand which is read again */
+   integer u(7), v(7);
+   r = std::move(u) + u;
+   EXPECT(r == 14);
+   r = std::move(v) * v;
+   EXPECT(r == 49);
+   u = 7;
+   r = (std::move(u) + b) * u;
+   EXPECT(r == (b + 7) * 7);
+   v = 7;
+   r = (std::move(v) << 3) - v;
+   EXPECT(r == 49);
+   return EXIT_SUCCESS;
+}
+
+static int test_expr(void)
+{
+   integer a("987654321098765432109876543210"), b("123456789012345678901234567890"),
+           c("-5555555555555555555"), m("1000000000000000000000000000057"), r, s, x;
+   const mp_digit *dp;
+   mp_int t;
+
+   /* fused modular operations agree with the C interface */
+   if (mp_init(&t) != MP_OKAY) {
+      return EXIT_FAILURE;
+   }
+   if (mp_mulmod(a.get(), b.get(), m.get(), &t) != MP_OKAY) {
+      mp_clear(&t);
+      return EXIT_FAILURE;
+   }
+   r = (a * b) % m;
+   bool same = (mp_cmp(&t, r.get()) == MP_EQ);
+   mp_clear(&t);
+   EXPECT(same);
+   s = a * b;
+   EXPECT(r == s % m);
+   s = a * a;
+   EXPECT((a * a) % m == s % m);
+   s = a + c;
+   EXPECT((a + c) % m == s % m);
+   s = c - a;
+   EXPECT((c - a) % m == s % m);
+   EXPECT((a * b + c) % m == ((s = a * b) += c) % m);
+
+   /* the destination is an operand */
+   r = a;
+   r = b * r + r;
+   EXPECT(r == a * b + a);
+   r = a;
+   r = (c + b) * (r + b);
+   EXPECT(r == (c + b) * (a + b));
+   r = m;
+   r = (a * b) % r;
+   EXPECT(r == (a * b) % m);
+   r = a;
+   r = b - r;
+   EXPECT(r == -(a - b));
+   r = a;
+   r = (r << 7) + r;
+   EXPECT(r == a * 129);
+   x = c;
+   r = a;
+   r = r - std::move(x);
+   EXPECT(r == a - c);
+
+   /* no temporaries if the destination is large enough, the reductions
+    * are left out as the division brings its own digits
+    */
+   r.reserve(64);
+   dp = digits(r);
+   r = a * b + c;
+   EXPECT(r == ((s = a * b) += c));
+   r = a + (b << 100);
+   EXPECT(r == ((s = b) <<= 100) + a);
+   r = (a - b) * c >> 5;
+   EXPECT(digits(r) == dp);
+
+   /* expressions mixed with built in integers */
+   EXPECT(2 * a + 1 == a + a + 1);
+   EXPECT(a - 1 == -(1 - a));
+   return EXIT_SUCCESS;
+}
+
+static int test_arith(void)
+{
+   int i;
+   for (i = 0; i < 100; i++) {
+      integer a, b, q, r;
+      mp_int t;
+
+      if ((mp_rand(a.get(), 1 + (i % 10)) != MP_OKAY) || (mp_rand(b.get(), 1 + (i % 7)) != MP_OKAY)) {
+         return EXIT_FAILURE;
+      }
+      if ((i & 1) == 1) {
+         a = -a;
+      }
+
+      q = a / b;
+      r = a - (q * b);
+      EXPECT(q * b + r == a);
+      EXPECT(abs(r) < abs(b));
+      EXPECT(((a % b) - r) % b == 0);
+      EXPECT(((a << 37) >> 37) == a);
+      EXPECT((a >> 3) == ((a - (a & 7)) / 8));
+      EXPECT((~a) == -a - 1);
+      EXPECT(((a | b) ^ (a & b)) == (a ^ b));
+      EXPECT(gcd(a, b) * lcm(a, b) == abs(a * b));
+      EXPECT(sqrt(abs(a) * abs(a)) == abs(a));
+      EXPECT(pow(a, 3) == a * a * a);
+
+      /* against the C interface */
+      if (mp_init(&t) != MP_OKAY) {
+         return EXIT_FAILURE;
+      }
+      if (mp_mul(a.get(), b.get(), &t) != MP_OKAY) {
+         mp_clear(&t);
+         return EXIT_FAILURE;
+      }
+      bool same = (mp_cmp(&t, integer(a * b).get()) == MP_EQ);
+      mp_clear(&t);
+      EXPECT(same);
+   }
+
+   {
+      integer m("1000000007"), x(123456);
+      EXPECT(powmod(x, m - 2, m) == invmod(x, m));
+      EXPECT((invmod(x, m) * x) % m == 1);
+   }
+
+   try {
+      integer z = integer(1) / integer(0);
+      EXPECT(false);
+   } catch (const tommath::error &err) {
+      EXPECT(err.code() == MP_VAL);
+   }
+   return EXIT_SUCCESS;
+}
+
+#if __cplusplus >= 201402L
+using namespace tommath::literals;
+
+/* the field of P-256, evaluated at compile time */
+constexpr tommath::montgomery<256> p256(0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff_u256);
+static_assert(p256.from(p256.mul(p256.to(6u), p256.to(7u))) == tommath::fixed<256>(42u), "montgomery at compile time");
+static_assert(1'000'000_u128 * 1'000'000_u128 == 1000000000000_u128, "literals at compile time");
+
+static int random_below(integer &a, int bits)
+{
+   if (mp_rand(a.get(), (bits / MP_DIGIT_BIT) + 1) != MP_OKAY) {
+      return EXIT_FAILURE;
+   }
+   a = abs(a) % (integer(1) << bits);
+   return EXIT_SUCCESS;
+}
+
+template <int Bits>
+static int test_fixed_bits(void)
+{
+   typedef tommath::fixed<Bits> fixed;
+   const integer two_bits = integer(1) << Bits;
+   integer a, b, m;
+   int i;
+
+   for (i = 0; i < 50; i++) {
+      if ((random_below(a, Bits) != EXIT_SUCCESS) || (random_below(b, Bits) != EXIT_SUCCESS) ||
+          (random_below(m, Bits) != EXIT_SUCCESS)) {
+         return EXIT_FAILURE;
+      }
+      m |= 1;
+
+      const fixed fa(a), fb(b), fm(m);
+      EXPECT(fa.to_integer() == a);
+      EXPECT(fa.bits() == a.bits());
+      EXPECT((fa + fb).to_integer() == (a + b) % two_bits);
+      EXPECT((fa - fb).to_integer() == (a - b) % two_bits);
+      EXPECT((fa * fb).to_integer() == (a * b) % two_bits);
+      EXPECT(mul_wide(fa, fb).to_integer() == a * b);
+      EXPECT((fa < fb) == (a < b));
+
+      /* the view shares the digits */
+      mp_int v = fa.view();
+      EXPECT(v.dp == fa.data());
+      EXPECT(mp_cmp(&v, a.get()) == MP_EQ);
+
+      const tommath::montgomery<Bits> mont(fm);
+      const fixed x = mont.to(fa), y = mont.to(fb);
+      EXPECT(mont.from(x).to_integer() == a % m);
+      EXPECT(mont.from(mont.mul(x, y)).to_integer() == (a * b) % m);
+      EXPECT(mont.from(mont.sqr(x)).to_integer() == (a * a) % m);
+      EXPECT(mont.from(mont.add(x, y)).to_integer() == (a + b) % m);
+      EXPECT(mont.from(mont.sub(x, y)).to_integer() == (a - b) % m);
+      EXPECT(mont.from(mont.pow(x, fb)).to_integer() == powmod(a, b, m));
+   }
+   return EXIT_SUCCESS;
+}
+
+static int test_fixed(void)
+{
+   if ((test_fixed_bits<128>() != EXIT_SUCCESS) || (test_fixed_bits<192>() != EXIT_SUCCESS) ||
+       (test_fixed_bits<256>() != EXIT_SUCCESS) || (test_fixed_bits<521>() != EXIT_SUCCESS)) {
+      return EXIT_FAILURE;
+   }
+
+   EXPECT(tommath::fixed<256>::parse("123456789012345678901234567890").to_integer() ==
+          integer("123456789012345678901234567890"));
+   EXPECT(p256.modulus().to_integer() == integer("ffffffff00000001000000000000000000000000ffffffffffffffffffffffff", 16));
+   try {
+      (void)tommath::fixed<8>::parse("256");
+      EXPECT(false);
+   } catch (const tommath::error &err) {
+      EXPECT(err.code() == MP_VAL);
+   }
+   try {
+      tommath::fixed<64> f(integer(1) << 64);
+      EXPECT(false);
+   } catch (const tommath::error &err) {
+      EXPECT(err.code() == MP_VAL);
+   }
+   return EXIT_SUCCESS;
+}
+#endif
+
+static int test_stream(void)
+{
+   std::ostringstream os;
+   os << integer(-255) << ' ' << std::hex << integer(255);
+   EXPECT(os.str() == "-255 FF");
+   return EXIT_SUCCESS;
+}
+
+int main(void)
+{
+   static const struct {
+      const char *name;
+      int (*fn)(void);
+   } test[] = {
+#define T(n) { #n, test_##n }
+      T(construct),
+      T(copy),
+      T(move),
+      T(reuse),
+      T(expr),
+      T(arith),
+#if __cplusplus >= 201402L
+      T(fixed),
+#endif
+      T(stream)
+#undef T
+   };
+   unsigned long i, ok = 0, fail = 0;
+
+   for (i = 0; i < sizeof(test) / sizeof(test[0]); ++i) {
+      int res;
+      printf("TEST %s\n", test[i].name);
+      try {
+         res = test[i].fn();
+      } catch (const std::exception &e) {
+         fprintf(stderr, "%s: unexpected exception: %s\n", test[i].name, e.what());
+         res = EXIT_FAILURE;
+      }
+      if (res == EXIT_SUCCESS) {
+         ++ok;
+      } else {
+         ++fail;
+         printf("\n\n%s FAIL!\n\n", test[i].name);
+      }
+   }
+   printf("Tests OK/FAIL: %lu/%lu\n", ok, fail);
+   return (fail == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
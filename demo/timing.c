@@ -6,6 +6,8 @@
 
 #include <tommath.h>
 
+#include "perf_counters.h"
+
 #ifdef IOWNANATHLON
 #include <unistd.h>
 #define SLEEP sleep(4)
@@ -129,6 +131,85 @@ static int should_test(const char *test, int argc, char **argv)
    return 1;
 }
 
+/* hardware counters around the measurements, if timing was started with -p */
+static perf_counters pc;
+static int use_perf = 0;
+
+static void perf_begin(void)
+{
+   if (use_perf != 0) {
+      perf_counters_start(&pc);
+   }
+}
+
+static void perf_end(void)
+{
+   if (use_perf != 0) {
+      perf_counters_stop(&pc);
+   }
+}
+
+/* after PRINTLN, each measurement makes two calls per round */
+static void perf_print(unsigned rounds, int digits)
+{
+   if (use_perf != 0) {
+      printf("  ");
+      perf_counters_fprint(stdout, &pc, 2.0 * (double)rounds, (double)digits);
+      printf("\n");
+   }
+}
+
+/* dump the heap statistics if the library was built with MP_ALLOC_STATS */
+static void print_alloc_stats(void)
+{
+   static const char *const names[MP_ALLOC_OP_COUNT] = {
+      "none", "mul", "div", "exptmod", "invmod", "gcd", "sqrtmod", "prime", "to_radix"
+   };
+   mp_alloc_stats st;
+   int n;
+
+   if (mp_alloc_stats_get(&st) != MP_OKAY) {
+      return;
+   }
+   printf("\nHeap statistics, %lu bytes live\n", (unsigned long)st.live);
+   printf("%-10s %12s %12s %14s %12s\n", "op", "allocs", "frees", "bytes", "peak");
+   for (n = 0; n < (int)MP_ALLOC_OP_COUNT; ++n) {
+      printf("%-10s %12lu %12lu %14lu %12lu\n", names[n],
+             (unsigned long)st.op[n].allocs, (unsigned long)st.op[n].frees,
+             (unsigned long)st.op[n].bytes, (unsigned long)st.op[n].peak);
+   }
+}
+
+/* dump the dispatch statistics if the library was built with MP_STATS */
+static void print_dispatch_stats(void)
+{
+   static const char *const names[MP_STATS_PATH_COUNT] = {
+      "mul_basecase", "mul_comba", "mul_karatsuba", "mul_toom", "mul_balance",
+      "sqr_basecase", "sqr_comba", "sqr_karatsuba", "sqr_toom",
+      "exptmod_mont", "exptmod_dr", "exptmod_2k", "exptmod_2k_l", "exptmod_barrett",
+      "div_trivial", "div_recursive", "div_school", "div_small"
+   };
+   mp_stats st;
+   int n, k;
+
+   if (mp_stats_snapshot(&st) != MP_OKAY) {
+      return;
+   }
+   printf("\nDispatch statistics, calls by log2 of the operand size in digits\n");
+   for (n = 0; n < (int)MP_STATS_PATH_COUNT; ++n) {
+      if (st.calls[n] == 0u) {
+         continue;
+      }
+      printf("%-16s %12" PRIu64 " ", names[n], st.calls[n]);
+      for (k = 0; k < MP_STATS_BUCKETS; ++k) {
+         if (st.size[n][k] != 0u) {
+            printf(" %d:%" PRIu64, k, st.size[n][k]);
+         }
+      }
+      printf("\n");
+   }
+}
+
 int main(int argc, char **argv)
 {
    uint64_t tt, gg, CLK_PER_SEC;
@@ -140,6 +221,17 @@ int main(int argc, char **argv)
 #endif
    int n, cnt, ix, old_kara_m, old_kara_s, old_toom_m, old_toom_s;
    unsigned rr;
+   mp_rng rng;
+
+   if ((argc > 1) && (strcmp(argv[1], "-p") == 0)) {
+      if (perf_counters_open(&pc) != 0) {
+         use_perf = 1;
+      } else {
+         fprintf(stderr, "hardware counters are not available, timing only\n");
+      }
+      --argc;
+      ++argv;
+   }
 
    CHECK_OK(mp_init(&a));
    CHECK_OK(mp_init(&b));
@@ -148,7 +240,10 @@ int main(int argc, char **argv)
    CHECK_OK(mp_init(&e));
    CHECK_OK(mp_init(&f));
 
-   srand(LTM_TIMING_RAND_SEED);
+   /* a deterministic stream, such that runs get the same inputs */
+   mp_rng_init(&rng, (uint64_t)LTM_TIMING_RAND_SEED, 0u);
+   mp_alloc_stats_reset();
+   mp_stats_reset();
 
 
    CLK_PER_SEC = TIMFUNC();
@@ -174,6 +269,7 @@ int main(int argc, char **argv)
          cnt = mp_prime_rabin_miller_trials(mp_count_bits(&a));
          ix = -cnt;
          for (; cnt >= ix; cnt += ix) {
+            perf_begin();
             rr = 0u;
             tt = UINT64_MAX;
             do {
@@ -187,8 +283,10 @@ int main(int argc, char **argv)
                   return EXIT_FAILURE;
                }
             } while (++rr < 100u);
+            perf_end();
             PRINTLN("Prime-check\t%s(%2d) => %9" PRIu64 "/sec, %9" PRIu64 " cycles",
                     name, cnt, CLK_PER_SEC / tt, tt);
+            perf_print(rr, a.used);
          }
       }
    }
@@ -198,9 +296,10 @@ int main(int argc, char **argv)
       log = FOPEN("logs/add" MP_TIMING_VERSION ".log", "w");
       for (cnt = 8; cnt <= 128; cnt += 8) {
          SLEEP;
-         CHECK_OK(mp_rand(&a, cnt));
-         CHECK_OK(mp_rand(&b, cnt));
+         CHECK_OK(mp_rand_ex(&rng, &a, cnt));
+         CHECK_OK(mp_rand_ex(&rng, &b, cnt));
          DO8(mp_add(&a, &b, &c));
+         perf_begin();
          rr = 0u;
          tt = UINT64_MAX;
          do {
@@ -210,8 +309,10 @@ int main(int argc, char **argv)
             if (tt > gg)
                tt = gg;
          } while (++rr < 100000u);
+         perf_end();
          PRINTLN("Adding\t\t%4d-bit => %9" PRIu64 "/sec, %9" PRIu64 " cycles",
                  mp_count_bits(&a), CLK_PER_SEC / tt, tt);
+         perf_print(rr, a.used);
          FPRINTF(log, "%6d %9" PRIu64 "\n", cnt * MP_DIGIT_BIT, tt);
          FFLUSH(log);
       }
@@ -223,9 +324,10 @@ int main(int argc, char **argv)
       log = FOPEN("logs/sub" MP_TIMING_VERSION ".log", "w");
       for (cnt = 8; cnt <= 128; cnt += 8) {
          SLEEP;
-         CHECK_OK(mp_rand(&a, cnt));
-         CHECK_OK(mp_rand(&b, cnt));
+         CHECK_OK(mp_rand_ex(&rng, &a, cnt));
+         CHECK_OK(mp_rand_ex(&rng, &b, cnt));
          DO8(mp_sub(&a, &b, &c));
+         perf_begin();
          rr = 0u;
          tt = UINT64_MAX;
          do {
@@ -235,9 +337,11 @@ int main(int argc, char **argv)
             if (tt > gg)
                tt = gg;
          } while (++rr < 100000u);
+         perf_end();
 
          PRINTLN("Subtracting\t\t%4d-bit => %9" PRIu64 "/sec, %9" PRIu64 " cycles",
                  mp_count_bits(&a), CLK_PER_SEC / tt, tt);
+         perf_print(rr, a.used);
          FPRINTF(log, "%6d %9" PRIu64 "\n", cnt * MP_DIGIT_BIT, tt);
          FFLUSH(log);
       }
@@ -264,9 +368,10 @@ int main(int argc, char **argv)
                      "logs/mult_toom" MP_TIMING_VERSION ".log", "w");
          for (cnt = 4; cnt <= (10240 / MP_DIGIT_BIT); cnt += 2) {
             SLEEP;
-            CHECK_OK(mp_rand(&a, cnt));
-            CHECK_OK(mp_rand(&b, cnt));
+            CHECK_OK(mp_rand_ex(&rng, &a, cnt));
+            CHECK_OK(mp_rand_ex(&rng, &b, cnt));
             DO8(mp_mul(&a, &b, &c));
+            perf_begin();
             rr = 0u;
             tt = UINT64_MAX;
             do {
@@ -276,8 +381,10 @@ int main(int argc, char **argv)
                if (tt > gg)
                   tt = gg;
             } while (++rr < 100u);
+            perf_end();
             PRINTLN("Multiplying\t%4d-bit => %9" PRIu64 "/sec, %9" PRIu64 " cycles",
                     mp_count_bits(&a), CLK_PER_SEC / tt, tt);
+            perf_print(rr, a.used);
             FPRINTF(log, "%6d %9" PRIu64 "\n", mp_count_bits(&a), tt);
             FFLUSH(log);
          }
@@ -288,8 +395,9 @@ int main(int argc, char **argv)
                      "logs/sqr_toom" MP_TIMING_VERSION ".log", "w");
          for (cnt = 4; cnt <= (10240 / MP_DIGIT_BIT); cnt += 2) {
             SLEEP;
-            CHECK_OK(mp_rand(&a, cnt));
+            CHECK_OK(mp_rand_ex(&rng, &a, cnt));
             DO8(mp_sqr(&a, &b));
+            perf_begin();
             rr = 0u;
             tt = UINT64_MAX;
             do {
@@ -299,8 +407,10 @@ int main(int argc, char **argv)
                if (tt > gg)
                   tt = gg;
             } while (++rr < 100u);
+            perf_end();
             PRINTLN("Squaring\t%4d-bit => %9" PRIu64 "/sec, %9" PRIu64 " cycles",
                     mp_count_bits(&a), CLK_PER_SEC / tt, tt);
+            perf_print(rr, a.used);
             FPRINTF(log, "%6d %9" PRIu64 "\n", mp_count_bits(&a), tt);
             FFLUSH(log);
          }
@@ -360,6 +470,7 @@ int main(int argc, char **argv)
          CHECK_OK(mp_mod(&b, &c, &b));
          mp_set(&c, 3uL);
          DO8(mp_exptmod(&c, &b, &a, &d));
+         perf_begin();
          rr = 0u;
          tt = UINT64_MAX;
          do {
@@ -369,6 +480,7 @@ int main(int argc, char **argv)
             if (tt > gg)
                tt = gg;
          } while (++rr < 10u);
+         perf_end();
          CHECK_OK(mp_sub_d(&a, 1uL, &e));
          CHECK_OK(mp_sub(&e, &b, &b));
          CHECK_OK(mp_exptmod(&c, &b, &a, &e));  /* c^(p-1-b) mod a */
@@ -380,6 +492,7 @@ int main(int argc, char **argv)
          }
          PRINTLN("Exponentiating\t%4d-bit => %9" PRIu64 "/sec, %9" PRIu64 " cycles",
                  mp_count_bits(&a), CLK_PER_SEC / tt, tt);
+         perf_print(rr, a.used);
          FPRINTF((n < 3) ? logd : (n < 9) ? logc : (n < 16) ? logb : log,
                  "%6d %9" PRIu64 "\n", mp_count_bits(&a), tt);
       }
@@ -394,8 +507,8 @@ int main(int argc, char **argv)
       log = FOPEN("logs/invmod" MP_TIMING_VERSION ".log", "w");
       for (cnt = 4; cnt <= 32; cnt += 4) {
          SLEEP;
-         CHECK_OK(mp_rand(&a, cnt));
-         CHECK_OK(mp_rand(&b, cnt));
+         CHECK_OK(mp_rand_ex(&rng, &a, cnt));
+         CHECK_OK(mp_rand_ex(&rng, &b, cnt));
 
          do {
             CHECK_OK(mp_add_d(&b, 1uL, &b));
@@ -403,6 +516,7 @@ int main(int argc, char **argv)
          } while (mp_cmp_d(&c, 1uL) != MP_EQ);
 
          DO2(mp_invmod(&b, &a, &c));
+         perf_begin();
          rr = 0u;
          tt = UINT64_MAX;
          do {
@@ -412,6 +526,7 @@ int main(int argc, char **argv)
             if (tt > gg)
                tt = gg;
          } while (++rr < 1000u);
+         perf_end();
          CHECK_OK(mp_mulmod(&b, &c, &a, &d));
          if (mp_cmp_d(&d, 1uL) != MP_EQ) {
             printf("Failed to invert\n");
@@ -419,11 +534,18 @@ int main(int argc, char **argv)
          }
          PRINTLN("Inverting mod\t%4d-bit => %9" PRIu64 "/sec, %9" PRIu64 " cycles",
                  mp_count_bits(&a), CLK_PER_SEC / tt, tt);
+         perf_print(rr, a.used);
          FPRINTF(log, "%6d %9" PRIu64 "\n", cnt * MP_DIGIT_BIT, tt);
       }
       FCLOSE(log);
       printf("\n");
    }
 
+   print_alloc_stats();
+   print_dispatch_stats();
+   if (use_perf != 0) {
+      perf_counters_close(&pc);
+   }
+
    return 0;
 }
@@ -1,18 +1,22 @@
-/* Tune the Karatsuba parameters
+/* Tune the cutoffs of the library
  *
  * Tom St Denis, tstdenis82@gmail.com
  */
 #include "../tommath.h"
 #include "../tommath_private.h"
+#include <stdlib.h>
 #include <time.h>
 #include <inttypes.h>
 #include <errno.h>
 
+#include "../demo/perf_counters.h"
+
 /*
    Please take in mind that both multiplicands are of the same size. The balancing
    mechanism in mp_balance works well but has some overhead itself. You can test
    the behaviour of it with the option "-o" followed by a (small) positive number 'x'
-   to generate ratios of the form 1:x.
+   to generate ratios of the form 1:x. The ratio from which mp_mul balances the
+   multiplicands is a cutoff of its own.
 */
 
 static uint64_t s_timer_function(void);
@@ -20,6 +24,9 @@ static void s_timer_start(void);
 static uint64_t s_timer_stop(void);
 static uint64_t s_time_mul(int size);
 static uint64_t s_time_sqr(int size);
+static uint64_t s_time_balance(int ratio);
+static uint64_t s_time_div(int size);
+static uint64_t s_time_exptmod(int bits);
 static void s_usage(char *s);
 
 static uint64_t s_timer_function(void)
@@ -55,9 +62,26 @@ static uint64_t s_timer_stop(void)
 
 static int s_check_result;
 static int s_number_of_test_loops;
-static int s_stabilization_extra;
 static int s_offset = 1;
 
+/* the hardware counters of the last timing, with -P */
+static perf_counters s_perf;
+static int s_use_perf = 0;
+
+static void s_perf_start(void)
+{
+   if (s_use_perf == 1) {
+      perf_counters_start(&s_perf);
+   }
+}
+
+static void s_perf_stop(void)
+{
+   if (s_use_perf == 1) {
+      perf_counters_stop(&s_perf);
+   }
+}
+
 #define s_mp_mul_full(a, b, c) s_mp_mul(a, b, c, (a)->used + (b)->used + 1)
 static uint64_t s_time_mul(int size)
 {
@@ -80,6 +104,7 @@ static uint64_t s_time_mul(int size)
       goto LBL_ERR;
    }
 
+   s_perf_start();
    s_timer_start();
    for (x = 0; x < s_number_of_test_loops; x++) {
       if ((e = mp_mul(&a,&b,&c)) != MP_OKAY) {
@@ -100,6 +125,7 @@ static uint64_t s_time_mul(int size)
    }
 
    t1 = s_timer_stop();
+   s_perf_stop();
 LBL_ERR:
    mp_clear_multi(&a, &b, &c, &d, NULL);
    return t1;
@@ -122,6 +148,7 @@ static uint64_t s_time_sqr(int size)
       goto LBL_ERR;
    }
 
+   s_perf_start();
    s_timer_start();
    for (x = 0; x < s_number_of_test_loops; x++) {
       if ((e = mp_sqr(&a,&b)) != MP_OKAY) {
@@ -141,11 +168,182 @@ static uint64_t s_time_sqr(int size)
    }
 
    t1 = s_timer_stop();
+   s_perf_stop();
 LBL_ERR:
    mp_clear_multi(&a, &b, &c, NULL);
    return t1;
 }
 
+/* the smaller multiplicand at the Karatsuba cutoff, the larger one "ratio" times that */
+static uint64_t s_time_balance(int ratio)
+{
+   int x, size = MP_MUL_KARATSUBA_CUTOFF;
+   mp_err  e;
+   mp_int  a, b, c, d;
+   uint64_t t1;
+
+   if ((e = mp_init_multi(&a, &b, &c, &d, NULL)) != MP_OKAY) {
+      t1 = UINT64_MAX;
+      goto LBL_ERR;
+   }
+
+   if ((e = mp_rand(&a, size * ratio)) != MP_OKAY) {
+      t1 = UINT64_MAX;
+      goto LBL_ERR;
+   }
+   if ((e = mp_rand(&b, size)) != MP_OKAY) {
+      t1 = UINT64_MAX;
+      goto LBL_ERR;
+   }
+
+   s_perf_start();
+   s_timer_start();
+   for (x = 0; x < s_number_of_test_loops; x++) {
+      if ((e = mp_mul(&a,&b,&c)) != MP_OKAY) {
+         t1 = UINT64_MAX;
+         goto LBL_ERR;
+      }
+      if (s_check_result == 1) {
+         if ((e = s_mp_mul_full(&a,&b,&d)) != MP_OKAY) {
+            t1 = UINT64_MAX;
+            goto LBL_ERR;
+         }
+         if (mp_cmp(&c, &d) != MP_EQ) {
+            t1 = 0u;
+            goto LBL_ERR;
+         }
+      }
+   }
+
+   t1 = s_timer_stop();
+   s_perf_stop();
+LBL_ERR:
+   mp_clear_multi(&a, &b, &c, &d, NULL);
+   return t1;
+}
+
+/* division of 2*size by size digits */
+static uint64_t s_time_div(int size)
+{
+   int x;
+   mp_err  e;
+   mp_int  a, b, q, r;
+   uint64_t t1;
+
+   if ((e = mp_init_multi(&a, &b, &q, &r, NULL)) != MP_OKAY) {
+      t1 = UINT64_MAX;
+      goto LBL_ERR;
+   }
+
+   if ((e = mp_rand(&a, 2 * size)) != MP_OKAY) {
+      t1 = UINT64_MAX;
+      goto LBL_ERR;
+   }
+   if ((e = mp_rand(&b, size)) != MP_OKAY) {
+      t1 = UINT64_MAX;
+      goto LBL_ERR;
+   }
+
+   s_perf_start();
+   s_timer_start();
+   for (x = 0; x < s_number_of_test_loops; x++) {
+      if ((e = mp_div(&a,&b,&q,&r)) != MP_OKAY) {
+         t1 = UINT64_MAX;
+         goto LBL_ERR;
+      }
+      if (s_check_result == 1) {
+         if (((e = mp_mul(&q,&b,&q)) != MP_OKAY) ||
+             ((e = mp_add(&q,&r,&q)) != MP_OKAY)) {
+            t1 = UINT64_MAX;
+            goto LBL_ERR;
+         }
+         if ((mp_cmp(&q, &a) != MP_EQ) || (mp_cmp_mag(&r, &b) != MP_LT)) {
+            t1 = 0u;
+            goto LBL_ERR;
+         }
+      }
+   }
+
+   t1 = s_timer_stop();
+   s_perf_stop();
+LBL_ERR:
+   mp_clear_multi(&a, &b, &q, &r, NULL);
+   return t1;
+}
+
+/* the digits of the modulus of s_time_exptmod() */
+#define S_EXPTMOD_DIGITS 4
+
+/* binary exponentiation, the reference of s_time_exptmod() */
+static mp_err s_exptmod_ref(const mp_int *g, const mp_int *x, const mp_int *p, mp_int *y)
+{
+   int i;
+   mp_err e;
+
+   mp_set(y, 1u);
+   for (i = mp_count_bits(x) - 1; i >= 0; i--) {
+      if ((e = mp_sqrmod(y, p, y)) != MP_OKAY) {
+         return e;
+      }
+      if (((x->dp[i / MP_DIGIT_BIT] >> (i % MP_DIGIT_BIT)) & 1u) != 0u) {
+         if ((e = mp_mulmod(y, g, p, y)) != MP_OKAY) {
+            return e;
+         }
+      }
+   }
+   return MP_OKAY;
+}
+
+/* an exponent of "bits" bits to an odd modulus of S_EXPTMOD_DIGITS digits */
+static uint64_t s_time_exptmod(int bits)
+{
+   int x;
+   mp_err  e;
+   mp_int  g, k, p, y, z;
+   uint64_t t1;
+
+   if ((e = mp_init_multi(&g, &k, &p, &y, &z, NULL)) != MP_OKAY) {
+      t1 = UINT64_MAX;
+      goto LBL_ERR;
+   }
+
+   if (((e = mp_rand(&p, S_EXPTMOD_DIGITS)) != MP_OKAY) ||
+       ((e = mp_rand(&g, S_EXPTMOD_DIGITS - 1)) != MP_OKAY) ||
+       ((e = mp_rand(&k, (bits + MP_DIGIT_BIT - 1) / MP_DIGIT_BIT)) != MP_OKAY) ||
+       ((e = mp_mod_2d(&k, bits, &k)) != MP_OKAY) ||
+       ((e = mp_2expt(&y, bits - 1)) != MP_OKAY) ||
+       ((e = mp_or(&k, &y, &k)) != MP_OKAY)) {
+      t1 = UINT64_MAX;
+      goto LBL_ERR;
+   }
+   p.dp[0] |= 1u;
+
+   s_perf_start();
+   s_timer_start();
+   for (x = 0; x < s_number_of_test_loops; x++) {
+      if ((e = mp_exptmod(&g,&k,&p,&y)) != MP_OKAY) {
+         t1 = UINT64_MAX;
+         goto LBL_ERR;
+      }
+      if (s_check_result == 1) {
+         if ((e = s_exptmod_ref(&g,&k,&p,&z)) != MP_OKAY) {
+            t1 = UINT64_MAX;
+            goto LBL_ERR;
+         }
+         if (mp_cmp(&y, &z) != MP_EQ) {
+            t1 = 0u;
+            goto LBL_ERR;
+         }
+      }
+   }
+
+   t1 = s_timer_stop();
+   s_perf_stop();
+LBL_ERR:
+   mp_clear_multi(&g, &k, &p, &y, &z, NULL);
+   return t1;
+}
+
 struct tune_args {
    int testmode;
    int verbose;
@@ -156,43 +354,193 @@ struct tune_args {
    int increment_print;
 } args;
 
-static void s_run(const char *name, uint64_t (*op)(int size), int *cutoff)
+/*
+   All tunable cutoffs in the order in which they are measured, each with the
+   cutoffs measured before it in place. A cutoff "x" is measured by timing
+   "fn(x)" with the cutoff at INT_MAX and at "x".
+   INT_MAX is also the result if the algorithm is not faster up to "hi".
+*/
+static const struct {
+   const char *name;    /* of the macro without MP_ and _CUTOFF */
+   const char *what;
+   int *cutoff;
+   uint64_t (*fn)(int size);
+   int lo, hi;          /* the range searched, "hi" of 0 is the limit of "-M" */
+   int *after;          /* the search starts at this cutoff if it is higher than "lo" */
+   int *before;         /* and ends at this one if it is lower than "hi" */
+   int *needs;          /* skipped if this cutoff is INT_MAX */
+} s_tunables[] = {
+#define T_CUTOFF(n, w, f, l, h, a, b, r) { #n, w, &MP_##n##_CUTOFF, f, l, h, a, b, r }
+   T_CUTOFF(MUL_KARATSUBA, "Karatsuba multiplication", MP_HAS(S_MP_MUL_KARATSUBA) ? s_time_mul : NULL,
+            8, 0, NULL, NULL, NULL),
+   T_CUTOFF(SQR_KARATSUBA, "Karatsuba squaring", MP_HAS(S_MP_SQR_KARATSUBA) ? s_time_sqr : NULL,
+            8, 0, NULL, NULL, NULL),
+   T_CUTOFF(MUL_TOOM, "Toom-Cook 3-way multiplying", MP_HAS(S_MP_MUL_TOOM) ? s_time_mul : NULL,
+            8, 0, &MP_MUL_KARATSUBA_CUTOFF, NULL, NULL),
+   T_CUTOFF(SQR_TOOM, "Toom-Cook 3-way squaring", MP_HAS(S_MP_SQR_TOOM) ? s_time_sqr : NULL,
+            8, 0, &MP_SQR_KARATSUBA_CUTOFF, NULL, NULL),
+   /*
+      The Comba multipliers are limited to MP_MAX_COMBA digits by the size of
+      mp_word. Their cutoffs are where the baseline is faster below that and
+      below Karatsuba.
+    */
+   T_CUTOFF(MUL_COMBA, "Baseline multiplication", MP_HAS(S_MP_MUL_COMBA) ? s_time_mul : NULL,
+            8, MP_MIN(MP_MAX_COMBA, (MP_WARRAY / 2) - 1), NULL, &MP_MUL_KARATSUBA_CUTOFF, NULL),
+   T_CUTOFF(SQR_COMBA, "Baseline squaring", MP_HAS(S_MP_SQR_COMBA) ? s_time_sqr : NULL,
+            8, (MP_MAX_COMBA / 2) - 1, NULL, &MP_SQR_KARATSUBA_CUTOFF, NULL),
+   /* the ratio of the multiplicands, the smaller one at the Karatsuba cutoff */
+   T_CUTOFF(MUL_BALANCE, "Balancing ratio of the multiplicands", MP_HAS(S_MP_MUL_BALANCE) ? s_time_balance : NULL,
+            2, 16, NULL, NULL, &MP_MUL_KARATSUBA_CUTOFF),
+   T_CUTOFF(DIV_RECURSIVE, "Recursive division", MP_HAS(S_MP_DIV_RECURSIVE) ? s_time_div : NULL,
+            2 * MP_MIN_CUTOFF, 0, NULL, NULL, NULL),
+   /* bits of the exponent, a window is only measured if the next smaller one is used */
+   T_CUTOFF(EXPTMOD_WIN3, "Exptmod window of 3 bits", s_time_exptmod, 2, 1 << 14, NULL, NULL, NULL),
+   T_CUTOFF(EXPTMOD_WIN4, "Exptmod window of 4 bits", s_time_exptmod, 2, 1 << 14, &MP_EXPTMOD_WIN3_CUTOFF, NULL,
+            &MP_EXPTMOD_WIN3_CUTOFF),
+   T_CUTOFF(EXPTMOD_WIN5, "Exptmod window of 5 bits", s_time_exptmod, 2, 1 << 14, &MP_EXPTMOD_WIN4_CUTOFF, NULL,
+            &MP_EXPTMOD_WIN4_CUTOFF),
+#ifndef MP_LOW_MEM
+   T_CUTOFF(EXPTMOD_WIN6, "Exptmod window of 6 bits", s_time_exptmod, 2, 1 << 14, &MP_EXPTMOD_WIN5_CUTOFF, NULL,
+            &MP_EXPTMOD_WIN5_CUTOFF),
+   T_CUTOFF(EXPTMOD_WIN7, "Exptmod window of 7 bits", s_time_exptmod, 2, 1 << 14, &MP_EXPTMOD_WIN6_CUTOFF, NULL,
+            &MP_EXPTMOD_WIN6_CUTOFF),
+   T_CUTOFF(EXPTMOD_WIN8, "Exptmod window of 8 bits", s_time_exptmod, 2, 1 << 14, &MP_EXPTMOD_WIN7_CUTOFF, NULL,
+            &MP_EXPTMOD_WIN7_CUTOFF),
+#else
+   /* the window is limited to 5 bits */
+   T_CUTOFF(EXPTMOD_WIN6, "Exptmod window of 6 bits", NULL, 2, 1 << 14, NULL, NULL, NULL),
+   T_CUTOFF(EXPTMOD_WIN7, "Exptmod window of 7 bits", NULL, 2, 1 << 14, NULL, NULL, NULL),
+   T_CUTOFF(EXPTMOD_WIN8, "Exptmod window of 8 bits", NULL, 2, 1 << 14, NULL, NULL, NULL),
+#endif
+#undef T_CUTOFF
+};
+#define S_TUNABLES (int)(sizeof(s_tunables)/sizeof(s_tunables[0]))
+
+/* the number of timings of both variants, doubled up to S_MAX_SAMPLES while they differ less than the noise */
+#define S_MAX_SAMPLES 64
+static int s_samples;
+/* the operands of the n-th timing are drawn from s_seed + n */
+static uint64_t s_seed = 0xdeadbeefULL;
+
+static int s_cmp_i64(const void *a, const void *b)
 {
-   int x, count = 0;
-   uint64_t t1, t2;
+   int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+   return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+/* sorts "t" */
+static int64_t s_median(int64_t *t, int n)
+{
+   qsort(t, (size_t)n, sizeof(t[0]), s_cmp_i64);
+   return t[n / 2];
+}
+
+/* the median absolute deviation of "t" from its median "m" */
+static int64_t s_mad(const int64_t *t, int n, int64_t m)
+{
+   int64_t d[S_MAX_SAMPLES];
+   int i;
+   for (i = 0; i < n; i++) {
+      d[i] = (t[i] > m) ? (t[i] - m) : (m - t[i]);
+   }
+   return s_median(d, n);
+}
+
+static int64_t s_time_checked(const char *name, uint64_t (*op)(int size), int x, uint64_t seed)
+{
+   uint64_t t;
+   s_mp_rand_jenkins_init(seed);
+   t = op(x);
+   if ((t == 0u) || (t == UINT64_MAX)) {
+      fprintf(stderr,"%s failed at %d (%s)\n", name, x,
+              (t == 0u)?"wrong result":"internal error");
+      exit(EXIT_FAILURE);
+   }
+   return (int64_t)t;
+}
+
+/*
+   1 if "op(x)" is faster with "*cutoff" at "x" than at INT_MAX.
+
+   Both are timed on the same operands, the differences of these pairs are
+   compared to their median absolute deviation. The median difference needs to
+   be about three standard errors off zero, otherwise it is a tie.
+*/
+static int s_faster(const char *name, uint64_t (*op)(int size), int *cutoff, int x)
+{
+   int64_t t1[S_MAX_SAMPLES], t2[S_MAX_SAMPLES], d[S_MAX_SAMPLES], m, noise;
+   int n = 0, want = s_samples, distinct;
+   perf_counters p1;
+
+   for (;;) {
+      /* interleaved, such that a drift of the clock or the load hits both */
+      for (; n < want; n++) {
+         *cutoff = INT_MAX;
+         t1[n] = s_time_checked(name, op, x, s_seed + (uint64_t)n);
+         p1 = s_perf;
+         *cutoff = x;
+         t2[n] = s_time_checked(name, op, x, s_seed + (uint64_t)n);
+         d[n] = t1[n] - t2[n];
+      }
+      m = s_median(d, n);
+      noise = s_mad(d, n, m);
+      distinct = (((double)m * (double)m * (double)n) > (20.0 * (double)noise * (double)noise)) ? 1 : 0;
+      if ((distinct == 1) || ((2 * want) > S_MAX_SAMPLES)) {
+         break;
+      }
+      want *= 2;
+   }
+   *cutoff = INT_MAX;
+
+   if (args.verbose == 1) {
+      printf("%d: %9" PRIi64 " %9" PRIi64 ", %9" PRIi64 " (%d samples, noise %" PRIi64 ")\n",
+             x, s_median(t1, n), s_median(t2, n), -m, n, noise);
+      if (s_use_perf == 1) {
+         printf("   without: ");
+         perf_counters_fprint(stdout, &p1, (double)s_number_of_test_loops, (double)x);
+         printf("\n   with:    ");
+         perf_counters_fprint(stdout, &s_perf, (double)s_number_of_test_loops, (double)x);
+         printf("\n");
+      }
+   }
+   /* a tie is left to the algorithm used so far */
+   return ((distinct == 1) && (m > 0)) ? 1 : 0;
+}
+
+/*
+   The smallest "x" in [lo, hi] at which "op" is faster with the cutoff, or
+   INT_MAX. The size is doubled until it is faster, the crossover is then
+   bisected down to the increment of "-m" or 1/32 of the size, the timings
+   hardly differ around it anyway.
+*/
+static int s_crossover(const char *name, uint64_t (*op)(int size), int *cutoff, int lo, int hi)
+{
+   int x, below = lo - 1, mid;
+
    if ((args.verbose == 1) || (args.testmode == 1)) {
       printf("# %s.\n", name);
    }
-   for (x = 8; x < args.upper_limit_print; x += args.increment_print) {
-      *cutoff = INT_MAX;
-      t1 = op(x);
-      if ((t1 == 0u) || (t1 == UINT64_MAX)) {
-         fprintf(stderr,"%s failed at x = INT_MAX (%s)\n", name,
-                 (t1 == 0u)?"wrong result":"internal error");
-         exit(EXIT_FAILURE);
-      }
-      *cutoff = x;
-      t2 = op(x);
-      if ((t2 == 0u) || (t2 == UINT64_MAX)) {
-         fprintf(stderr,"%s failed (%s)\n", name,
-                 (t2 == 0u)?"wrong result":"internal error");
-         exit(EXIT_FAILURE);
+   if (hi < lo) {
+      return INT_MAX;
+   }
+   for (x = lo; ; x = (x > (hi / 2)) ? hi : (2 * x)) {
+      if (s_faster(name, op, cutoff, x) == 1) {
+         break;
       }
-      if (args.verbose == 1) {
-         printf("%d: %9" PRIu64 " %9" PRIu64 ", %9" PRIi64 "\n", x, t1, t2, (int64_t)t2 - (int64_t)t1);
+      if (x == hi) {
+         return INT_MAX;
       }
-      if (t2 < t1) {
-         if (count == s_stabilization_extra) {
-            count = 0;
-            break;
-         } else if (count < s_stabilization_extra) {
-            count++;
-         }
-      } else if (count > 0) {
-         count--;
+      below = x;
+   }
+   while ((x - below) > MP_MAX(args.increment_print, x / 32)) {
+      mid = below + ((x - below) / 2);
+      if (s_faster(name, op, cutoff, mid) == 1) {
+         x = mid;
+      } else {
+         below = mid;
       }
    }
-   *cutoff = x - s_stabilization_extra * args.increment_print;
+   return x;
 }
 
 static long s_strtol(const char *str, char **endptr, const char *err)
@@ -217,9 +565,12 @@ static long s_strtol(const char *str, char **endptr, const char *err)
 static int s_exit_code = EXIT_FAILURE;
 static void s_usage(char *s)
 {
-   fprintf(stderr,"Usage: %s [TvcpGbtrSLFfMmosh]\n",s);
+   int n;
+   fprintf(stderr,"Usage: %s [TvPcpGbtrSLFfMmosh]\n",s);
    fprintf(stderr,"          -T testmode, for use with testme.sh\n");
    fprintf(stderr,"          -v verbose, print all timings\n");
+   fprintf(stderr,"          -P with '-v' print the IPC and the cache misses per digit\n");
+   fprintf(stderr,"             of both timings from the hardware counters\n");
    fprintf(stderr,"          -c check results\n");
    fprintf(stderr,"          -p print benchmark of final cutoffs in files \"multiplying\"\n");
    fprintf(stderr,"             and \"squaring\"\n");
@@ -229,68 +580,70 @@ static void s_usage(char *s)
    fprintf(stderr,"          -t prints space (0x20) separated results\n");
    fprintf(stderr,"          -r [64] number of rounds\n");
    fprintf(stderr,"          -S [0xdeadbeef] seed for PRNG\n");
-   fprintf(stderr,"          -L [3] number of negative values accumulated until the result is accepted\n");
-   fprintf(stderr,"          -M [3000] upper limit of T-C tests/prints\n");
-   fprintf(stderr,"          -m [1] increment of T-C tests/prints\n");
+   fprintf(stderr,"          -L [5] number of timings of both variants at each size, doubled up to\n");
+   fprintf(stderr,"             %d while their medians differ less than the noise\n", S_MAX_SAMPLES);
+   fprintf(stderr,"          -M [3000] upper limit of the sizes in digits of the tests/prints\n");
+   fprintf(stderr,"          -m [1] precision of the cut-offs, increment of the prints\n");
    fprintf(stderr,"          -o [1] multiplier for the second multiplicand\n");
    fprintf(stderr,"             (Not for computing the cut-offs!)\n");
    fprintf(stderr,"          -s 'preset' use values in 'preset' for printing.\n");
-   fprintf(stderr,"             'preset' is a comma separated string with cut-offs for\n");
-   fprintf(stderr,"             ksm, kss, tc3m, tc3s in that order\n");
-   fprintf(stderr,"             ksm  = karatsuba multiplication\n");
-   fprintf(stderr,"             kss  = karatsuba squaring\n");
-   fprintf(stderr,"             tc3m = Toom-Cook 3-way multiplication\n");
-   fprintf(stderr,"             tc3s = Toom-Cook 3-way squaring\n");
+   fprintf(stderr,"             'preset' is a comma separated string with cut-offs\n");
+   fprintf(stderr,"             in the order of the output of '-t':\n");
+   for (n = 0; n < S_TUNABLES; n++) {
+      fprintf(stderr,"             %-14s = %s\n", s_tunables[n].name, s_tunables[n].what);
+   }
+   fprintf(stderr,"             Missing values at the end are left at their defaults.\n");
    fprintf(stderr,"             Implies '-p'\n");
    fprintf(stderr,"          -h this message\n");
    exit(s_exit_code);
 }
 
-struct cutoffs {
-   int MUL_KARATSUBA, SQR_KARATSUBA;
-   int MUL_TOOM, SQR_TOOM;
-};
-
-const struct cutoffs max_cutoffs =
-{ INT_MAX, INT_MAX, INT_MAX, INT_MAX };
-
-static void set_cutoffs(const struct cutoffs *c)
+static void set_cutoffs(const int *c)
 {
-   MP_MUL_KARATSUBA_CUTOFF = c->MUL_KARATSUBA;
-   MP_SQR_KARATSUBA_CUTOFF = c->SQR_KARATSUBA;
-   MP_MUL_TOOM_CUTOFF = c->MUL_TOOM;
-   MP_SQR_TOOM_CUTOFF = c->SQR_TOOM;
+   int n;
+   for (n = 0; n < S_TUNABLES; n++) {
+      *s_tunables[n].cutoff = c[n];
+   }
 }
 
-static void get_cutoffs(struct cutoffs *c)
+static void get_cutoffs(int *c)
 {
-   c->MUL_KARATSUBA  = MP_MUL_KARATSUBA_CUTOFF;
-   c->SQR_KARATSUBA  = MP_SQR_KARATSUBA_CUTOFF;
-   c->MUL_TOOM = MP_MUL_TOOM_CUTOFF;
-   c->SQR_TOOM = MP_SQR_TOOM_CUTOFF;
+   int n;
+   for (n = 0; n < S_TUNABLES; n++) {
+      c[n] = *s_tunables[n].cutoff;
+   }
+}
 
+static void print_cutoffs(const int *c)
+{
+   int n;
+   for (n = 0; n < S_TUNABLES; n++) {
+      if (args.terse == 1) {
+         printf("%d%c", c[n], (n == (S_TUNABLES - 1)) ? '\n' : ' ');
+      } else {
+         printf("%s_CUTOFF = %d\n", s_tunables[n].name, c[n]);
+      }
+   }
 }
 
 int main(int argc, char **argv)
 {
    uint64_t t1, t2;
-   int x, i, j;
-   size_t n;
+   int x, i, j, lo, hi;
+   int n;
 
    int printpreset = 0;
-   /*int preset[8];*/
    char *endptr, *str;
 
-   uint64_t seed = 0xdeadbeefULL;
-
    int opt;
-   struct cutoffs orig, updated;
+   int orig[S_TUNABLES], updated[S_TUNABLES], max_cutoffs[S_TUNABLES];
+   mp_cutoffs loaded;
 
    FILE *squaring, *multiplying;
    char mullog[256] = "multiplying";
    char sqrlog[256] = "squaring";
    s_number_of_test_loops = 64;
-   s_stabilization_extra = 3;
+   s_samples = 5;
 
    s_mp_zero_buf(&args, sizeof(args));
 
@@ -313,12 +666,19 @@ int main(int argc, char **argv)
             args.upper_limit_print = 1000;
             args.increment_print = 11;
             s_number_of_test_loops = 1;
-            s_stabilization_extra = 1;
+            s_samples = 1;
             s_offset = 1;
             break;
          case 'v':
             args.verbose = 1;
             break;
+         case 'P':
+            if (perf_counters_open(&s_perf) != 0) {
+               s_use_perf = 1;
+            } else {
+               fprintf(stderr, "Hardware counters are not available, timing only\n");
+            }
+            break;
          case 'c':
             s_check_result = 1;
             break;
@@ -368,14 +728,18 @@ int main(int argc, char **argv)
             }
             str = argv[opt];
             errno = 0;
-            seed = (uint64_t)s_strtol(argv[opt], NULL, "No seed given?\n");
+            s_seed = (uint64_t)s_strtol(argv[opt], NULL, "No seed given?\n");
             break;
          case 'L':
             opt++;
             if (opt >= argc) {
                s_usage(argv[0]);
             }
-            s_stabilization_extra = (int)s_strtol(argv[opt], NULL, "No value for option \"-L\"given");
+            s_samples = (int)s_strtol(argv[opt], NULL, "No value for option \"-L\"given");
+            if ((s_samples < 1) || (s_samples > S_MAX_SAMPLES)) {
+               fprintf(stderr, "The number of timings needs to be between 1 and %d\n", S_MAX_SAMPLES);
+               exit(EXIT_FAILURE);
+            }
             break;
          case 'o':
             opt++;
@@ -405,6 +769,10 @@ int main(int argc, char **argv)
                s_usage(argv[0]);
             }
             args.increment_print = (int)s_strtol(argv[opt], NULL, "No value for the increment for the T-C tests given");
+            if (args.increment_print < 1) {
+               fprintf(stderr, "The increment needs to be positive\n");
+               exit(EXIT_FAILURE);
+            }
             break;
          case 's':
             printpreset = 1;
@@ -414,13 +782,13 @@ int main(int argc, char **argv)
                s_usage(argv[0]);
             }
             str = argv[opt];
-            MP_MUL_KARATSUBA_CUTOFF = (int)s_strtol(str, &endptr, "[1/4] No value for MP_MUL_KARATSUBA_CUTOFF given");
-            str = endptr + 1;
-            MP_SQR_KARATSUBA_CUTOFF = (int)s_strtol(str, &endptr, "[2/4] No value for MP_SQR_KARATSUBA_CUTOFF given");
-            str = endptr + 1;
-            MP_MUL_TOOM_CUTOFF = (int)s_strtol(str, &endptr, "[3/4] No value for MP_MUL_TOOM_CUTOFF given");
-            str = endptr + 1;
-            MP_SQR_TOOM_CUTOFF = (int)s_strtol(str, &endptr, "[4/4] No value for MP_SQR_TOOM_CUTOFF given");
+            for (n = 0; n < S_TUNABLES; n++) {
+               *s_tunables[n].cutoff = (int)s_strtol(str, &endptr, "No value for a cutoff given");
+               if (*endptr != ',') {
+                  break;
+               }
+               str = endptr + 1;
+            }
             break;
          case 'h':
             s_exit_code = EXIT_SUCCESS;
@@ -436,53 +804,43 @@ int main(int argc, char **argv)
      source of the OS by default. That is too expensive, too slow and
      most important for a benchmark: it is not repeatable.
    */
-   s_mp_rand_jenkins_init(seed);
+   s_mp_rand_jenkins_init(s_seed);
    mp_rand_source(s_mp_rand_jenkins);
 
-   get_cutoffs(&orig);
+   /* the file of LTM_CUTOFFS, if enabled, is loaded at the first use of the cutoffs,
+      before they are measured, such that it cannot overwrite them
+   */
+   mp_cutoffs_get(&loaded);
+   get_cutoffs(orig);
 
-   updated = max_cutoffs;
+   for (n = 0; n < S_TUNABLES; n++) {
+      max_cutoffs[n] = INT_MAX;
+   }
+   for (n = 0; n < S_TUNABLES; n++) {
+      updated[n] = orig[n];
+   }
    if ((args.bncore == 0) && (printpreset == 0)) {
-      struct {
-         const char *name;
-         int *cutoff, *update;
-         uint64_t (*fn)(int size);
-      } test[] = {
-#define T_MUL_SQR(n, o, f)  { #n, &MP_##o##_CUTOFF, &(updated.o), MP_HAS(S_MP_##o) ? f : NULL }
-         /*
-            The influence of the Comba multiplication cannot be
-            eradicated programmatically. It depends on the size
-            of the macro MP_WPARRAY in tommath.h which needs to
-            be changed manually (to 0 (zero)).
-          */
-         T_MUL_SQR("Karatsuba multiplication", MUL_KARATSUBA, s_time_mul),
-         T_MUL_SQR("Karatsuba squaring", SQR_KARATSUBA, s_time_sqr),
-         T_MUL_SQR("Toom-Cook 3-way multiplying", MUL_TOOM, s_time_mul),
-         T_MUL_SQR("Toom-Cook 3-way squaring", SQR_TOOM, s_time_sqr),
-#undef T_MUL_SQR
-      };
-      /* Turn all limits from bncore.c to the max */
-      set_cutoffs(&max_cutoffs);
-      for (n = 0; n < sizeof(test)/sizeof(test[0]); ++n) {
-         if (test[n].fn != NULL) {
-            s_run(test[n].name, test[n].fn, test[n].cutoff);
-            *test[n].update = *test[n].cutoff;
-            *test[n].cutoff = INT_MAX;
+      /* Turn all limits to the max, each cutoff is in place once it is measured */
+      set_cutoffs(max_cutoffs);
+      for (n = 0; n < S_TUNABLES; n++) {
+         updated[n] = INT_MAX;
+         if ((s_tunables[n].fn == NULL) ||
+             ((s_tunables[n].needs != NULL) && (*s_tunables[n].needs == INT_MAX))) {
+            continue;
+         }
+         lo = s_tunables[n].lo;
+         if ((s_tunables[n].after != NULL) && (*s_tunables[n].after != INT_MAX)) {
+            lo = MP_MAX(lo, *s_tunables[n].after);
          }
+         hi = (s_tunables[n].hi != 0) ? s_tunables[n].hi : args.upper_limit_print;
+         if ((s_tunables[n].before != NULL) && (*s_tunables[n].before != INT_MAX)) {
+            hi = MP_MIN(hi, *s_tunables[n].before);
+         }
+         updated[n] = s_crossover(s_tunables[n].what, s_tunables[n].fn, s_tunables[n].cutoff, lo, hi);
+         *s_tunables[n].cutoff = updated[n];
       }
    }
-   if (args.terse == 1) {
-      printf("%d %d %d %d\n",
-             updated.MUL_KARATSUBA,
-             updated.SQR_KARATSUBA,
-             updated.MUL_TOOM,
-             updated.SQR_TOOM);
-   } else {
-      printf("MUL_KARATSUBA_CUTOFF = %d\n", updated.MUL_KARATSUBA);
-      printf("SQR_KARATSUBA_CUTOFF = %d\n", updated.SQR_KARATSUBA);
-      printf("MUL_TOOM_CUTOFF = %d\n", updated.MUL_TOOM);
-      printf("SQR_TOOM_CUTOFF = %d\n", updated.SQR_TOOM);
-   }
+   print_cutoffs(updated);
 
    if (args.print == 1) {
       printf("Printing data for graphing to \"%s\" and \"%s\"\n",mullog, sqrlog);
@@ -500,9 +858,9 @@ int main(int argc, char **argv)
       }
 
       for (x = 8; x < args.upper_limit_print; x += args.increment_print) {
-         set_cutoffs(&max_cutoffs);
+         set_cutoffs(max_cutoffs);
          t1 = s_time_mul(x);
-         set_cutoffs(&orig);
+         set_cutoffs(orig);
          t2 = s_time_mul(x);
          fprintf(multiplying, "%d: %9" PRIu64 " %9" PRIu64 ", %9" PRIi64 "\n", x, t1, t2, (int64_t)t2 - (int64_t)t1);
          fflush(multiplying);
@@ -510,9 +868,9 @@ int main(int argc, char **argv)
             printf("MUL %d: %9" PRIu64 " %9" PRIu64 ", %9" PRIi64 "\n", x, t1, t2, (int64_t)t2 - (int64_t)t1);
             fflush(stdout);
          }
-         set_cutoffs(&max_cutoffs);
+         set_cutoffs(max_cutoffs);
          t1 = s_time_sqr(x);
-         set_cutoffs(&orig);
+         set_cutoffs(orig);
          t2 = s_time_sqr(x);
          fprintf(squaring,"%d: %9" PRIu64 " %9" PRIu64 ", %9" PRIi64 "\n", x, t1, t2, (int64_t)t2 - (int64_t)t1);
          fflush(squaring);
@@ -523,19 +881,8 @@ int main(int argc, char **argv)
       }
       printf("Finished. Data for graphing in \"%s\" and \"%s\"\n",mullog, sqrlog);
       if (args.verbose == 1) {
-         set_cutoffs(&orig);
-         if (args.terse == 1) {
-            printf("%d %d %d %d\n",
-                   MP_MUL_KARATSUBA_CUTOFF,
-                   MP_SQR_KARATSUBA_CUTOFF,
-                   MP_MUL_TOOM_CUTOFF,
-                   MP_SQR_TOOM_CUTOFF);
-         } else {
-            printf("MUL_KARATSUBA_CUTOFF = %d\n", MP_MUL_KARATSUBA_CUTOFF);
-            printf("SQR_KARATSUBA_CUTOFF = %d\n", MP_SQR_KARATSUBA_CUTOFF);
-            printf("MUL_TOOM_CUTOFF = %d\n", MP_MUL_TOOM_CUTOFF);
-            printf("SQR_TOOM_CUTOFF = %d\n", MP_SQR_TOOM_CUTOFF);
-         }
+         set_cutoffs(orig);
+         print_cutoffs(orig);
       }
    }
    exit(EXIT_SUCCESS);
@@ -34,7 +34,7 @@ RNUM=0
 #############################################################################
 
 # Number of rounds overall.
-LIMIT=100
+LIMIT=20
 # Number of loops for each input.
 RLOOPS=10
 # Offset ( > 0 ) . Runs tests with asymmetric input of the form 1:OFFSET
@@ -42,10 +42,9 @@ RLOOPS=10
 # with an offset different from 1 (one) are not usable as the general cut-off values
 # in "tommath_cutoffs.h".
 OFFSET=1
-# Number ( >= 3 ) of positive results (TC-is-faster) accumulated until it is accepted.
-# Due to the algorithm used to compute the median in this Posix compliant shell script
-# the value needs to be 3 (three), not less, to keep the variation small.
-LAG=3
+# Number ( >= 5 ) of timings of both variants at each size. It is doubled while their
+# difference is within the noise.
+LAG=5
 # Keep the temporary file $FILE_NAME. Set to 0 (zero) to remove it at the end.
 # The file is in a format fit to feed into R directly. If you do it and find the median
 # of this program to be off by more than a couple: please contact the authors and report
@@ -55,8 +54,12 @@ KEEP_TEMP=1
 
 echo "You might like to watch the numbers go up to $LIMIT but it will take a long time!"
 
+# The cut-offs in the order of the output of "tune -t".
+CUTOFFS="MUL_KARATSUBA SQR_KARATSUBA MUL_TOOM SQR_TOOM MUL_COMBA SQR_COMBA MUL_BALANCE DIV_RECURSIVE \
+EXPTMOD_WIN3 EXPTMOD_WIN4 EXPTMOD_WIN5 EXPTMOD_WIN6 EXPTMOD_WIN7 EXPTMOD_WIN8"
+
 # Might not have sufficient rights or disc full.
-echo "km ks tc3m tc3s" > $FILE_NAME || die "Writing header to $FILE_NAME" $?
+echo $CUTOFFS > $FILE_NAME || die "Writing header to $FILE_NAME" $?
 i=1
 while [ $i -le $LIMIT ]; do
    RNUM=$(LCG)
@@ -78,10 +81,10 @@ cat << END_OF_INPUT > $TOMMATH_CUTOFFS_H || die "Writing header to $TOMMATH_CUTO
 /* LibTomMath, multiple-precision integer library -- Tom St Denis */
 /* SPDX-License-Identifier: Unlicense */
 /*
-   Current values evaluated on an AMD A8-6600K (64-bit).
+   Values evaluated by "make tune" on $(uname -m).
    Type "make tune" to optimize them for your machine but
-   be aware that it may take a long time. It took 2:30 minutes
-   on the aforementioned machine for example.
+   be aware that it may take a long time.
+   INT_MAX is "never", and for the Comba cut-offs "always".
  */
 END_OF_INPUT
 
@@ -92,15 +95,14 @@ END_OF_INPUT
 i=$(tail -n +2 $FILE_NAME | wc -l)
 # our median point will be at $i entries
 i=$(( (i / 2) + 1 ))
-TMP=$(median $FILE_NAME 1 $i)
-echo "#define MP_DEFAULT_MUL_KARATSUBA_CUTOFF $TMP"
-echo "#define MP_DEFAULT_MUL_KARATSUBA_CUTOFF $TMP" >> $TOMMATH_CUTOFFS_H || die "(km) Appending to $TOMMATH_CUTOFFS_H" $?
-TMP=$(median $FILE_NAME 2 $i)
-echo "#define MP_DEFAULT_SQR_KARATSUBA_CUTOFF $TMP"
-echo "#define MP_DEFAULT_SQR_KARATSUBA_CUTOFF $TMP" >> $TOMMATH_CUTOFFS_H || die "(ks) Appending to $TOMMATH_CUTOFFS_H" $?
-TMP=$(median $FILE_NAME 3 $i)
-echo "#define MP_DEFAULT_MUL_TOOM_CUTOFF      $TMP"
-echo "#define MP_DEFAULT_MUL_TOOM_CUTOFF      $TMP" >> $TOMMATH_CUTOFFS_H || die "(tc3m) Appending to $TOMMATH_CUTOFFS_H" $?
-TMP=$(median $FILE_NAME 4 $i)
-echo "#define MP_DEFAULT_SQR_TOOM_CUTOFF      $TMP"
-echo "#define MP_DEFAULT_SQR_TOOM_CUTOFF      $TMP" >> $TOMMATH_CUTOFFS_H || die "(tc3s) Appending to $TOMMATH_CUTOFFS_H" $?
+column=1
+for name in $CUTOFFS; do
+   TMP=$(median $FILE_NAME $column $i)
+   if [ "$TMP" = "2147483647" ]; then
+      TMP="INT_MAX"
+   fi
+   LINE=$(printf "#define MP_DEFAULT_%-20s %s" "${name}_CUTOFF" "$TMP")
+   echo "$LINE"
+   echo "$LINE" >> $TOMMATH_CUTOFFS_H || die "($name) Appending to $TOMMATH_CUTOFFS_H" $?
+   column=$((column + 1))
+done
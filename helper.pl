@@ -52,19 +52,19 @@ sub check_source {
       push @{$troubles->{non_ascii_char}},     $lineno if $l =~ /[^[:ascii:]]/;
       push @{$troubles->{cpp_comment}},        $lineno if $file =~ /\.(c|h)$/ && ($l =~ /\s\/\// || $l =~ /\/\/\s/);
       # we prefer using MP_MALLOC, MP_FREE, MP_REALLOC, MP_CALLOC ...
-      push @{$troubles->{unwanted_malloc}},    $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bmalloc\s*\(/;
-      push @{$troubles->{unwanted_realloc}},   $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\brealloc\s*\(/;
-      push @{$troubles->{unwanted_calloc}},    $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bcalloc\s*\(/;
-      push @{$troubles->{unwanted_free}},      $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bfree\s*\(/;
+      push @{$troubles->{unwanted_malloc}},    $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bmalloc\s*\(/ && $file !~ /s_mp_allocator.c/;
+      push @{$troubles->{unwanted_realloc}},   $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\brealloc\s*\(/ && $file !~ /s_mp_allocator.c/;
+      push @{$troubles->{unwanted_calloc}},    $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bcalloc\s*\(/ && $file !~ /s_mp_allocator.c/;
+      push @{$troubles->{unwanted_free}},      $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bfree\s*\(/ && $file !~ /s_mp_allocator.c/;
       # and we probably want to also avoid the following
       push @{$troubles->{unwanted_memcpy}},    $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bmemcpy\s*\(/ && $file !~ /s_mp_copy_digs.c/;
       push @{$troubles->{unwanted_memset}},    $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bmemset\s*\(/ && $file !~ /s_mp_zero_buf.c/ && $file !~ /s_mp_zero_digs.c/;
-      push @{$troubles->{unwanted_memmove}},   $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bmemmove\s*\(/;
+      push @{$troubles->{unwanted_memmove}},   $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bmemmove\s*\(/ && $file !~ /s_mp_move_digs.c/;
       push @{$troubles->{unwanted_memcmp}},    $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bmemcmp\s*\(/;
       push @{$troubles->{unwanted_strcmp}},    $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bstrcmp\s*\(/;
       push @{$troubles->{unwanted_strcpy}},    $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bstrcpy\s*\(/;
       push @{$troubles->{unwanted_strncpy}},   $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bstrncpy\s*\(/;
-      push @{$troubles->{unwanted_clock}},     $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bclock\s*\(/;
+      push @{$troubles->{unwanted_clock}},     $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bclock\s*\(/ && $file !~ /mp_cutoffs_autotune.c/;
       push @{$troubles->{unwanted_qsort}},     $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bqsort\s*\(/;
       push @{$troubles->{sizeof_no_brackets}}, $lineno if $file =~ /^[^\/]+\.c$/ && $l =~ /\bsizeof\s*[^\(]/;
       if ($file =~ m|^[^\/]+\.c$| && $l =~ /^static(\s+[a-zA-Z0-9_]+)+\s+([a-zA-Z0-9_]+)\s*\(/) {
@@ -308,7 +308,7 @@ sub update_dep
 #if defined(LTM_ALL)
 EOS
 
-    foreach my $filename (glob '*mp_*.c') {
+    foreach my $filename (glob '*mp_*.c mpl_*.c') {
         my $define = $filename;
 
         print "Processing $filename\n";
@@ -355,7 +355,7 @@ EOS
 
     # now do classes
     my %depmap;
-    foreach my $filename (glob '*mp_*.c') {
+    foreach my $filename (glob '*mp_*.c mpl_*.c') {
         my $content;
         my $cc = $ENV{'CC'} || 'gcc';
         $content = `$cc -E -x c -DLTM_ALL $filename`;
@@ -371,12 +371,15 @@ EOS
         # strip comments
         $content =~ s{/\*.*?\*/}{}gs;
 
-        # scan for mp_* and make classes
+        # scan for mp_* and mpl_* and make classes
         my @deps = ();
         foreach my $line (split /\n/, $content) {
-            while ($line =~ /(fast_)?(s_)?mp\_[a-z_0-9]*((?=\;)|(?=\())|(?<=\()mp\_[a-z_0-9]*(?=\()/g) {
+            while ($line =~ /(fast_)?(s_)?mpl?\_[a-z_0-9]*((?=\;)|(?=\()|(?=\.))|(?<=\()mpl?\_[a-z_0-9]*(?=\()/g) {
                 my $a = $&;
-                next if $a eq "mp_err";
+                # the type and the private globals which are not functions
+                next if $a =~ /^(mp_err|s_mp_allocator_default|s_mp_batch_pool|s_mp_cutoffs_env_done|s_mp_cutoffs_thread)$/;
+                # a member access only depends on a global which has a source file of its own
+                next if substr($line, pos($line), 1) eq '.' && !-f "$a.c";
                 $a =~ tr/[a-z]/[A-Z]/;
                 $a = $a . '_C';
                 push @deps, $a;
@@ -422,11 +425,11 @@ EOS
 }
 
 sub generate_def {
-    my @files = glob '*mp_*.c';
+    my @files = glob '*mp_*.c mpl_*.c';
     @files = map { my $x = $_; $x =~ s/\.c$//g; $x; } @files;
-    @files = grep(!/mp_cutoffs/, @files);
+    @files = grep(!/^mp_cutoffs$/, @files);
 
-    my $files = join("\n    ", sort(grep(/^mp_/, @files)));
+    my $files = join("\n    ", sort(grep(/^mpl?_/, @files)));
     write_file "tommath.def", "; libtommath
 ;
 ; Use this command to produce a 32-bit .lib file, for use in any MSVC version
@@ -105,6 +105,15 @@ ifeq ($(PLATFORM), CYGWIN)
 LIBTOOLFLAGS += -no-undefined
 endif
 
+ifeq ($(findstring mingw,$(CC)),)
+# the batch functions run on a pool of POSIX threads
+LTM_LFLAGS += -pthread
+LTM_LDFLAGS += -pthread
+endif
+
+# the C++ demos only get the configuration of the library from CFLAGS
+LTM_CXXFLAGS += -I./ -Wall -Wextra -Wshadow $(filter -D%,$(CFLAGS)) $(CXXFLAGS)
+
 # add in the standard FLAGS
 LTM_CFLAGS += $(CFLAGS)
 LTM_LFLAGS += $(LFLAGS)
@@ -127,7 +136,7 @@ else
    COVERAGE_APP = ./test
 endif
 
-HEADERS_PUB=tommath.h
+HEADERS_PUB=tommath.h tommath.hpp tommath_fixed.hpp
 HEADERS=tommath_private.h tommath_class.h tommath_superclass.h tommath_cutoffs.h $(HEADERS_PUB)
 
 #LIBPATH  The directory for libtommath to be installed to.
@@ -167,7 +176,7 @@ cleancov: cleancov-clean clean
 
 clean:
 	rm -f *.gcda *.gcno *.gcov *.bat *.o *.a *.obj *.lib *.exe *.dll etclib/*.o \
-				demo/*.o test timing mtest_opponent mtest/mtest mtest/mtest.exe tuning_list \
+				demo/*.o test test_cpp timing bench mtest_opponent mtest/mtest mtest/mtest.exe tuning_list \
 				*.s tommath_amalgam.c pre_gen/tommath_amalgam.c *.da *.dyn *.dpi tommath.tex \
 				`find . -type f | grep [~] | xargs` *.lo *.la
 	rm -rf .libs/ demo/.libs
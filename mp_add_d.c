@@ -55,13 +55,17 @@ mp_err mp_add_d(const mp_int *a, mp_digit b, mp_int *c)
       /* add digits, mu is carry */
       int i;
       mp_digit mu = b;
-      for (i = 0; i < a->used; i++) {
+      for (i = 0; (i < a->used) && (mu != 0u); i++) {
          c->dp[i] = a->dp[i] + mu;
          mu = c->dp[i] >> MP_DIGIT_BIT;
          c->dp[i] &= MP_MASK;
       }
+      /* the digits above the carry are unchanged */
+      if ((c != a) && (i < a->used)) {
+         s_mp_copy_digs(c->dp + i, a->dp + i, a->used - i);
+      }
       /* set final carry */
-      c->dp[i] = mu;
+      c->dp[a->used] = mu;
 
       /* setup size */
       c->used = a->used + 1;
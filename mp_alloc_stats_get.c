@@ -0,0 +1,16 @@
+#include "tommath_private.h"
+#ifdef MP_ALLOC_STATS_GET_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+mp_err mp_alloc_stats_get(mp_alloc_stats *stats)
+{
+#ifdef MP_ALLOC_STATS
+   *stats = s_mp_alloc_stats.stats;
+   return MP_OKAY;
+#else
+   (void)stats;
+   return MP_ERR;
+#endif
+}
+#endif
@@ -0,0 +1,19 @@
+#include "tommath_private.h"
+#ifdef MP_ALLOC_STATS_RESET_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+void mp_alloc_stats_reset(void)
+{
+#ifdef MP_ALLOC_STATS
+   /* the live bytes are kept, the frees of older allocations are still to come */
+   int k;
+   for (k = 0; k < (int)MP_ALLOC_OP_COUNT; k++) {
+      s_mp_alloc_stats.stats.op[k].allocs = 0u;
+      s_mp_alloc_stats.stats.op[k].frees = 0u;
+      s_mp_alloc_stats.stats.op[k].bytes = 0u;
+      s_mp_alloc_stats.stats.op[k].peak = 0u;
+   }
+#endif
+}
+#endif
@@ -6,11 +6,28 @@
 /* two complement and */
 mp_err mp_and(const mp_int *a, const mp_int *b, mp_int *c)
 {
-   int used = MP_MAX(a->used, b->used) + 1, i;
+   int used, oldused = c->used, i;
    mp_err err;
    mp_digit ac = 1, bc = 1, cc = 1;
    bool neg = (mp_isneg(a) && mp_isneg(b));
 
+   /* without negative operands nothing has to be converted */
+   if (!mp_isneg(a) && !mp_isneg(b)) {
+      used = MP_MIN(a->used, b->used);
+      if ((err = mp_grow(c, used)) != MP_OKAY) {
+         return err;
+      }
+      for (i = 0; i < used; i++) {
+         c->dp[i] = a->dp[i] & b->dp[i];
+      }
+      c->used = used;
+      c->sign = MP_ZPOS;
+      s_mp_zero_digs(c->dp + used, oldused - used);
+      mp_clamp(c);
+      return MP_OKAY;
+   }
+
+   used = MP_MAX(a->used, b->used) + 1;
    if ((err = mp_grow(c, used)) != MP_OKAY) {
       return err;
    }
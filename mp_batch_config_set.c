@@ -0,0 +1,27 @@
+#include "tommath_private.h"
+#ifdef MP_BATCH_CONFIG_SET_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+mp_err mp_batch_config_set(const mp_batch_config *config)
+{
+#ifdef MP_HAS_PTHREAD
+   if ((config != NULL) && ((config->threads < 0) || (config->threads > MP_BATCH_MAX_THREADS))) {
+      return MP_VAL;
+   }
+
+   /* the workers are started again with the new configuration by the next batch */
+   s_mp_batch_stop();
+
+   MP_BATCH_LOCK();
+   if (config != NULL) {
+      s_mp_batch_pool.config = *config;
+   }
+   s_mp_batch_pool.configured = (config != NULL);
+   MP_BATCH_UNLOCK();
+   return MP_OKAY;
+#else
+   return ((config != NULL) && (config->threads == 0)) ? MP_OKAY : MP_ERR;
+#endif
+}
+#endif
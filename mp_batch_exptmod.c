@@ -0,0 +1,27 @@
+#include "tommath_private.h"
+#ifdef MP_BATCH_EXPTMOD_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+typedef struct {
+   const mp_int *G, *X, *P;
+   mp_int *Y;
+} s_batch_exptmod_args;
+
+static mp_err s_batch_exptmod(const void *args, size_t i)
+{
+   const s_batch_exptmod_args *a = (const s_batch_exptmod_args *)args;
+   return mp_exptmod(&a->G[i], &a->X[i], &a->P[i], &a->Y[i]);
+}
+
+mp_err mp_batch_exptmod(const mp_int *G, const mp_int *X, const mp_int *P, mp_int *Y,
+                        mp_err *errs, size_t n)
+{
+   s_batch_exptmod_args args;
+   args.G = G;
+   args.X = X;
+   args.P = P;
+   args.Y = Y;
+   return s_mp_batch_run(s_batch_exptmod, &args, errs, n);
+}
+#endif
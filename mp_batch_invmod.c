@@ -0,0 +1,25 @@
+#include "tommath_private.h"
+#ifdef MP_BATCH_INVMOD_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+typedef struct {
+   const mp_int *a, *b;
+   mp_int *c;
+} s_batch_invmod_args;
+
+static mp_err s_batch_invmod(const void *args, size_t i)
+{
+   const s_batch_invmod_args *a = (const s_batch_invmod_args *)args;
+   return mp_invmod(&a->a[i], &a->b[i], &a->c[i]);
+}
+
+mp_err mp_batch_invmod(const mp_int *a, const mp_int *b, mp_int *c, mp_err *errs, size_t n)
+{
+   s_batch_invmod_args args;
+   args.a = a;
+   args.b = b;
+   args.c = c;
+   return s_mp_batch_run(s_batch_invmod, &args, errs, n);
+}
+#endif
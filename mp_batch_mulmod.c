@@ -0,0 +1,27 @@
+#include "tommath_private.h"
+#ifdef MP_BATCH_MULMOD_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+typedef struct {
+   const mp_int *a, *b, *c;
+   mp_int *d;
+} s_batch_mulmod_args;
+
+static mp_err s_batch_mulmod(const void *args, size_t i)
+{
+   const s_batch_mulmod_args *a = (const s_batch_mulmod_args *)args;
+   return mp_mulmod(&a->a[i], &a->b[i], &a->c[i], &a->d[i]);
+}
+
+mp_err mp_batch_mulmod(const mp_int *a, const mp_int *b, const mp_int *c, mp_int *d,
+                       mp_err *errs, size_t n)
+{
+   s_batch_mulmod_args args;
+   args.a = a;
+   args.b = b;
+   args.c = c;
+   args.d = d;
+   return s_mp_batch_run(s_batch_mulmod, &args, errs, n);
+}
+#endif
@@ -0,0 +1,26 @@
+#include "tommath_private.h"
+#ifdef MP_BATCH_PRIME_IS_PRIME_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+typedef struct {
+   const mp_int *a;
+   int t;
+   bool *result;
+} s_batch_prime_args;
+
+static mp_err s_batch_prime_is_prime(const void *args, size_t i)
+{
+   const s_batch_prime_args *a = (const s_batch_prime_args *)args;
+   return mp_prime_is_prime(&a->a[i], a->t, &a->result[i]);
+}
+
+mp_err mp_batch_prime_is_prime(const mp_int *a, int t, bool *result, mp_err *errs, size_t n)
+{
+   s_batch_prime_args args;
+   args.a = a;
+   args.t = t;
+   args.result = result;
+   return s_mp_batch_run(s_batch_prime_is_prime, &args, errs, n);
+}
+#endif
@@ -8,8 +8,15 @@ void mp_clear(mp_int *a)
 {
    /* only do anything if a hasn't been freed previously */
    if (a->dp != NULL) {
-      /* free ram */
-      MP_FREE_DIGS(a->dp, a->alloc);
+      /* free ram, inline digits are only cleared */
+#if defined(MP_INLINE_DIGITS) && !defined(MP_NO_ZERO_ON_FREE)
+      s_mp_zero_digs(a->inl, MP_INLINE_DIGITS);
+#endif
+      if (MP_SCRATCH_OWNS(a->dp)) {
+         s_mp_scratch_free(a->dp, a->alloc);
+      } else if (!MP_INLINE_OWNS(a)) {
+         s_mp_digs_free(a->dp, a->alloc);
+      }
 
       /* reset members to make debugging easier */
       a->dp    = NULL;
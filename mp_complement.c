@@ -3,11 +3,15 @@
 /* LibTomMath, multiple-precision integer library -- Tom St Denis */
 /* SPDX-License-Identifier: Unlicense */
 
-/* b = ~a */
+/* b = ~a = -(a + 1) */
 mp_err mp_complement(const mp_int *a, mp_int *b)
 {
-   mp_int a_ = *a;
-   a_.sign = ((a_.sign == MP_ZPOS) && !mp_iszero(a)) ? MP_NEG : MP_ZPOS;
-   return mp_sub_d(&a_, 1uL, b);
+   mp_err err;
+
+   /* the carry of the increment stops at the first digit it does not overflow */
+   if ((err = mp_add_d(a, 1u, b)) != MP_OKAY) {
+      return err;
+   }
+   return mp_neg(b, b);
 }
 #endif
@@ -8,7 +8,22 @@
 int MP_MUL_KARATSUBA_CUTOFF = MP_DEFAULT_MUL_KARATSUBA_CUTOFF,
     MP_SQR_KARATSUBA_CUTOFF = MP_DEFAULT_SQR_KARATSUBA_CUTOFF,
     MP_MUL_TOOM_CUTOFF = MP_DEFAULT_MUL_TOOM_CUTOFF,
-    MP_SQR_TOOM_CUTOFF = MP_DEFAULT_SQR_TOOM_CUTOFF;
+    MP_SQR_TOOM_CUTOFF = MP_DEFAULT_SQR_TOOM_CUTOFF,
+    MP_MUL_COMBA_CUTOFF = MP_DEFAULT_MUL_COMBA_CUTOFF,
+    MP_SQR_COMBA_CUTOFF = MP_DEFAULT_SQR_COMBA_CUTOFF,
+    MP_MUL_BALANCE_CUTOFF = MP_DEFAULT_MUL_BALANCE_CUTOFF,
+    MP_DIV_RECURSIVE_CUTOFF = MP_DEFAULT_DIV_RECURSIVE_CUTOFF,
+    MP_EXPTMOD_WIN3_CUTOFF = MP_DEFAULT_EXPTMOD_WIN3_CUTOFF,
+    MP_EXPTMOD_WIN4_CUTOFF = MP_DEFAULT_EXPTMOD_WIN4_CUTOFF,
+    MP_EXPTMOD_WIN5_CUTOFF = MP_DEFAULT_EXPTMOD_WIN5_CUTOFF,
+    MP_EXPTMOD_WIN6_CUTOFF = MP_DEFAULT_EXPTMOD_WIN6_CUTOFF,
+    MP_EXPTMOD_WIN7_CUTOFF = MP_DEFAULT_EXPTMOD_WIN7_CUTOFF,
+    MP_EXPTMOD_WIN8_CUTOFF = MP_DEFAULT_EXPTMOD_WIN8_CUTOFF;
+
+#ifdef MP_THREAD_LOCAL
+/* cutoffs installed for the current thread */
+MP_THREAD_LOCAL s_mp_cutoffs_state s_mp_cutoffs_thread;
+#endif
 #endif
 
 #endif
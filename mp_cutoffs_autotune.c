@@ -0,0 +1,274 @@
+#include "tommath_private.h"
+#ifdef MP_CUTOFFS_AUTOTUNE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifndef MP_FIXED_CUTOFFS
+#include <time.h>
+
+#define S_AUTOTUNE_MUL 0
+#define S_AUTOTUNE_SQR 1
+#define S_AUTOTUNE_DIV 2
+
+/* a timing takes at least about 2 ms, the minimum of S_AUTOTUNE_RUNS timings is compared */
+#define S_AUTOTUNE_MAX_REPS (1L << 20)
+#define S_AUTOTUNE_RUNS     5
+
+/* The processor time of the calling thread where it is available, such that
+ * other threads, e.g. the workers of mp_batch_*, do not count.
+ */
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+#  define S_AUTOTUNE_CLOCK CLOCK_THREAD_CPUTIME_ID
+#elif defined(CLOCK_MONOTONIC)
+#  define S_AUTOTUNE_CLOCK CLOCK_MONOTONIC
+#endif
+
+#ifdef S_AUTOTUNE_CLOCK
+#define S_AUTOTUNE_TICKS 2000000u
+static mp_err s_autotune_now(uint64_t *ticks)
+{
+   struct timespec ts;
+   if (clock_gettime(S_AUTOTUNE_CLOCK, &ts) != 0) {
+      return MP_ERR;
+   }
+   *ticks = ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+   return MP_OKAY;
+}
+#else
+#define S_AUTOTUNE_TICKS ((uint64_t)(CLOCKS_PER_SEC / 500) + 1u)
+static mp_err s_autotune_now(uint64_t *ticks)
+{
+   clock_t t = clock();
+   if (t == (clock_t)-1) {
+      return MP_ERR;
+   }
+   *ticks = (uint64_t)t;
+   return MP_OKAY;
+}
+#endif
+
+/* the cutoffs being measured are installed for the calling thread only, if possible */
+static void s_autotune_install(const mp_cutoffs *cutoffs)
+{
+#ifdef MP_THREAD_LOCAL
+   s_mp_cutoffs_thread.cutoffs = *cutoffs;
+   s_mp_cutoffs_thread.set = true;
+#else
+   s_mp_cutoffs_set_global(cutoffs);
+#endif
+}
+
+/* "n" digits of a xorshift, the timings hardly depend on them */
+static mp_err s_autotune_fill(mp_int *a, int n, uint32_t *state)
+{
+   mp_err err;
+   int i;
+
+   mp_zero(a);
+   if ((err = mp_grow(a, n)) != MP_OKAY) {
+      return err;
+   }
+   for (i = 0; i < n; ++i) {
+      *state ^= *state << 13;
+      *state ^= *state >> 17;
+      *state ^= *state << 5;
+      a->dp[i] = (mp_digit)((((mp_digit)*state << (MP_DIGIT_BIT / 2)) ^ (mp_digit)*state) & MP_MASK);
+   }
+   a->dp[n - 1] |= 1u;
+   a->used = n;
+   return MP_OKAY;
+}
+
+/* CPU time of "reps" runs of "op" on t[0] and t[1] */
+static mp_err s_autotune_time(int op, long reps, mp_int *t, uint64_t *ticks)
+{
+   uint64_t start, stop;
+   mp_err err;
+   long i;
+
+   if ((err = s_autotune_now(&start)) != MP_OKAY) {
+      return err;
+   }
+   for (i = 0; (i < reps) && (err == MP_OKAY); ++i) {
+      err = (op == S_AUTOTUNE_DIV) ? mp_div(&t[0], &t[1], &t[2], &t[3]) :
+            mp_mul(&t[0], (op == S_AUTOTUNE_SQR) ? &t[0] : &t[1], &t[2]);
+   }
+   if (err != MP_OKAY) {
+      return err;
+   }
+   if ((err = s_autotune_now(&stop)) != MP_OKAY) {
+      return err;
+   }
+   *ticks = stop - start;
+   return MP_OKAY;
+}
+
+/* whether "op" on "x" digits is faster with "*cutoff" at "x" than at INT_MAX */
+static mp_err s_autotune_faster(int op, mp_cutoffs *cutoffs, int *cutoff, int x, mp_int *t, bool *faster)
+{
+   uint64_t with = 0u, without = 0u, ticks;
+   uint32_t state = 0x9e3779b9u ^ (uint32_t)x;
+   long reps;
+   mp_err err;
+   int i;
+
+   if (((err = s_autotune_fill(&t[0], (op == S_AUTOTUNE_DIV) ? (2 * x) : x, &state)) != MP_OKAY) ||
+       ((err = s_autotune_fill(&t[1], x, &state)) != MP_OKAY)) {
+      return err;
+   }
+
+   /* enough runs to be well above the resolution of the clock */
+   *cutoff = INT_MAX;
+   s_autotune_install(cutoffs);
+   for (reps = 1L; ; reps *= 2L) {
+      if ((err = s_autotune_time(op, reps, t, &ticks)) != MP_OKAY) {
+         return err;
+      }
+      if ((ticks >= S_AUTOTUNE_TICKS) || (reps >= S_AUTOTUNE_MAX_REPS)) {
+         break;
+      }
+   }
+
+   /* interleaved, such that a drift of the clock or the load hits both */
+   for (i = 0; i < S_AUTOTUNE_RUNS; ++i) {
+      *cutoff = INT_MAX;
+      s_autotune_install(cutoffs);
+      if ((err = s_autotune_time(op, reps, t, &ticks)) != MP_OKAY) {
+         return err;
+      }
+      without = ((i == 0) || (ticks < without)) ? ticks : without;
+
+      *cutoff = x;
+      s_autotune_install(cutoffs);
+      if ((err = s_autotune_time(op, reps, t, &ticks)) != MP_OKAY) {
+         return err;
+      }
+      with = ((i == 0) || (ticks < with)) ? ticks : with;
+   }
+
+   /* a tie is left to the algorithm used below the cutoff */
+   *faster = ((with + (with / 32)) < without);
+   return MP_OKAY;
+}
+
+/* The smallest "x" in [lo, hi] at which "op" is faster with "*cutoff" at "x".
+ * The size is doubled until it is faster and the crossover is then bisected
+ * down to 1/16 of the size. The cutoff is set to "keep" if there is none.
+ */
+static mp_err s_autotune_crossover(int op, mp_cutoffs *cutoffs, int *cutoff, int keep, int lo, int hi, mp_int *t)
+{
+   int x, below = lo - 1, mid;
+   bool faster = false;
+   mp_err err;
+
+   *cutoff = keep;
+   if (hi < lo) {
+      return MP_OKAY;
+   }
+   for (x = lo; ; x = (x > (hi / 2)) ? hi : (2 * x)) {
+      if ((err = s_autotune_faster(op, cutoffs, cutoff, x, t, &faster)) != MP_OKAY) {
+         goto LBL_ERR;
+      }
+      if (faster) {
+         break;
+      }
+      if (x == hi) {
+         *cutoff = keep;
+         return MP_OKAY;
+      }
+      below = x;
+   }
+   while ((x - below) > MP_MAX(1, x / 16)) {
+      mid = below + ((x - below) / 2);
+      if ((err = s_autotune_faster(op, cutoffs, cutoff, mid, t, &faster)) != MP_OKAY) {
+         goto LBL_ERR;
+      }
+      if (faster) {
+         x = mid;
+      } else {
+         below = mid;
+      }
+   }
+   *cutoff = x;
+   return MP_OKAY;
+
+LBL_ERR:
+   *cutoff = keep;
+   return err;
+}
+#endif
+
+/* a quick measurement of the cutoffs of Karatsuba, Toom-Cook and the
+ * recursive division, each with the ones before it in place
+ */
+mp_err mp_cutoffs_autotune(void)
+{
+#ifndef MP_FIXED_CUTOFFS
+   mp_cutoffs orig, cutoffs;
+#ifdef MP_THREAD_LOCAL
+   s_mp_cutoffs_state thread = s_mp_cutoffs_thread;
+#endif
+   uint64_t now;
+   mp_int t[4];
+   mp_err err;
+
+   /* LTM_CUTOFFS must not overwrite the measured cutoffs later on */
+   MP_CUTOFFS_ENV();
+
+   /* the clock works */
+   if ((err = s_autotune_now(&now)) != MP_OKAY) {
+      return err;
+   }
+   if ((err = mp_init_multi(&t[0], &t[1], &t[2], &t[3], NULL)) != MP_OKAY) {
+      return err;
+   }
+
+   s_mp_cutoffs_get_global(&orig);
+   cutoffs = orig;
+   cutoffs.mul_toom = cutoffs.sqr_toom = INT_MAX;
+
+   if (MP_HAS(S_MP_MUL_KARATSUBA) &&
+       ((err = s_autotune_crossover(S_AUTOTUNE_MUL, &cutoffs, &cutoffs.mul_karatsuba, orig.mul_karatsuba,
+                                    8, 512, t)) != MP_OKAY)) {
+      goto LBL_ERR;
+   }
+   if (MP_HAS(S_MP_SQR_KARATSUBA) &&
+       ((err = s_autotune_crossover(S_AUTOTUNE_SQR, &cutoffs, &cutoffs.sqr_karatsuba, orig.sqr_karatsuba,
+                                    8, 512, t)) != MP_OKAY)) {
+      goto LBL_ERR;
+   }
+
+   cutoffs.mul_toom = orig.mul_toom;
+   if (MP_HAS(S_MP_MUL_TOOM) &&
+       ((err = s_autotune_crossover(S_AUTOTUNE_MUL, &cutoffs, &cutoffs.mul_toom, orig.mul_toom,
+                                    MP_MAX(8, cutoffs.mul_karatsuba), 1024, t)) != MP_OKAY)) {
+      goto LBL_ERR;
+   }
+   cutoffs.sqr_toom = orig.sqr_toom;
+   if (MP_HAS(S_MP_SQR_TOOM) &&
+       ((err = s_autotune_crossover(S_AUTOTUNE_SQR, &cutoffs, &cutoffs.sqr_toom, orig.sqr_toom,
+                                    MP_MAX(8, cutoffs.sqr_karatsuba), 1024, t)) != MP_OKAY)) {
+      goto LBL_ERR;
+   }
+
+   if (MP_HAS(S_MP_DIV_RECURSIVE) &&
+       ((err = s_autotune_crossover(S_AUTOTUNE_DIV, &cutoffs, &cutoffs.div_recursive, orig.div_recursive,
+                                    16, 1024, t)) != MP_OKAY)) {
+      goto LBL_ERR;
+   }
+
+   err = s_mp_cutoffs_check(&cutoffs);
+
+LBL_ERR:
+#ifdef MP_THREAD_LOCAL
+   s_mp_cutoffs_thread = thread;
+#endif
+   s_mp_cutoffs_set_global((err == MP_OKAY) ? &cutoffs : &orig);
+   mp_clear_multi(&t[0], &t[1], &t[2], &t[3], NULL);
+   return err;
+#else
+   return MP_ERR;
+#endif
+}
+
+#endif
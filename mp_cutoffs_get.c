@@ -0,0 +1,24 @@
+#include "tommath_private.h"
+#ifdef MP_CUTOFFS_GET_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+void mp_cutoffs_get(mp_cutoffs *cutoffs)
+{
+   MP_CUTOFFS_ENV();
+   cutoffs->mul_karatsuba = MP_CUTOFF(mul_karatsuba, MUL_KARATSUBA);
+   cutoffs->sqr_karatsuba = MP_CUTOFF(sqr_karatsuba, SQR_KARATSUBA);
+   cutoffs->mul_toom = MP_CUTOFF(mul_toom, MUL_TOOM);
+   cutoffs->sqr_toom = MP_CUTOFF(sqr_toom, SQR_TOOM);
+   cutoffs->mul_comba = MP_CUTOFF(mul_comba, MUL_COMBA);
+   cutoffs->sqr_comba = MP_CUTOFF(sqr_comba, SQR_COMBA);
+   cutoffs->mul_balance = MP_CUTOFF(mul_balance, MUL_BALANCE);
+   cutoffs->div_recursive = MP_CUTOFF(div_recursive, DIV_RECURSIVE);
+   cutoffs->exptmod_win3 = MP_CUTOFF(exptmod_win3, EXPTMOD_WIN3);
+   cutoffs->exptmod_win4 = MP_CUTOFF(exptmod_win4, EXPTMOD_WIN4);
+   cutoffs->exptmod_win5 = MP_CUTOFF(exptmod_win5, EXPTMOD_WIN5);
+   cutoffs->exptmod_win6 = MP_CUTOFF(exptmod_win6, EXPTMOD_WIN6);
+   cutoffs->exptmod_win7 = MP_CUTOFF(exptmod_win7, EXPTMOD_WIN7);
+   cutoffs->exptmod_win8 = MP_CUTOFF(exptmod_win8, EXPTMOD_WIN8);
+}
+#endif
@@ -0,0 +1,20 @@
+#include "tommath_private.h"
+#ifdef MP_CUTOFFS_LOAD_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifndef MP_NO_FILE
+mp_err mp_cutoffs_load(const char *path)
+{
+#ifndef MP_FIXED_CUTOFFS
+   /* LTM_CUTOFFS must not overwrite the file later on */
+   MP_CUTOFFS_ENV();
+   return s_mp_cutoffs_load(path);
+#else
+   (void)path;
+   return MP_ERR;
+#endif
+}
+#endif
+
+#endif
@@ -0,0 +1,36 @@
+#include "tommath_private.h"
+#ifdef MP_CUTOFFS_SAVE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifndef MP_NO_FILE
+/* save the cutoffs of the calling thread in the format of mp_cutoffs_load */
+mp_err mp_cutoffs_save(const char *path)
+{
+   mp_cutoffs cutoffs;
+   mp_err err = MP_OKAY;
+   FILE *stream;
+   int i;
+
+   mp_cutoffs_get(&cutoffs);
+
+   if ((stream = fopen(path, "w")) == NULL) {
+      return MP_ERR;
+   }
+   if (fprintf(stream, "# LibTomMath cutoffs of %d bit digits\n", MP_DIGIT_BIT) < 0) {
+      err = MP_ERR;
+   }
+   for (i = 0; (i < MP_CUTOFFS_FIELDS) && (err == MP_OKAY); ++i) {
+      if (fprintf(stream, "%s = %d\n", s_mp_cutoffs_fields[i].name,
+                  *(const int *)(const void *)((const char *)&cutoffs + s_mp_cutoffs_fields[i].offset)) < 0) {
+         err = MP_ERR;
+      }
+   }
+   if (fclose(stream) != 0) {
+      err = MP_ERR;
+   }
+   return err;
+}
+#endif
+
+#endif
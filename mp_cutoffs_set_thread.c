@@ -0,0 +1,27 @@
+#include "tommath_private.h"
+#ifdef MP_CUTOFFS_SET_THREAD_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* install cutoffs for the calling thread, they are copied */
+mp_err mp_cutoffs_set_thread(const mp_cutoffs *cutoffs)
+{
+#if !defined(MP_FIXED_CUTOFFS) && defined(MP_THREAD_LOCAL)
+   if (cutoffs == NULL) {
+      s_mp_cutoffs_thread.set = false;
+      return MP_OKAY;
+   }
+
+   if (s_mp_cutoffs_check(cutoffs) != MP_OKAY) {
+      return MP_VAL;
+   }
+
+   s_mp_cutoffs_thread.cutoffs = *cutoffs;
+   s_mp_cutoffs_thread.set = true;
+   return MP_OKAY;
+#else
+   (void)cutoffs;
+   return MP_ERR;
+#endif
+}
+#endif
@@ -0,0 +1,18 @@
+#include "tommath_private.h"
+#ifdef MP_DIGIT_CACHE_FLUSH_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+void mp_digit_cache_flush(void)
+{
+#ifdef MP_DIGIT_CACHE
+   int k;
+   for (k = 0; k < MP_DIGIT_CACHE_CLASSES; k++) {
+      while (s_mp_digit_cache.count[k] > 0) {
+         MP_FREE_DIGS(s_mp_digit_cache.slot[k][--s_mp_digit_cache.count[k]], 1 << (k + MP_DIGIT_CACHE_MIN));
+      }
+   }
+   s_mp_digit_cache.stats.bytes = 0u;
+#endif
+}
+#endif
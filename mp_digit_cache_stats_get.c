@@ -0,0 +1,16 @@
+#include "tommath_private.h"
+#ifdef MP_DIGIT_CACHE_STATS_GET_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+mp_err mp_digit_cache_stats_get(mp_digit_cache_stats *stats)
+{
+#ifdef MP_DIGIT_CACHE
+   *stats = s_mp_digit_cache.stats;
+   return MP_OKAY;
+#else
+   (void)stats;
+   return MP_ERR;
+#endif
+}
+#endif
@@ -14,6 +14,7 @@ mp_err mp_div(const mp_int *a, const mp_int *b, mp_int *c, mp_int *d)
 
    /* if a < b then q = 0, r = a */
    if (mp_cmp_mag(a, b) == MP_LT) {
+      MP_STATS_COUNT(MP_STATS_DIV_TRIVIAL, b->used);
       if (d != NULL) {
          if ((err = mp_copy(a, d)) != MP_OKAY) {
             return err;
@@ -25,17 +26,23 @@ mp_err mp_div(const mp_int *a, const mp_int *b, mp_int *c, mp_int *d)
       return MP_OKAY;
    }
 
+   MP_CUTOFFS_ENV();
+   MP_ALLOC_OP_ENTER(MP_ALLOC_OP_DIV);
    if (MP_HAS(S_MP_DIV_RECURSIVE)
-       && (b->used > (2 * MP_MUL_KARATSUBA_CUTOFF))
+       && (b->used >= MP_CUTOFF(div_recursive, DIV_RECURSIVE))
        && (b->used <= ((a->used/3)*2))) {
+      MP_STATS_COUNT(MP_STATS_DIV_RECURSIVE, b->used);
       err = s_mp_div_recursive(a, b, c, d);
    } else if (MP_HAS(S_MP_DIV_SCHOOL)) {
+      MP_STATS_COUNT(MP_STATS_DIV_SCHOOL, b->used);
       err = s_mp_div_school(a, b, c, d);
    } else if (MP_HAS(S_MP_DIV_SMALL)) {
+      MP_STATS_COUNT(MP_STATS_DIV_SMALL, b->used);
       err = s_mp_div_small(a, b, c, d);
    } else {
       err = MP_VAL;
    }
+   MP_ALLOC_OP_LEAVE();
 
    return err;
 }
@@ -7,8 +7,7 @@
 mp_err mp_div_2(const mp_int *a, mp_int *b)
 {
    mp_err err;
-   int x, oldused;
-   mp_digit r;
+   int oldused;
 
    if ((err = mp_grow(b, a->used)) != MP_OKAY) {
       return err;
@@ -17,17 +16,8 @@ mp_err mp_div_2(const mp_int *a, mp_int *b)
    oldused = b->used;
    b->used = a->used;
 
-   /* carry */
-   r = 0;
-   for (x = b->used; x --> 0;) {
-      /* get the carry for the next iteration */
-      mp_digit rr = a->dp[x] & 1u;
-
-      /* shift the current digit, add in carry and store */
-      b->dp[x] = (a->dp[x] >> 1) | (r << (MP_DIGIT_BIT - 1));
-
-      /* forward carry to next iteration */
-      r = rr;
+   if (b->used > 0) {
+      mpl_rshift(a->dp, a->used, 1, b->dp);
    }
 
    /* zero excess digits */
@@ -6,56 +6,51 @@
 /* shift right by a certain bit count (store quotient in c, optional remainder in d) */
 mp_err mp_div_2d(const mp_int *a, int b, mp_int *c, mp_int *d)
 {
+   int digs, bits, used, oldused;
    mp_err err;
 
    if (b < 0) {
       return MP_VAL;
    }
 
-   if ((err = mp_copy(a, c)) != MP_OKAY) {
-      return err;
-   }
-
-   /* 'a' should not be used after here - it might be the same as d */
-
-   /* get the remainder */
-   if (d != NULL) {
+   /* get the remainder, unless it overwrites a */
+   if ((d != NULL) && (d != a)) {
       if ((err = mp_mod_2d(a, b, d)) != MP_OKAY) {
          return err;
       }
    }
 
-   /* shift by as many digits in the bit count */
-   if (b >= MP_DIGIT_BIT) {
-      mp_rshd(c, b / MP_DIGIT_BIT);
-   }
-
-   /* shift any bit count < MP_DIGIT_BIT */
-   b %= MP_DIGIT_BIT;
-   if (b != 0u) {
-      int x;
-      mp_digit r, mask, shift;
-
-      /* mask */
-      mask = ((mp_digit)1 << b) - 1uL;
+   digs = b / MP_DIGIT_BIT;
+   bits = b % MP_DIGIT_BIT;
+   used = MP_MAX(a->used - digs, 0);
 
-      /* shift for lsb */
-      shift = (mp_digit)(MP_DIGIT_BIT - b);
+   if ((err = mp_grow(c, used)) != MP_OKAY) {
+      return err;
+   }
+   oldused = c->used;
+
+   /* shift by the digits and the bits in one pass, mpl_rshift goes
+    * from the bottom such that a and c can be the same.
+    */
+   if ((bits != 0) && (used > 0)) {
+      mpl_rshift(a->dp + digs, used, bits, c->dp);
+   } else {
+      s_mp_move_digs(c->dp, a->dp + digs, used);
+   }
+   c->used = used;
+   c->sign = a->sign;
 
-      /* carry */
-      r = 0;
-      for (x = c->used; x --> 0;) {
-         /* get the lower  bits of this word in a temp */
-         mp_digit rr = c->dp[x] & mask;
+   /* zero the digits above the result */
+   s_mp_zero_digs(c->dp + used, oldused - used);
 
-         /* shift the current word and mix in the carry bits from the previous word */
-         c->dp[x] = (c->dp[x] >> b) | (r << shift);
+   mp_clamp(c);
 
-         /* set the carry to the carry bits of the current word found above */
-         r = rr;
+   /* the remainder in place of a */
+   if (d == a) {
+      if ((err = mp_mod_2d(d, b, d)) != MP_OKAY) {
+         return err;
       }
    }
-   mp_clamp(c);
    return MP_OKAY;
 }
 #endif
@@ -7,7 +7,7 @@
 mp_err mp_div_d(const mp_int *a, mp_digit b, mp_int *c, mp_digit *d)
 {
    mp_int  q;
-   mp_word w;
+   mp_digit w;
    mp_err err;
    int ix;
 
@@ -57,19 +57,10 @@ mp_err mp_div_d(const mp_int *a, mp_digit b, mp_int *c, mp_digit *d)
 
    q.used = a->used;
    q.sign = a->sign;
-   w = 0;
-   for (ix = a->used; ix --> 0;) {
-      mp_digit t = 0;
-      w = (w << (mp_word)MP_DIGIT_BIT) | (mp_word)a->dp[ix];
-      if (w >= b) {
-         t = (mp_digit)(w / b);
-         w -= (mp_word)t * (mp_word)b;
-      }
-      q.dp[ix] = t;
-   }
+   w = mpl_divrem_1(a->dp, a->used, b, q.dp);
 
    if (d != NULL) {
-      *d = (mp_digit)w;
+      *d = w;
    }
 
    if (c != NULL) {
@@ -0,0 +1,15 @@
+#include "tommath_private.h"
+#ifdef MP_DIV_ITCH_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* The schoolbook and the recursive division need a few normalized copies of
+ * the operands per level, the products of the recursive division are
+ * covered by mp_mul_itch.
+ */
+size_t mp_div_itch(int asize, int bsize)
+{
+   size_t n = (size_t)MP_MAX(asize, 0) + (size_t)MP_MAX(bsize, 0);
+   return (64u * n) + mp_mul_itch(asize) + 256u;
+}
+#endif
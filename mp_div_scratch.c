@@ -0,0 +1,46 @@
+#include "tommath_private.h"
+#ifdef MP_DIV_SCRATCH_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+mp_err mp_div_scratch(const mp_int *a, const mp_int *b, mp_int *c, mp_int *d, mp_digit *scratch, size_t size)
+{
+   mp_int q, r;
+   mp_err err;
+
+   if ((err = s_mp_scratch_strict_begin(scratch, size)) != MP_OKAY) {
+      return err;
+   }
+
+   /* compute into temporaries, the results are only written at the end */
+   if ((err = s_mp_scratch_init(&q, a->used + 2)) != MP_OKAY) {
+      goto LBL_END;
+   }
+   if ((err = s_mp_scratch_init(&r, b->used + 1)) != MP_OKAY) {
+      goto LBL_Q;
+   }
+   if ((err = mp_div(a, b, &q, &r)) != MP_OKAY) {
+      goto LBL_ERR;
+   }
+
+   /* the results must not be grown into the scratch region */
+   if (((c != NULL) && (c->alloc < q.used)) || ((d != NULL) && (d->alloc < r.used))) {
+      err = MP_MEM;
+      goto LBL_ERR;
+   }
+   if ((c != NULL) && ((err = mp_copy(&q, c)) != MP_OKAY)) {
+      goto LBL_ERR;
+   }
+   if (d != NULL) {
+      err = mp_copy(&r, d);
+   }
+
+LBL_ERR:
+   mp_clear(&r);
+LBL_Q:
+   mp_clear(&q);
+LBL_END:
+   s_mp_scratch_strict_end();
+   return err;
+}
+#endif
@@ -9,5 +9,14 @@
 void mp_exch(mp_int *a, mp_int *b)
 {
    MP_EXCH(mp_int, *a, *b);
+#ifdef MP_INLINE_DIGITS
+   /* inline digits moved with the structure, the pointers have to follow */
+   if (a->dp == b->inl) {
+      a->dp = a->inl;
+   }
+   if (b->dp == a->inl) {
+      b->dp = b->inl;
+   }
+#endif
 }
 #endif
@@ -11,23 +11,26 @@
 mp_err mp_exptmod(const mp_int *G, const mp_int *X, const mp_int *P, mp_int *Y)
 {
    int dr;
+   mp_err err;
 
    /* modulus P must be positive */
    if (mp_isneg(P)) {
       return MP_VAL;
    }
 
+   MP_ALLOC_OP_ENTER(MP_ALLOC_OP_EXPTMOD);
+
    /* if exponent X is negative we have to recurse */
    if (mp_isneg(X)) {
       mp_int tmpG, tmpX;
-      mp_err err;
 
       if (!MP_HAS(MP_INVMOD)) {
-         return MP_VAL;
+         err = MP_VAL;
+         goto LBL_END;
       }
 
       if ((err = mp_init_multi(&tmpG, &tmpX, NULL)) != MP_OKAY) {
-         return err;
+         goto LBL_END;
       }
 
       /* first compute 1/G mod P */
@@ -44,13 +47,15 @@ mp_err mp_exptmod(const mp_int *G, const mp_int *X, const mp_int *P, mp_int *Y)
       err = mp_exptmod(&tmpG, &tmpX, P, Y);
 LBL_ERR:
       mp_clear_multi(&tmpG, &tmpX, NULL);
-      return err;
+      goto LBL_END;
    }
 
    /* modified diminished radix reduction */
    if (MP_HAS(MP_REDUCE_IS_2K_L) && MP_HAS(MP_REDUCE_2K_L) && MP_HAS(S_MP_EXPTMOD) &&
        mp_reduce_is_2k_l(P)) {
-      return s_mp_exptmod(G, X, P, Y, 1);
+      MP_STATS_COUNT(MP_STATS_EXPTMOD_2K_L, P->used);
+      err = s_mp_exptmod(G, X, P, Y, 1);
+      goto LBL_END;
    }
 
    /* is it a DR modulus? default to no */
@@ -63,16 +68,21 @@ LBL_ERR:
 
    /* if the modulus is odd or dr != 0 use the montgomery method */
    if (MP_HAS(S_MP_EXPTMOD_FAST) && (mp_isodd(P) || (dr != 0))) {
-      return s_mp_exptmod_fast(G, X, P, Y, dr);
-   }
-
-   /* otherwise use the generic Barrett reduction technique */
-   if (MP_HAS(S_MP_EXPTMOD)) {
-      return s_mp_exptmod(G, X, P, Y, 0);
+      MP_STATS_COUNT((dr == 0) ? MP_STATS_EXPTMOD_MONTGOMERY : ((dr == 1) ? MP_STATS_EXPTMOD_DR : MP_STATS_EXPTMOD_2K),
+                     P->used);
+      err = s_mp_exptmod_fast(G, X, P, Y, dr);
+   } else if (MP_HAS(S_MP_EXPTMOD)) {
+      /* otherwise use the generic Barrett reduction technique */
+      MP_STATS_COUNT(MP_STATS_EXPTMOD_BARRETT, P->used);
+      err = s_mp_exptmod(G, X, P, Y, 0);
+   } else {
+      /* no exptmod for evens */
+      err = MP_VAL;
    }
 
-   /* no exptmod for evens */
-   return MP_VAL;
+LBL_END:
+   MP_ALLOC_OP_LEAVE();
+   return err;
 }
 
 #endif
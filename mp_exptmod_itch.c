@@ -0,0 +1,16 @@
+#include "tommath_private.h"
+#ifdef MP_EXPTMOD_ITCH_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* The window table has up to 2^7 + 1 entries, each initialized with the
+ * allocated size of P and moved once when it grows to a full product.
+ * The reductions and the inversion of negative exponents are covered by
+ * mp_mul_itch and mp_div_itch.
+ */
+size_t mp_exptmod_itch(const mp_int *P)
+{
+   size_t n = (size_t)P->used, entry = (size_t)MP_MAX(P->alloc, MP_MIN_DIGIT_COUNT) + (2u * n) + 4u;
+   return (130u * entry) + (16u * n) + mp_mul_itch(P->used) + mp_div_itch(2 * P->used, P->used);
+}
+#endif
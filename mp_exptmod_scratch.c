@@ -0,0 +1,33 @@
+#include "tommath_private.h"
+#ifdef MP_EXPTMOD_SCRATCH_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+mp_err mp_exptmod_scratch(const mp_int *G, const mp_int *X, const mp_int *P, mp_int *Y,
+                          mp_digit *scratch, size_t size)
+{
+   mp_int t;
+   mp_err err;
+
+   if ((err = s_mp_scratch_strict_begin(scratch, size)) != MP_OKAY) {
+      return err;
+   }
+
+   /* compute into a temporary, the result is only written at the end */
+   if ((err = s_mp_scratch_init(&t, P->used + 1)) != MP_OKAY) {
+      goto LBL_END;
+   }
+   if ((err = mp_exptmod(G, X, P, &t)) != MP_OKAY) {
+      goto LBL_ERR;
+   }
+
+   /* the result must not be grown into the scratch region */
+   err = (Y->alloc < t.used) ? MP_MEM : mp_copy(&t, Y);
+
+LBL_ERR:
+   mp_clear(&t);
+LBL_END:
+   s_mp_scratch_strict_end();
+   return err;
+}
+#endif
@@ -0,0 +1,32 @@
+#include "tommath_private.h"
+#ifdef MP_FWRITE_LIMBS_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifndef MP_NO_FILE
+/* write a bigint to a file stream in the native limb format,
+ * i.e. a small header followed by the raw digits of a->dp
+ */
+mp_err mp_fwrite_limbs(const mp_int *a, FILE *stream)
+{
+   s_mp_limbs_header h;
+
+   h.magic = MP_LIMBS_MAGIC;
+   h.digit_size = (uint8_t)sizeof(mp_digit);
+   h.digit_bit = (uint8_t)MP_DIGIT_BIT;
+   h.sign = (uint8_t)a->sign;
+   h.reserved = 0u;
+   h.used = (uint64_t)a->used;
+
+   if (fwrite(&h, sizeof(h), 1uL, stream) != 1uL) {
+      return MP_ERR;
+   }
+   if ((a->used > 0) &&
+       (fwrite(a->dp, sizeof(mp_digit), (size_t)a->used, stream) != (size_t)a->used)) {
+      return MP_ERR;
+   }
+   return MP_OKAY;
+}
+#endif
+
+#endif
@@ -18,9 +18,11 @@ mp_err mp_gcd(const mp_int *a, const mp_int *b, mp_int *c)
       return mp_abs(a, c);
    }
 
+   MP_ALLOC_OP_ENTER(MP_ALLOC_OP_GCD);
+
    /* get copies of a and b we can modify */
    if ((err = mp_init_copy(&u, a)) != MP_OKAY) {
-      return err;
+      goto LBL_END;
    }
 
    if ((err = mp_init_copy(&v, b)) != MP_OKAY) {
@@ -87,6 +89,8 @@ LBL_V:
    mp_clear(&u);
 LBL_U:
    mp_clear(&v);
+LBL_END:
+   MP_ALLOC_OP_LEAVE();
    return err;
 }
 #endif
@@ -20,9 +20,18 @@ mp_err mp_grow(mp_int *a, int size)
        * in case the operation failed we don't want
        * to overwrite the dp member of a.
        */
-      dp = (mp_digit *) MP_REALLOC(a->dp,
-                                   (size_t)a->alloc * sizeof(mp_digit),
-                                   (size_t)size * sizeof(mp_digit));
+      if (MP_INLINE_OWNS(a)) {
+         /* spill the inline digits to the heap, they are left intact
+          * for shallow copies of "a" and cleared by mp_clear
+          */
+         if ((dp = s_mp_digs_alloc(&size)) != NULL) {
+            s_mp_copy_digs(dp, a->dp, a->alloc);
+         }
+      } else if (MP_SCRATCH_OWNS(a->dp)) {
+         dp = s_mp_scratch_realloc(a->dp, a->alloc, size);
+      } else {
+         dp = s_mp_digs_realloc(a->dp, a->alloc, &size);
+      }
       if (dp == NULL) {
          /* reallocation failed but "a" is still valid [can be freed] */
          return MP_MEM;
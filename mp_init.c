@@ -6,16 +6,25 @@
 /* init a new mp_int */
 mp_err mp_init(mp_int *a)
 {
+   int size = MP_DEFAULT_DIGIT_COUNT;
+
+#ifdef MP_INLINE_DIGITS
+   /* start with the digits in the structure itself */
+   size = MP_INLINE_DIGITS;
+   a->dp = a->inl;
+   s_mp_zero_digs(a->dp, size);
+#else
    /* allocate memory required and clear it */
-   a->dp = (mp_digit *) MP_CALLOC((size_t)MP_DEFAULT_DIGIT_COUNT, sizeof(mp_digit));
+   a->dp = s_mp_digs_alloc(&size);
    if (a->dp == NULL) {
       return MP_MEM;
    }
+#endif
 
    /* set the used to zero, allocated digits to the default precision
     * and sign to positive */
    a->used  = 0;
-   a->alloc = MP_DEFAULT_DIGIT_COUNT;
+   a->alloc = size;
    a->sign  = MP_ZPOS;
 
    return MP_OKAY;
@@ -13,7 +13,17 @@ mp_err mp_init_size(mp_int *a, int size)
    }
 
    /* alloc mem */
-   a->dp = (mp_digit *) MP_CALLOC((size_t)size, sizeof(mp_digit));
+#ifdef MP_INLINE_DIGITS
+   if (size <= MP_INLINE_DIGITS) {
+      size = MP_INLINE_DIGITS;
+      a->dp = a->inl;
+      s_mp_zero_digs(a->dp, size);
+   } else {
+      a->dp = s_mp_digs_alloc(&size);
+   }
+#else
+   a->dp = s_mp_digs_alloc(&size);
+#endif
    if (a->dp == NULL) {
       return MP_MEM;
    }
@@ -6,6 +6,8 @@
 /* hac 14.61, pp608 */
 mp_err mp_invmod(const mp_int *a, const mp_int *b, mp_int *c)
 {
+   mp_err err;
+
    /* for all n in N and n > 0, n = 0 mod 1 */
    if (!mp_isneg(a) && mp_cmp_d(b, 1uL) == MP_EQ) {
       mp_zero(c);
@@ -17,13 +19,17 @@ mp_err mp_invmod(const mp_int *a, const mp_int *b, mp_int *c)
       return MP_VAL;
    }
 
+   MP_ALLOC_OP_ENTER(MP_ALLOC_OP_INVMOD);
    /* if the modulus is odd we can use a faster routine instead */
    if (MP_HAS(S_MP_INVMOD_ODD) && mp_isodd(b)) {
-      return s_mp_invmod_odd(a, b, c);
+      err = s_mp_invmod_odd(a, b, c);
+   } else {
+      err = MP_HAS(S_MP_INVMOD)
+            ? s_mp_invmod(a, b, c)
+            : MP_VAL;
    }
+   MP_ALLOC_OP_LEAVE();
 
-   return MP_HAS(S_MP_INVMOD)
-          ? s_mp_invmod(a, b, c)
-          : MP_VAL;
+   return err;
 }
 #endif
@@ -7,7 +7,6 @@
 mp_err mp_lshd(mp_int *a, int b)
 {
    mp_err err;
-   int x;
 
    /* if its less than zero return */
    if (b <= 0) {
@@ -26,13 +25,8 @@ mp_err mp_lshd(mp_int *a, int b)
    /* increment the used by the shift amount then copy upwards */
    a->used += b;
 
-   /* much like mp_rshd this is implemented using a sliding window
-    * except the window goes the otherway around.  Copying from
-    * the bottom to the top.  see mp_rshd.c for more info.
-    */
-   for (x = a->used; x --> b;) {
-      a->dp[x] = a->dp[x - b];
-   }
+   /* move the digits up by b places */
+   s_mp_move_digs(a->dp + b, a->dp, a->used - b);
 
    /* zero the lower digits */
    s_mp_zero_digs(a->dp, b);
@@ -0,0 +1,161 @@
+#include "tommath_private.h"
+#ifdef MP_MMAP_LOAD_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifndef MP_NO_FILE
+
+#ifdef MP_HAS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+/* check the header and the digits of a native limb file of "size" bytes */
+static mp_err s_check_limbs(const s_mp_limbs_header *h, const mp_digit *dp, size_t size)
+{
+   int i, used;
+
+   if ((h->magic != MP_LIMBS_MAGIC) ||
+       (h->digit_size != (uint8_t)sizeof(mp_digit)) ||
+       (h->digit_bit != (uint8_t)MP_DIGIT_BIT) ||
+       (h->sign > (uint8_t)MP_NEG) ||
+       (h->used > (uint64_t)MP_MAX_DIGIT_COUNT)) {
+      return MP_VAL;
+   }
+
+   used = (int)h->used;
+   if (size != (sizeof(*h) + ((size_t)used * sizeof(mp_digit)))) {
+      return MP_VAL;
+   }
+
+   if (dp == NULL) {
+      return MP_OKAY;
+   }
+
+   /* the digits must be clamped and must not exceed MP_MASK */
+   if ((used > 0) ? (dp[used - 1] == 0u) : (h->sign != (uint8_t)MP_ZPOS)) {
+      return MP_VAL;
+   }
+   for (i = 0; i < used; ++i) {
+      if (dp[i] > MP_MASK) {
+         return MP_VAL;
+      }
+   }
+   return MP_OKAY;
+}
+
+#ifdef MP_HAS_MMAP
+mp_err mp_mmap_load(mp_int *a, const char *path, bool copy)
+{
+   const s_mp_limbs_header *h;
+   const mp_digit *dp;
+   struct stat st;
+   void *map;
+   size_t size;
+   mp_err err;
+   int fd;
+
+   do {
+      fd = open(path, O_RDONLY);
+   } while ((fd == -1) && (errno == EINTR));
+   if (fd == -1) {
+      return MP_ERR;
+   }
+
+   if ((fstat(fd, &st) != 0) || (st.st_size < (off_t)sizeof(s_mp_limbs_header))) {
+      close(fd);
+      return MP_VAL;
+   }
+
+   size = (size_t)st.st_size;
+   map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (map == MAP_FAILED) {
+      return MP_MEM;
+   }
+
+   h = (const s_mp_limbs_header *)map;
+   dp = (const mp_digit *)(h + 1);
+   if ((err = s_check_limbs(h, dp, size)) != MP_OKAY) {
+      goto LBL_ERR;
+   }
+
+   if (copy) {
+      /* copy the digits over in a single pass */
+      if ((err = mp_grow(a, (int)h->used)) != MP_OKAY) {
+         goto LBL_ERR;
+      }
+      s_mp_copy_digs(a->dp, dp, (int)h->used);
+      s_mp_zero_digs(a->dp + (int)h->used, a->used - (int)h->used);
+      a->used = (int)h->used;
+      a->sign = (mp_sign)h->sign;
+      err = MP_OKAY;
+      goto LBL_ERR;
+   }
+
+   /* wrap the read-only mapping, it must be released by mp_mmap_unload */
+   a->dp    = (mp_digit *)dp;
+   a->used  = a->alloc = (int)h->used;
+   a->sign  = (mp_sign)h->sign;
+   return MP_OKAY;
+
+LBL_ERR:
+   (void)munmap(map, size);
+   return err;
+}
+#else
+/* without mmap the file can only be copied in, using a single fread */
+mp_err mp_mmap_load(mp_int *a, const char *path, bool copy)
+{
+   s_mp_limbs_header h;
+   mp_err err = MP_ERR;
+   long size;
+   FILE *stream;
+
+   if (!copy) {
+      return MP_VAL;
+   }
+
+   if ((stream = fopen(path, "rb")) == NULL) {
+      return MP_ERR;
+   }
+
+   if ((fseek(stream, 0L, SEEK_END) != 0) || ((size = ftell(stream)) < 0L) ||
+       (fseek(stream, 0L, SEEK_SET) != 0)) {
+      goto LBL_ERR;
+   }
+
+   if (fread(&h, sizeof(h), 1uL, stream) != 1uL) {
+      err = MP_VAL;
+      goto LBL_ERR;
+   }
+   if ((err = s_check_limbs(&h, NULL, (size_t)size)) != MP_OKAY) {
+      goto LBL_ERR;
+   }
+
+   mp_zero(a);
+   if ((err = mp_grow(a, (int)h.used)) != MP_OKAY) {
+      goto LBL_ERR;
+   }
+   if (fread(a->dp, sizeof(mp_digit), (size_t)h.used, stream) != (size_t)h.used) {
+      err = MP_ERR;
+      goto LBL_ERR;
+   }
+   a->used = (int)h.used;
+   if ((err = s_check_limbs(&h, a->dp, (size_t)size)) != MP_OKAY) {
+      mp_zero(a);
+      goto LBL_ERR;
+   }
+   a->sign = (mp_sign)h.sign;
+
+LBL_ERR:
+   fclose(stream);
+   return err;
+}
+#endif
+#endif
+
+#endif
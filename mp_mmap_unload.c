@@ -0,0 +1,29 @@
+#include "tommath_private.h"
+#ifdef MP_MMAP_UNLOAD_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifndef MP_NO_FILE
+
+#ifdef MP_HAS_MMAP
+#include <sys/mman.h>
+#endif
+
+/* release an mp_int which has been mapped by mp_mmap_load without copying */
+void mp_mmap_unload(mp_int *a)
+{
+   if (a->dp != NULL) {
+#ifdef MP_HAS_MMAP
+      char *base = (char *)a->dp - sizeof(s_mp_limbs_header);
+      (void)munmap(base, sizeof(s_mp_limbs_header) + ((size_t)a->alloc * sizeof(mp_digit)));
+#endif
+
+      /* reset members to make debugging easier */
+      a->dp    = NULL;
+      a->alloc = a->used = 0;
+      a->sign  = MP_ZPOS;
+   }
+}
+#endif
+
+#endif
@@ -0,0 +1,11 @@
+#include "tommath_private.h"
+#ifdef MP_MOD_MULTI_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* residues[i] = a mod moduli[i] for 0 <= i < n */
+mp_err mp_mod_multi(const mp_int *a, const mp_int *moduli, size_t n, mp_int *residues)
+{
+   return mp_mod_multi_stream(a, moduli, n, residues, MP_MAX(n, 1u));
+}
+#endif
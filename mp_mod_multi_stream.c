@@ -0,0 +1,124 @@
+#include "tommath_private.h"
+#ifdef MP_MOD_MULTI_STREAM_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+typedef struct {
+   const mp_int *below;
+   size_t below_n;
+   mp_int *above;
+} s_mod_multi_up_args;
+
+typedef struct {
+   const mp_int *rem_above;
+   const mp_int *node;
+   mp_int *rem;
+} s_mod_multi_down_args;
+
+/* node i of a level of the product tree is the product of two nodes of the level below */
+static mp_err s_mod_multi_up(const void *args, size_t i)
+{
+   const s_mod_multi_up_args *a = (const s_mod_multi_up_args *)args;
+   if (((2u * i) + 1u) < a->below_n) {
+      return mp_mul(&a->below[2u * i], &a->below[(2u * i) + 1u], &a->above[i]);
+   }
+   return mp_copy(&a->below[2u * i], &a->above[i]);
+}
+
+/* the remainder of a node is the remainder of its parent reduced by the node */
+static mp_err s_mod_multi_down(const void *args, size_t i)
+{
+   const s_mod_multi_down_args *a = (const s_mod_multi_down_args *)args;
+   return mp_mod(&a->rem_above[i / 2u], &a->node[i], &a->rem[i]);
+}
+
+/* residues[i] = a mod moduli[i] for 0 <= i < n, using a product tree of
+ * at most "block" moduli at a time and a remainder tree going down from it.
+ */
+mp_err mp_mod_multi_stream(const mp_int *a, const mp_int *moduli, size_t n, mp_int *residues, size_t block)
+{
+   s_mod_multi_up_args up;
+   s_mod_multi_down_args down;
+   size_t off[MP_SIZEOF_BITS(size_t) + 1u], len[MP_SIZEOF_BITS(size_t) + 1u];
+   size_t i, m, first, nodes, half, depth, level, inited = 0u;
+   mp_int *tree = NULL, *rem = NULL;
+   mp_err err = MP_OKAY;
+
+   if (block == 0u) {
+      return MP_VAL;
+   }
+   for (i = 0u; i < n; i++) {
+      if (mp_iszero(&moduli[i])) {
+         return MP_VAL;
+      }
+   }
+   if (n == 0u) {
+      return MP_OKAY;
+   }
+
+   /* levels above the moduli, level k has ceil(len[k-1]/2) nodes */
+   block = MP_MIN(block, n);
+   len[0] = block;
+   off[0] = 0u;
+   nodes = 0u;
+   for (depth = 0u; len[depth] > 1u; depth++) {
+      len[depth + 1u] = (len[depth] + 1u) / 2u;
+      off[depth + 1u] = nodes;
+      nodes += len[depth + 1u];
+   }
+   half = (block + 1u) / 2u;
+
+   /* the remainders of two neighbouring levels, the remainders of the moduli are the residues */
+   if (nodes > 0u) {
+      tree = (mp_int *) MP_MALLOC(sizeof(mp_int) * (nodes + (2u * half)));
+      if (tree == NULL) {
+         return MP_MEM;
+      }
+      rem = tree + nodes;
+      for (inited = 0u; inited < (nodes + (2u * half)); inited++) {
+         if ((err = mp_init(&tree[inited])) != MP_OKAY) goto LBL_ERR;
+      }
+   }
+
+   for (first = 0u; first < n; first += m) {
+      m = MP_MIN(block, n - first);
+
+      /* the last block can be smaller */
+      len[0] = m;
+      for (depth = 0u; len[depth] > 1u; depth++) {
+         len[depth + 1u] = (len[depth] + 1u) / 2u;
+      }
+
+      /* build the product tree bottom up, a level at a time */
+      for (level = 1u; level <= depth; level++) {
+         up.below = (level == 1u) ? &moduli[first] : &tree[off[level - 1u]];
+         up.below_n = len[level - 1u];
+         up.above = &tree[off[level]];
+         if ((err = s_mp_batch_run(s_mod_multi_up, &up, NULL, len[level])) != MP_OKAY) goto LBL_ERR;
+      }
+
+      if (depth == 0u) {
+         if ((err = mp_mod(a, &moduli[first], &residues[first])) != MP_OKAY) goto LBL_ERR;
+         continue;
+      }
+
+      /* reduce by the root and go down the tree */
+      if ((err = mp_mod(a, &tree[off[depth]], &rem[(depth & 1u) * half])) != MP_OKAY) goto LBL_ERR;
+      for (level = depth; level-- > 0u;) {
+         down.rem_above = &rem[((level + 1u) & 1u) * half];
+         down.node = (level == 0u) ? &moduli[first] : &tree[off[level]];
+         down.rem = (level == 0u) ? &residues[first] : &rem[(level & 1u) * half];
+         if ((err = s_mp_batch_run(s_mod_multi_down, &down, NULL, len[level])) != MP_OKAY) goto LBL_ERR;
+      }
+   }
+
+LBL_ERR:
+   if (tree != NULL) {
+      for (i = 0u; i < inited; i++) {
+         mp_clear(&tree[i]);
+      }
+      MP_FREE_BUF(tree, sizeof(mp_int) * (nodes + (2u * half)));
+   }
+   return err;
+}
+#endif
@@ -45,18 +45,8 @@ mp_err mp_montgomery_reduce(mp_int *x, const mp_int *n, mp_digit rho)
       /* a = a + mu * m * b**i */
 
       /* Multiply and add in place */
-      u = 0;
-      for (iy = 0; iy < n->used; iy++) {
-         /* compute product and sum */
-         mp_word r = ((mp_word)mu * (mp_word)n->dp[iy]) +
-                     (mp_word)u + (mp_word)x->dp[ix + iy];
-
-         /* get carry */
-         u       = (mp_digit)(r >> (mp_word)MP_DIGIT_BIT);
-
-         /* fix digit */
-         x->dp[ix + iy] = (mp_digit)(r & (mp_word)MP_MASK);
-      }
+      u = mpl_addmul_1(n->dp, n->used, mu, x->dp + ix);
+      iy = n->used;
       /* At this point the ix'th digit of x should be zero */
 
       /* propagate carries upwards as required*/
@@ -12,21 +12,36 @@ mp_err mp_mul(const mp_int *a, const mp_int *b, mp_int *c)
        digs = a->used + b->used + 1;
    bool neg = (a->sign != b->sign);
 
+   MP_CUTOFFS_ENV();
+
+   /* grow the result before any temporaries are allocated, such that a
+    * result in the scratch region is not moved above them
+    */
+   MP_ALLOC_OP_ENTER(MP_ALLOC_OP_MUL);
+   if ((err = mp_grow(c, digs)) != MP_OKAY) {
+      goto LBL_END;
+   }
+
    if ((a == b) &&
        MP_HAS(S_MP_SQR_TOOM) && /* use Toom-Cook? */
-       (a->used >= MP_SQR_TOOM_CUTOFF)) {
+       (a->used >= MP_CUTOFF(sqr_toom, SQR_TOOM))) {
+      MP_STATS_COUNT(MP_STATS_SQR_TOOM, a->used);
       err = s_mp_sqr_toom(a, c);
    } else if ((a == b) &&
               MP_HAS(S_MP_SQR_KARATSUBA) &&  /* Karatsuba? */
-              (a->used >= MP_SQR_KARATSUBA_CUTOFF)) {
+              (a->used >= MP_CUTOFF(sqr_karatsuba, SQR_KARATSUBA))) {
+      MP_STATS_COUNT(MP_STATS_SQR_KARATSUBA, a->used);
       err = s_mp_sqr_karatsuba(a, c);
    } else if ((a == b) &&
               MP_HAS(S_MP_SQR_COMBA) && /* can we use the fast comba multiplier? */
               (((a->used * 2) + 1) < MP_WARRAY) &&
-              (a->used < (MP_MAX_COMBA / 2))) {
+              (a->used < (MP_MAX_COMBA / 2)) &&
+              (a->used < MP_CUTOFF(sqr_comba, SQR_COMBA))) {
+      MP_STATS_COUNT(MP_STATS_SQR_COMBA, a->used);
       err = s_mp_sqr_comba(a, c);
    } else if ((a == b) &&
               MP_HAS(S_MP_SQR)) {
+      MP_STATS_COUNT(MP_STATS_SQR_BASECASE, a->used);
       err = s_mp_sqr(a, c);
    } else if (MP_HAS(S_MP_MUL_BALANCE) &&
               /* Check sizes. The smaller one needs to be larger than the Karatsuba cut-off.
@@ -36,16 +51,21 @@ mp_err mp_mul(const mp_int *a, const mp_int *b, mp_int *c)
                * Using it to cut the input into slices small enough for s_mp_mul_comba
                * was actually slower on the author's machine, but YMMV.
                */
-              (min >= MP_MUL_KARATSUBA_CUTOFF) &&
-              ((max / 2) >= MP_MUL_KARATSUBA_CUTOFF) &&
-              /* Not much effect was observed below a ratio of 1:2, but again: YMMV. */
-              (max >= (2 * min))) {
+              (min >= MP_CUTOFF(mul_karatsuba, MUL_KARATSUBA)) &&
+              ((max / 2) >= MP_CUTOFF(mul_karatsuba, MUL_KARATSUBA)) &&
+              /* Not much effect was observed below a ratio of 1:2, but again: YMMV.
+               * "make tune" measures it.
+               */
+              ((max / MP_CUTOFF(mul_balance, MUL_BALANCE)) >= min)) {
+      MP_STATS_COUNT(MP_STATS_MUL_BALANCE, min);
       err = s_mp_mul_balance(a,b,c);
    } else if (MP_HAS(S_MP_MUL_TOOM) &&
-              (min >= MP_MUL_TOOM_CUTOFF)) {
+              (min >= MP_CUTOFF(mul_toom, MUL_TOOM))) {
+      MP_STATS_COUNT(MP_STATS_MUL_TOOM, min);
       err = s_mp_mul_toom(a, b, c);
    } else if (MP_HAS(S_MP_MUL_KARATSUBA) &&
-              (min >= MP_MUL_KARATSUBA_CUTOFF)) {
+              (min >= MP_CUTOFF(mul_karatsuba, MUL_KARATSUBA))) {
+      MP_STATS_COUNT(MP_STATS_MUL_KARATSUBA, min);
       err = s_mp_mul_karatsuba(a, b, c);
    } else if (MP_HAS(S_MP_MUL_COMBA) &&
               /* can we use the fast multiplier?
@@ -55,14 +75,20 @@ mp_err mp_mul(const mp_int *a, const mp_int *b, mp_int *c)
                * digits won't affect carry propagation
                */
               (digs < MP_WARRAY) &&
-              (min <= MP_MAX_COMBA)) {
+              (min <= MP_MAX_COMBA) &&
+              /* and it is faster than the baseline */
+              (min < MP_CUTOFF(mul_comba, MUL_COMBA))) {
+      MP_STATS_COUNT(MP_STATS_MUL_COMBA, min);
       err = s_mp_mul_comba(a, b, c, digs);
    } else if (MP_HAS(S_MP_MUL)) {
+      MP_STATS_COUNT(MP_STATS_MUL_BASECASE, min);
       err = s_mp_mul(a, b, c, digs);
    } else {
       err = MP_VAL;
    }
    c->sign = ((c->used > 0) && neg) ? MP_NEG : MP_ZPOS;
+LBL_END:
+   MP_ALLOC_OP_LEAVE();
    return err;
 }
 #endif
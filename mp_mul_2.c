@@ -7,8 +7,7 @@
 mp_err mp_mul_2(const mp_int *a, mp_int *b)
 {
    mp_err err;
-   int x, oldused;
-   mp_digit r;
+   int oldused;
 
    /* grow to accomodate result */
    if ((err = mp_grow(b, a->used + 1)) != MP_OKAY) {
@@ -18,27 +17,8 @@ mp_err mp_mul_2(const mp_int *a, mp_int *b)
    oldused = b->used;
    b->used = a->used;
 
-   /* carry */
-   r = 0;
-   for (x = 0; x < a->used; x++) {
-
-      /* get what will be the *next* carry bit from the
-       * MSB of the current digit
-       */
-      mp_digit rr = a->dp[x] >> (mp_digit)(MP_DIGIT_BIT - 1);
-
-      /* now shift up this digit, add in the carry [from the previous] */
-      b->dp[x] = ((a->dp[x] << 1uL) | r) & MP_MASK;
-
-      /* copy the carry that would be from the source
-       * digit into the next iteration
-       */
-      r = rr;
-   }
-
-   /* new leading digit? */
-   if (r != 0u) {
-      /* add a MSB which is always 1 at this point */
+   /* shift up the digits, a new leading digit is always 1 */
+   if ((b->used > 0) && (mpl_lshift(a->dp, a->used, 1, b->dp) != 0u)) {
       b->dp[b->used++] = 1;
    }
 
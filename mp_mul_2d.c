@@ -6,57 +6,42 @@
 /* shift left by a certain bit count */
 mp_err mp_mul_2d(const mp_int *a, int b, mp_int *c)
 {
+   int digs, oldused;
    mp_err err;
 
    if (b < 0) {
       return MP_VAL;
    }
 
-   if ((err = mp_copy(a, c)) != MP_OKAY) {
-      return err;
+   if (mp_iszero(a)) {
+      mp_zero(c);
+      return MP_OKAY;
    }
 
-   if ((err = mp_grow(c, c->used + (b / MP_DIGIT_BIT) + 1)) != MP_OKAY) {
+   digs = b / MP_DIGIT_BIT;
+   b %= MP_DIGIT_BIT;
+
+   if ((err = mp_grow(c, a->used + digs + 1)) != MP_OKAY) {
       return err;
    }
-
-   /* shift by as many digits in the bit count */
-   if (b >= MP_DIGIT_BIT) {
-      if ((err = mp_lshd(c, b / MP_DIGIT_BIT)) != MP_OKAY) {
-         return err;
-      }
+   oldused = c->used;
+
+   /* shift by the digits and the bits in one pass, mpl_lshift goes
+    * from the top such that a and c can be the same.
+    */
+   if (b != 0) {
+      c->dp[a->used + digs] = mpl_lshift(a->dp, a->used, b, c->dp + digs);
+      c->used = a->used + digs + 1;
+   } else {
+      s_mp_move_digs(c->dp + digs, a->dp, a->used);
+      c->used = a->used + digs;
    }
+   c->sign = a->sign;
 
-   /* shift any bit count < MP_DIGIT_BIT */
-   b %= MP_DIGIT_BIT;
-   if (b != 0u) {
-      mp_digit shift, mask, r;
-      int x;
-
-      /* bitmask for carries */
-      mask = ((mp_digit)1 << b) - (mp_digit)1;
+   /* zero the digits shifted in and those above the result */
+   s_mp_zero_digs(c->dp, digs);
+   s_mp_zero_digs(c->dp + c->used, oldused - c->used);
 
-      /* shift for msbs */
-      shift = (mp_digit)(MP_DIGIT_BIT - b);
-
-      /* carry */
-      r    = 0;
-      for (x = 0; x < c->used; x++) {
-         /* get the higher bits of the current word */
-         mp_digit rr = (c->dp[x] >> shift) & mask;
-
-         /* shift the current word and OR in the carry */
-         c->dp[x] = ((c->dp[x] << b) | r) & MP_MASK;
-
-         /* set the carry to the carry bits of the current word */
-         r = rr;
-      }
-
-      /* set final carry */
-      if (r != 0u) {
-         c->dp[(c->used)++] = r;
-      }
-   }
    mp_clamp(c);
    return MP_OKAY;
 }
@@ -6,7 +6,6 @@
 /* multiply by a digit */
 mp_err mp_mul_d(const mp_int *a, mp_digit b, mp_int *c)
 {
-   mp_digit u;
    mp_err   err;
    int   ix, oldused;
 
@@ -37,23 +36,8 @@ mp_err mp_mul_d(const mp_int *a, mp_digit b, mp_int *c)
    /* set the sign */
    c->sign = a->sign;
 
-   /* zero carry */
-   u = 0;
-
-   /* compute columns */
-   for (ix = 0; ix < a->used; ix++) {
-      /* compute product and carry sum for this term */
-      mp_word r       = (mp_word)u + ((mp_word)a->dp[ix] * (mp_word)b);
-
-      /* mask off higher bits to get a single digit */
-      c->dp[ix] = (mp_digit)(r & (mp_word)MP_MASK);
-
-      /* send carry into next iteration */
-      u       = (mp_digit)(r >> (mp_word)MP_DIGIT_BIT);
-   }
-
-   /* store final carry [if any] and increment ix offset  */
-   c->dp[ix] = u;
+   /* compute columns and store the final carry [if any] */
+   c->dp[a->used] = mpl_mul_1(a->dp, a->used, b, c->dp);
 
    /* set used count */
    c->used = a->used + 1;
@@ -0,0 +1,20 @@
+#include "tommath_private.h"
+#ifdef MP_MUL_ITCH_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* Each level of Karatsuba or Toom-Cook multiplication needs temporaries of
+ * less than eight times the operand size, each of which may be moved once
+ * when it grows. The operands of the next level have at most half the size.
+ * This does not depend on the cutoffs.
+ */
+size_t mp_mul_itch(int size)
+{
+   size_t n = (size_t)MP_MAX(size, MP_MIN_DIGIT_COUNT), itch = (2u * n) + 2u;
+   while (n > 4u) {
+      itch += (16u * n) + 64u;
+      n = (n / 2u) + 2u;
+   }
+   return itch + 64u;
+}
+#endif
@@ -0,0 +1,32 @@
+#include "tommath_private.h"
+#ifdef MP_MUL_SCRATCH_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+mp_err mp_mul_scratch(const mp_int *a, const mp_int *b, mp_int *c, mp_digit *scratch, size_t size)
+{
+   mp_int t;
+   mp_err err;
+
+   if ((err = s_mp_scratch_strict_begin(scratch, size)) != MP_OKAY) {
+      return err;
+   }
+
+   /* compute into a temporary, the result is only written at the end */
+   if ((err = s_mp_scratch_init(&t, a->used + b->used + 1)) != MP_OKAY) {
+      goto LBL_END;
+   }
+   if ((err = mp_mul(a, b, &t)) != MP_OKAY) {
+      goto LBL_ERR;
+   }
+
+   /* the result must not be grown into the scratch region */
+   err = (c->alloc < t.used) ? MP_MEM : mp_copy(&t, c);
+
+LBL_ERR:
+   mp_clear(&t);
+LBL_END:
+   s_mp_scratch_strict_end();
+   return err;
+}
+#endif
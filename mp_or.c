@@ -6,11 +6,33 @@
 /* two complement or */
 mp_err mp_or(const mp_int *a, const mp_int *b, mp_int *c)
 {
-   int used = MP_MAX(a->used, b->used) + 1, i;
+   int used, oldused = c->used, i;
    mp_err err;
    mp_digit ac = 1, bc = 1, cc = 1;
    bool neg = (mp_isneg(a) || mp_isneg(b));
 
+   /* without negative operands nothing has to be converted,
+    * the digits of the longer operand above the other are copied
+    */
+   if (!mp_isneg(a) && !mp_isneg(b)) {
+      const mp_int *x = (a->used >= b->used) ? a : b, *y = (x == a) ? b : a;
+      if ((err = mp_grow(c, x->used)) != MP_OKAY) {
+         return err;
+      }
+      for (i = 0; i < y->used; i++) {
+         c->dp[i] = x->dp[i] | y->dp[i];
+      }
+      if (c != x) {
+         s_mp_copy_digs(c->dp + i, x->dp + i, x->used - i);
+      }
+      c->used = x->used;
+      c->sign = MP_ZPOS;
+      s_mp_zero_digs(c->dp + c->used, oldused - c->used);
+      mp_clamp(c);
+      return MP_OKAY;
+   }
+
+   used = MP_MAX(a->used, b->used) + 1;
    if ((err = mp_grow(c, used)) != MP_OKAY) {
       return err;
    }
@@ -68,7 +68,9 @@ mp_err mp_prime_is_prime(const mp_int *a, int t, bool *result)
    /*
        Run the Miller-Rabin test with base 2 for the BPSW test.
     */
+   MP_ALLOC_OP_ENTER(MP_ALLOC_OP_PRIME);
    if ((err = mp_init_set(&b, 2uL)) != MP_OKAY) {
+      MP_ALLOC_OP_LEAVE();
       return err;
    }
 
@@ -276,6 +278,7 @@ mp_err mp_prime_is_prime(const mp_int *a, int t, bool *result)
    *result = true;
 LBL_B:
    mp_clear(&b);
+   MP_ALLOC_OP_LEAVE();
    return err;
 }
 
@@ -3,44 +3,15 @@
 /* LibTomMath, multiple-precision integer library -- Tom St Denis */
 /* SPDX-License-Identifier: Unlicense */
 
-mp_err(*s_mp_rand_source)(void *out, size_t size) = s_mp_rand_platform;
+mp_err(*s_mp_rand_source)(void *out, size_t size) = s_mp_rand_chacha;
 
 void mp_rand_source(mp_err(*source)(void *out, size_t size))
 {
-   s_mp_rand_source = (source == NULL) ? s_mp_rand_platform : source;
+   s_mp_rand_source = (source == NULL) ? s_mp_rand_chacha : source;
 }
 
 mp_err mp_rand(mp_int *a, int digits)
 {
-   int i;
-   mp_err err;
-
-   mp_zero(a);
-
-   if (digits <= 0) {
-      return MP_OKAY;
-   }
-
-   if ((err = mp_grow(a, digits)) != MP_OKAY) {
-      return err;
-   }
-
-   if ((err = s_mp_rand_source(a->dp, (size_t)digits * sizeof(mp_digit))) != MP_OKAY) {
-      return err;
-   }
-
-   /* TODO: We ensure that the highest digit is nonzero. Should this be removed? */
-   while ((a->dp[digits - 1] & MP_MASK) == 0u) {
-      if ((err = s_mp_rand_source(a->dp + digits - 1, sizeof(mp_digit))) != MP_OKAY) {
-         return err;
-      }
-   }
-
-   a->used = digits;
-   for (i = 0; i < digits; ++i) {
-      a->dp[i] &= MP_MASK;
-   }
-
-   return MP_OKAY;
+   return mp_rand_ex(NULL, a, digits);
 }
 #endif
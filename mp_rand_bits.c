@@ -0,0 +1,45 @@
+#include "tommath_private.h"
+#ifdef MP_RAND_BITS_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+mp_err mp_rand_bits(mp_rng *rng, mp_int *a, int bits)
+{
+   int digits;
+   mp_err err;
+
+   if (bits < 0) {
+      return MP_VAL;
+   }
+   if (bits > (MP_MAX_DIGIT_COUNT * MP_DIGIT_BIT)) {
+      return MP_OVF;
+   }
+
+   /* rounded up without overflowing near the bound */
+   digits = (bits / MP_DIGIT_BIT) + (((bits % MP_DIGIT_BIT) != 0) ? 1 : 0);
+
+   mp_zero(a);
+
+   if (bits == 0) {
+      return MP_OKAY;
+   }
+
+   if ((err = mp_grow(a, digits)) != MP_OKAY) {
+      return err;
+   }
+
+   if ((err = s_mp_rand_digs(rng, a->dp, digits)) != MP_OKAY) {
+      return err;
+   }
+
+   /* cut the top digit down to the remaining bits */
+   if ((bits % MP_DIGIT_BIT) != 0) {
+      a->dp[digits - 1] &= ((mp_digit)1 << (bits % MP_DIGIT_BIT)) - 1u;
+   }
+
+   a->used = digits;
+   mp_clamp(a);
+
+   return MP_OKAY;
+}
+#endif
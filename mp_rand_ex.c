@@ -0,0 +1,35 @@
+#include "tommath_private.h"
+#ifdef MP_RAND_EX_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+mp_err mp_rand_ex(mp_rng *rng, mp_int *a, int digits)
+{
+   mp_err err;
+
+   mp_zero(a);
+
+   if (digits <= 0) {
+      return MP_OKAY;
+   }
+
+   if ((err = mp_grow(a, digits)) != MP_OKAY) {
+      return err;
+   }
+
+   if ((err = s_mp_rand_digs(rng, a->dp, digits)) != MP_OKAY) {
+      return err;
+   }
+
+   /* the result has exactly "digits" digits, the highest one is drawn until it is nonzero */
+   while (a->dp[digits - 1] == 0u) {
+      if ((err = s_mp_rand_digs(rng, a->dp + digits - 1, 1)) != MP_OKAY) {
+         return err;
+      }
+   }
+
+   a->used = digits;
+
+   return MP_OKAY;
+}
+#endif
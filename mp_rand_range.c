@@ -0,0 +1,39 @@
+#include "tommath_private.h"
+#ifdef MP_RAND_RANGE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+mp_err mp_rand_range(mp_rng *rng, mp_int *a, const mp_int *n)
+{
+   mp_int t;
+   const mp_int *m = n;
+   mp_err err;
+   int bits;
+
+   if (mp_isneg(n) || mp_iszero(n)) {
+      return MP_VAL;
+   }
+
+   /* keep the bound if it is overwritten */
+   if (a == n) {
+      if ((err = mp_init_copy(&t, n)) != MP_OKAY) {
+         return err;
+      }
+      m = &t;
+   }
+
+   /* rejection sampling, less than two rounds on average */
+   bits = mp_count_bits(m);
+   do {
+      if ((err = mp_rand_bits(rng, a, bits)) != MP_OKAY) {
+         goto LBL_ERR;
+      }
+   } while (mp_cmp_mag(a, m) != MP_LT);
+
+LBL_ERR:
+   if (m == &t) {
+      mp_clear(&t);
+   }
+   return err;
+}
+#endif
@@ -48,7 +48,14 @@ mp_err mp_reduce(mp_int *x, const mp_int *m, const mp_int *mu)
    }
 
    /* q = q * m mod b**(k+1), quick (no division) */
-   if ((err = s_mp_mul(&q, m, &q, um + 1)) != MP_OKAY) {
+   if (MP_HAS(S_MP_MUL_COMBA) &&
+       ((um + 1) < MP_WARRAY) &&
+       (MP_MIN(q.used, m->used) < MP_MAX_COMBA)) {
+      err = s_mp_mul_comba(&q, m, &q, um + 1);
+   } else {
+      err = s_mp_mul(&q, m, &q, um + 1);
+   }
+   if (err != MP_OKAY) {
       goto LBL_ERR;
    }
 
@@ -0,0 +1,30 @@
+#include "tommath_private.h"
+#ifdef MP_RNG_BYTES_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+void mp_rng_bytes(mp_rng *rng, void *out, size_t size)
+{
+   uint8_t *q = (uint8_t *)out;
+
+   while (size > 0u) {
+      const uint8_t *src;
+      if (rng->avail == 0u) {
+         /* 64 bit block counter in the words 12 and 13, the stream in 14 and 15 */
+         uint32_t nonce[3];
+         nonce[0] = (uint32_t)(rng->block >> 32);
+         nonce[1] = (uint32_t)(rng->stream & 0xFFFFFFFFuL);
+         nonce[2] = (uint32_t)(rng->stream >> 32);
+         s_mp_chacha20_block(rng->key, (uint32_t)(rng->block & 0xFFFFFFFFuL), nonce, rng->buf);
+         rng->block++;
+         rng->avail = (unsigned int)sizeof(rng->buf);
+      }
+      src = rng->buf + (sizeof(rng->buf) - rng->avail);
+      while ((size > 0u) && (rng->avail > 0u)) {
+         *q++ = *src++;
+         rng->avail--;
+         size--;
+      }
+   }
+}
+#endif
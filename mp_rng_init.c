@@ -0,0 +1,18 @@
+#include "tommath_private.h"
+#ifdef MP_RNG_INIT_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+void mp_rng_init(mp_rng *rng, uint64_t seed, uint64_t stream)
+{
+   int i;
+   rng->key[0] = (uint32_t)(seed & 0xFFFFFFFFuL);
+   rng->key[1] = (uint32_t)(seed >> 32);
+   for (i = 2; i < 8; i++) {
+      rng->key[i] = 0u;
+   }
+   rng->stream = stream;
+   rng->block = 0u;
+   rng->avail = 0u;
+}
+#endif
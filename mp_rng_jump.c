@@ -0,0 +1,12 @@
+#include "tommath_private.h"
+#ifdef MP_RNG_JUMP_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+void mp_rng_jump(mp_rng *rng, uint64_t blocks)
+{
+   /* the buffered rest of the current block is dropped */
+   rng->block += blocks;
+   rng->avail = 0u;
+}
+#endif
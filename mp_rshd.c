@@ -6,8 +6,6 @@
 /* shift right a certain amount of digits */
 void mp_rshd(mp_int *a, int b)
 {
-   int x;
-
    /* if b <= 0 then ignore it */
    if (b <= 0) {
       return;
@@ -19,20 +17,8 @@ void mp_rshd(mp_int *a, int b)
       return;
    }
 
-   /* shift the digits down.
-    * this is implemented as a sliding window where
-    * the window is b-digits long and digits from
-    * the top of the window are copied to the bottom
-    *
-    * e.g.
-
-    b-2 | b-1 | b0 | b1 | b2 | ... | bb |   ---->
-                /\                   |      ---->
-                 \-------------------/      ---->
-    */
-   for (x = 0; x < (a->used - b); x++) {
-      a->dp[x] = a->dp[x + b];
-   }
+   /* move the digits down by b places */
+   s_mp_move_digs(a->dp, a->dp + b, a->used - b);
 
    /* zero the top digits */
    s_mp_zero_digs(a->dp + a->used - b, b);
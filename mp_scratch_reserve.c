@@ -0,0 +1,44 @@
+#include "tommath_private.h"
+#ifdef MP_SCRATCH_RESERVE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* reserve a scratch region of at least "size" bytes for the calling thread,
+ * such that temporaries of the following calls are not taken from the heap.
+ * A size of zero releases the region.
+ */
+mp_err mp_scratch_reserve(size_t size)
+{
+#ifdef MP_THREAD_LOCAL
+   size_t digs = (size + (sizeof(mp_digit) - 1u)) / sizeof(mp_digit);
+   mp_digit *base;
+
+   /* the region cannot be moved while it is in use */
+   if (s_mp_scratch.depth != 0) {
+      return MP_VAL;
+   }
+
+   if (digs == 0u) {
+      s_mp_scratch_release();
+      return MP_OKAY;
+   }
+
+   if (digs <= s_mp_scratch.size) {
+      return MP_OKAY;
+   }
+
+   base = (mp_digit *) MP_MALLOC(digs * sizeof(mp_digit));
+   if (base == NULL) {
+      return MP_MEM;
+   }
+
+   s_mp_scratch_release();
+   s_mp_scratch.base = base;
+   s_mp_scratch.size = digs;
+   s_mp_thread_atexit();
+   return MP_OKAY;
+#else
+   return (size == 0u) ? MP_OKAY : MP_ERR;
+#endif
+}
+#endif
@@ -0,0 +1,34 @@
+#include "tommath_private.h"
+#ifdef MP_SET_ALLOCATOR_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+mp_err mp_set_allocator(const mp_allocator *allocator)
+{
+#ifdef MP_RUNTIME_ALLOCATOR
+   if (allocator == NULL) {
+      allocator = &s_mp_allocator_default;
+   }
+
+   if ((allocator->malloc_fn == NULL) || (allocator->realloc_fn == NULL) || (allocator->free_fn == NULL)) {
+      return MP_VAL;
+   }
+
+   /* cached digits belong to the previous allocator, the batch workers
+    * flush their caches when they exit and are started again on demand
+    */
+   s_mp_batch_stop();
+   mp_digit_cache_flush();
+
+   s_mp_allocator.malloc_fn  = allocator->malloc_fn;
+   s_mp_allocator.realloc_fn = allocator->realloc_fn;
+   s_mp_allocator.free_fn    = allocator->free_fn;
+   s_mp_allocator.ctx        = allocator->ctx;
+   return MP_OKAY;
+#else
+   /* the heap functions have been fixed at compile time */
+   (void)allocator;
+   return MP_ERR;
+#endif
+}
+#endif
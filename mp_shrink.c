@@ -7,10 +7,26 @@
 mp_err mp_shrink(mp_int *a)
 {
    int alloc = MP_MAX(MP_MIN_DIGIT_COUNT, a->used);
+
+   /* inline digits cannot shrink, digits of the scratch region are released with their scope */
+   if (MP_INLINE_OWNS(a) || MP_SCRATCH_OWNS(a->dp)) {
+      return MP_OKAY;
+   }
+
+#ifdef MP_INLINE_DIGITS
+   /* move small values back into the structure */
+   if (a->used <= MP_INLINE_DIGITS) {
+      s_mp_copy_digs(a->inl, a->dp, a->used);
+      s_mp_zero_digs(a->inl + a->used, MP_INLINE_DIGITS - a->used);
+      s_mp_digs_free(a->dp, a->alloc);
+      a->dp    = a->inl;
+      a->alloc = MP_INLINE_DIGITS;
+      return MP_OKAY;
+   }
+#endif
+
    if (a->alloc != alloc) {
-      mp_digit *dp = (mp_digit *) MP_REALLOC(a->dp,
-                                             (size_t)a->alloc * sizeof(mp_digit),
-                                             (size_t)alloc * sizeof(mp_digit));
+      mp_digit *dp = s_mp_digs_realloc(a->dp, a->alloc, &alloc);
       if (dp == NULL) {
          return MP_MEM;
       }
@@ -7,15 +7,20 @@
 mp_err mp_signed_rsh(const mp_int *a, int b, mp_int *c)
 {
    mp_err err;
-   if (!mp_isneg(a)) {
+   bool inexact;
+
+   if (!mp_isneg(a) || (b <= 0)) {
       return mp_div_2d(a, b, c, NULL);
    }
 
-   if ((err = mp_add_d(a, 1uL, c)) != MP_OKAY) {
+   /* rounding towards minus infinity takes one more from the
+    * truncated quotient if any of the shifted out bits was set
+    */
+   inexact = (mp_cnt_lsb(a) < b);
+
+   if ((err = mp_div_2d(a, b, c, NULL)) != MP_OKAY) {
       return err;
    }
-
-   err = mp_div_2d(c, b, c, NULL);
-   return (err == MP_OKAY) ? mp_sub_d(c, 1uL, c) : err;
+   return inexact ? mp_sub_d(c, 1u, c) : MP_OKAY;
 }
 #endif
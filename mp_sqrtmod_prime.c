@@ -25,7 +25,11 @@ mp_err mp_sqrtmod_prime(const mp_int *n, const mp_int *prime, mp_int *ret)
    if ((err = mp_kronecker(n, prime, &legendre)) != MP_OKAY)        return err;
    if (legendre == -1)                                           return MP_VAL; /* quadratic non-residue mod prime */
 
-   if ((err = mp_init_multi(&t1, &C, &Q, &S, &Z, &M, &T, &R, &two, NULL)) != MP_OKAY) {
+   MP_ALLOC_OP_ENTER(MP_ALLOC_OP_SQRTMOD);
+   s_mp_scratch_begin();
+   if ((err = s_mp_scratch_init_multi(&t1, &C, &Q, &S, &Z, &M, &T, &R, &two, NULL)) != MP_OKAY) {
+      s_mp_scratch_end();
+      MP_ALLOC_OP_LEAVE();
       return err;
    }
 
@@ -112,6 +116,8 @@ mp_err mp_sqrtmod_prime(const mp_int *n, const mp_int *prime, mp_int *ret)
 
 LBL_END:
    mp_clear_multi(&t1, &C, &Q, &S, &Z, &M, &T, &R, &two, NULL);
+   s_mp_scratch_end();
+   MP_ALLOC_OP_LEAVE();
    return err;
 }
 
@@ -0,0 +1,12 @@
+#include "tommath_private.h"
+#ifdef MP_STATS_RESET_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+void mp_stats_reset(void)
+{
+#ifdef MP_STATS
+   s_mp_zero_buf(&s_mp_stats, sizeof(s_mp_stats));
+#endif
+}
+#endif
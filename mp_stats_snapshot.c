@@ -0,0 +1,16 @@
+#include "tommath_private.h"
+#ifdef MP_STATS_SNAPSHOT_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+mp_err mp_stats_snapshot(mp_stats *stats)
+{
+#ifdef MP_STATS
+   *stats = s_mp_stats;
+   return MP_OKAY;
+#else
+   (void)stats;
+   return MP_ERR;
+#endif
+}
+#endif
@@ -61,11 +61,15 @@ mp_err mp_sub_d(const mp_int *a, mp_digit b, mp_int *c)
       c->used = a->used;
 
       /* subtract digits, mu is carry */
-      for (i = 0; i < a->used; i++) {
+      for (i = 0; (i < a->used) && (mu != 0u); i++) {
          c->dp[i] = a->dp[i] - mu;
          mu = c->dp[i] >> (MP_SIZEOF_BITS(mp_digit) - 1u);
          c->dp[i] &= MP_MASK;
       }
+      /* the digits above the borrow are unchanged */
+      if ((c != a) && (i < a->used)) {
+         s_mp_copy_digs(c->dp + i, a->dp + i, a->used - i);
+      }
    }
 
    /* zero excess digits */
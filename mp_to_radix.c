@@ -45,7 +45,9 @@ mp_err mp_to_radix(const mp_int *a, char *str, size_t maxlen, size_t *written, i
       return MP_OKAY;
    }
 
+   MP_ALLOC_OP_ENTER(MP_ALLOC_OP_TO_RADIX);
    if ((err = mp_init_copy(&t, a)) != MP_OKAY) {
+      MP_ALLOC_OP_LEAVE();
       return err;
    }
 
@@ -89,6 +91,7 @@ mp_err mp_to_radix(const mp_int *a, char *str, size_t maxlen, size_t *written, i
 
 LBL_ERR:
    mp_clear(&t);
+   MP_ALLOC_OP_LEAVE();
    return err;
 }
 
@@ -0,0 +1,31 @@
+#include "tommath_private.h"
+#ifdef MPL_ADD_N_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = a + b for n digits, returns the carry */
+mp_digit mpl_add_n(const mp_digit *a, const mp_digit *b, mp_digit *c, int n)
+{
+   int i;
+   mp_digit u;
+
+   /* long operands are added in blocks, see s_mp_add_digs */
+   if (n >= MP_CARRY_DIGS) {
+      return s_mp_add_digs(a, b, c, n);
+   }
+
+   /* zero the carry */
+   u = 0;
+   for (i = 0; i < n; i++) {
+      /* Compute the sum at one digit, T[i] = A[i] + B[i] + U */
+      c[i] = a[i] + b[i] + u;
+
+      /* U = carry bit of T[i] */
+      u = c[i] >> (mp_digit)MP_DIGIT_BIT;
+
+      /* take away carry bit from T[i] */
+      c[i] &= MP_MASK;
+   }
+   return u;
+}
+#endif
@@ -0,0 +1,26 @@
+#include "tommath_private.h"
+#ifdef MPL_ADDMUL_1_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = c + a * b for n digits, returns the high digit */
+mp_digit mpl_addmul_1(const mp_digit *a, int n, mp_digit b, mp_digit *c)
+{
+   int ix;
+   mp_digit u = 0;
+
+   for (ix = 0; ix < n; ix++) {
+      /* compute the column as a mp_word, it cannot overflow since
+       * (B-1) + (B-1)*(B-1) + (B-1) < B*B
+       */
+      mp_word r = (mp_word)c[ix] + ((mp_word)a[ix] * (mp_word)b) + (mp_word)u;
+
+      /* the new column is the lower part of the result */
+      c[ix] = (mp_digit)(r & (mp_word)MP_MASK);
+
+      /* get the carry word from the result */
+      u = (mp_digit)(r >> (mp_word)MP_DIGIT_BIT);
+   }
+   return u;
+}
+#endif
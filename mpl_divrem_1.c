@@ -0,0 +1,23 @@
+#include "tommath_private.h"
+#ifdef MPL_DIVREM_1_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = a / b for n digits, returns the remainder (based on routine from MPI) */
+mp_digit mpl_divrem_1(const mp_digit *a, int n, mp_digit b, mp_digit *c)
+{
+   mp_word w = 0;
+   int ix;
+
+   for (ix = n; ix --> 0;) {
+      mp_digit t = 0;
+      w = (w << (mp_word)MP_DIGIT_BIT) | (mp_word)a[ix];
+      if (w >= b) {
+         t = (mp_digit)(w / b);
+         w -= (mp_word)t * (mp_word)b;
+      }
+      c[ix] = t;
+   }
+   return (mp_digit)w;
+}
+#endif
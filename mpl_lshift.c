@@ -0,0 +1,22 @@
+#include "tommath_private.h"
+#ifdef MPL_LSHIFT_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = a * 2**b for n digits, returns the bits shifted out */
+mp_digit mpl_lshift(const mp_digit *a, int n, int b, mp_digit *c)
+{
+   mp_digit shift = (mp_digit)(MP_DIGIT_BIT - b), u;
+   int x;
+
+   /* each digit is made of two digits of a and the loop goes from the top,
+    * such that c can be above a
+    */
+   u = a[n - 1] >> shift;
+   for (x = n - 1; x > 0; x--) {
+      c[x] = ((a[x] << b) | (a[x - 1] >> shift)) & MP_MASK;
+   }
+   c[0] = (a[0] << b) & MP_MASK;
+   return u;
+}
+#endif
@@ -0,0 +1,24 @@
+#include "tommath_private.h"
+#ifdef MPL_MUL_1_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = a * b for n digits, returns the high digit */
+mp_digit mpl_mul_1(const mp_digit *a, int n, mp_digit b, mp_digit *c)
+{
+   int ix;
+   mp_digit u = 0;
+
+   for (ix = 0; ix < n; ix++) {
+      /* compute product and carry sum for this term */
+      mp_word r = (mp_word)u + ((mp_word)a[ix] * (mp_word)b);
+
+      /* mask off higher bits to get a single digit */
+      c[ix] = (mp_digit)(r & (mp_word)MP_MASK);
+
+      /* send carry into next iteration */
+      u = (mp_digit)(r >> (mp_word)MP_DIGIT_BIT);
+   }
+   return u;
+}
+#endif
@@ -0,0 +1,16 @@
+#include "tommath_private.h"
+#ifdef MPL_MUL_BASECASE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = a * b, HAC pp. 595, Algorithm 14.12, one row per digit of b */
+void mpl_mul_basecase(const mp_digit *a, int an, const mp_digit *b, int bn, mp_digit *c)
+{
+   int ix;
+
+   c[an] = mpl_mul_1(a, an, b[0], c);
+   for (ix = 1; ix < bn; ix++) {
+      c[an + ix] = mpl_addmul_1(a, an, b[ix], c + ix);
+   }
+}
+#endif
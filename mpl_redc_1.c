@@ -0,0 +1,22 @@
+#include "tommath_private.h"
+#ifdef MPL_REDC_1_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = x/B**n (mod m) via Montgomery Reduction, HAC pp.600, Algorithm 14.32
+ *
+ * The carry of each row is kept in the digit of x the row has zeroed and
+ * they are all added to the upper half at the end.
+ */
+mp_digit mpl_redc_1(mp_digit *x, const mp_digit *m, int n, mp_digit rho, mp_digit *c)
+{
+   int ix;
+
+   for (ix = 0; ix < n; ix++) {
+      /* mu = x[ix] * rho mod B makes x[ix] + mu * m[0] zero */
+      mp_digit mu = (mp_digit)(((mp_word)x[ix] * (mp_word)rho) & MP_MASK);
+      x[ix] = mpl_addmul_1(m, n, mu, x + ix);
+   }
+   return mpl_add_n(x + n, x, c, n);
+}
+#endif
@@ -0,0 +1,22 @@
+#include "tommath_private.h"
+#ifdef MPL_RSHIFT_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = a / 2**b for n digits, returns the bits shifted out */
+mp_digit mpl_rshift(const mp_digit *a, int n, int b, mp_digit *c)
+{
+   mp_digit shift = (mp_digit)(MP_DIGIT_BIT - b), u;
+   int x;
+
+   /* each digit is made of two digits of a and the loop goes from the bottom,
+    * such that c can be below a
+    */
+   u = a[0] & (((mp_digit)1 << b) - 1u);
+   for (x = 0; x < (n - 1); x++) {
+      c[x] = (a[x] >> b) | ((a[x + 1] << shift) & MP_MASK);
+   }
+   c[n - 1] = a[n - 1] >> b;
+   return u;
+}
+#endif
@@ -0,0 +1,48 @@
+#include "tommath_private.h"
+#ifdef MPL_SQR_BASECASE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* b = a * a, HAC pp.596-597, Algorithm 14.16
+ *
+ * The products a[i]*a[j] with i < j are summed once, doubled by a shift
+ * and the squares a[i]*a[i] are added on the diagonal.
+ */
+void mpl_sqr_basecase(const mp_digit *a, int n, mp_digit *b)
+{
+   int ix;
+   mp_digit u;
+
+   if (n == 1) {
+      mp_word r = (mp_word)a[0] * (mp_word)a[0];
+      b[0] = (mp_digit)(r & (mp_word)MP_MASK);
+      b[1] = (mp_digit)(r >> (mp_word)MP_DIGIT_BIT);
+      return;
+   }
+
+   /* the products above the diagonal */
+   b[0] = 0;
+   b[n] = mpl_mul_1(a + 1, n - 1, a[0], b + 1);
+   for (ix = 1; ix < (n - 1); ix++) {
+      b[n + ix] = mpl_addmul_1(a + ix + 1, n - ix - 1, a[ix], b + (2 * ix) + 1);
+   }
+   b[(2 * n) - 1] = 0;
+
+   /* double them, the sum is below a*a/2 so no bit is shifted out */
+   mpl_lshift(b, 2 * n, 1, b);
+
+   /* add the squares */
+   u = 0;
+   for (ix = 0; ix < n; ix++) {
+      mp_word r = (mp_word)a[ix] * (mp_word)a[ix], t;
+
+      t = (mp_word)b[2 * ix] + (r & (mp_word)MP_MASK) + (mp_word)u;
+      b[2 * ix] = (mp_digit)(t & (mp_word)MP_MASK);
+      u = (mp_digit)(t >> (mp_word)MP_DIGIT_BIT);
+
+      t = (mp_word)b[(2 * ix) + 1] + (r >> (mp_word)MP_DIGIT_BIT) + (mp_word)u;
+      b[(2 * ix) + 1] = (mp_digit)(t & (mp_word)MP_MASK);
+      u = (mp_digit)(t >> (mp_word)MP_DIGIT_BIT);
+   }
+}
+#endif
@@ -0,0 +1,35 @@
+#include "tommath_private.h"
+#ifdef MPL_SUB_N_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = a - b for n digits, returns the borrow */
+mp_digit mpl_sub_n(const mp_digit *a, const mp_digit *b, mp_digit *c, int n)
+{
+   int i;
+   mp_digit u;
+
+   /* long operands are subtracted in blocks, see s_mp_sub_digs */
+   if (n >= MP_CARRY_DIGS) {
+      return s_mp_sub_digs(a, b, c, n);
+   }
+
+   /* set carry to zero */
+   u = 0;
+   for (i = 0; i < n; i++) {
+      /* T[i] = A[i] - B[i] - U */
+      c[i] = (a[i] - b[i]) - u;
+
+      /* U = carry bit of T[i]
+       * Note this saves performing an AND operation since
+       * if a carry does occur it will propagate all the way to the
+       * MSB.  As a result a single shift is enough to get the carry
+       */
+      u = c[i] >> (MP_SIZEOF_BITS(mp_digit) - 1u);
+
+      /* Clear carry from T[i] */
+      c[i] &= MP_MASK;
+   }
+   return u;
+}
+#endif
@@ -0,0 +1,25 @@
+#include "tommath_private.h"
+#ifdef MPL_SUBMUL_1_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = c - a * b for n digits, returns the high digit which was borrowed */
+mp_digit mpl_submul_1(const mp_digit *a, int n, mp_digit b, mp_digit *c)
+{
+   int ix;
+   mp_digit u = 0;
+
+   for (ix = 0; ix < n; ix++) {
+      /* the product and the borrow are subtracted in two steps,
+       * the high digit of the product takes the borrow of the digit
+       */
+      mp_word r = ((mp_word)a[ix] * (mp_word)b) + (mp_word)u;
+      mp_digit lo = (mp_digit)(r & (mp_word)MP_MASK);
+      mp_digit d = c[ix] - lo;
+
+      u = (mp_digit)(r >> (mp_word)MP_DIGIT_BIT) + (d >> (MP_SIZEOF_BITS(mp_digit) - 1u));
+      c[ix] = d & MP_MASK;
+   }
+   return u;
+}
+#endif
@@ -29,11 +29,15 @@ mp_err s_mp_add(const mp_int *a, const mp_int *b, mp_int *c)
    oldused = c->used;
    c->used = max + 1;
 
-   /* zero the carry */
-   u = 0;
-   for (i = 0; i < min; i++) {
-      /* Compute the sum at one digit, T[i] = A[i] + B[i] + U */
-      c->dp[i] = a->dp[i] + b->dp[i] + u;
+   /* add the common digits */
+   u = mpl_add_n(a->dp, b->dp, c->dp, min);
+
+   /* now the higher digits of A, the carry stops at
+    * the first digit below MP_MASK and the rest is copied
+    */
+   for (i = min; (i < max) && (u != 0u); i++) {
+      /* T[i] = A[i] + U */
+      c->dp[i] = a->dp[i] + u;
 
       /* U = carry bit of T[i] */
       u = c->dp[i] >> (mp_digit)MP_DIGIT_BIT;
@@ -41,25 +45,12 @@ mp_err s_mp_add(const mp_int *a, const mp_int *b, mp_int *c)
       /* take away carry bit from T[i] */
       c->dp[i] &= MP_MASK;
    }
-
-   /* now copy higher words if any, that is in A+B
-    * if A or B has more digits add those in
-    */
-   if (min != max) {
-      for (; i < max; i++) {
-         /* T[i] = A[i] + U */
-         c->dp[i] = a->dp[i] + u;
-
-         /* U = carry bit of T[i] */
-         u = c->dp[i] >> (mp_digit)MP_DIGIT_BIT;
-
-         /* take away carry bit from T[i] */
-         c->dp[i] &= MP_MASK;
-      }
+   if ((c != a) && (i < max)) {
+      s_mp_copy_digs(c->dp + i, a->dp + i, max - i);
    }
 
    /* add carry */
-   c->dp[i] = u;
+   c->dp[max] = u;
 
    /* clear digits above oldused */
    s_mp_zero_digs(c->dp + c->used, oldused - c->used);
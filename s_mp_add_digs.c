@@ -0,0 +1,42 @@
+#include "tommath_private.h"
+#ifdef S_MP_ADD_DIGS_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = a + b for n digits, returns the carry.
+ *
+ * The carry of a digit is only added to the next digit instead of being
+ * chained through all of them, which leaves the digits of a block
+ * independent of each other such that the compiler can vectorize the loop.
+ * The next digit overflows from this only if it was MP_MASK, in that rare
+ * case the block is walked once more with a chained carry.
+ */
+mp_digit s_mp_add_digs(const mp_digit *a, const mp_digit *b, mp_digit *c, int n)
+{
+   int i, j, m;
+   mp_digit s, u = 0u, o, acc;
+
+   for (i = 0; i < n; i += m) {
+      m = MP_MIN(n - i, MP_CARRY_BLOCK);
+      acc = 0u;
+      for (j = i; j < (i + m); j++) {
+         s = a[j] + b[j];
+         c[j] = (s & MP_MASK) + u;
+         u = s >> MP_DIGIT_BIT;
+         acc |= c[j];
+      }
+
+      if ((acc >> MP_DIGIT_BIT) != 0u) {
+         o = 0u;
+         for (j = i; j < (i + m); j++) {
+            c[j] += o;
+            o = c[j] >> MP_DIGIT_BIT;
+            c[j] &= MP_MASK;
+         }
+         /* a digit which generated a carry cannot overflow from the one it received */
+         u |= o;
+      }
+   }
+   return u;
+}
+#endif
@@ -0,0 +1,11 @@
+#include "tommath_private.h"
+#ifdef S_MP_ALLOC_STATS_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_ALLOC_STATS
+/* heap statistics of the current thread */
+MP_THREAD_LOCAL s_mp_alloc_stats_state s_mp_alloc_stats;
+#endif
+
+#endif
@@ -0,0 +1,15 @@
+#include "tommath_private.h"
+#ifdef S_MP_ALLOC_STATS_FREE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_ALLOC_STATS
+void s_mp_alloc_stats_free(void *mem, size_t size)
+{
+   s_mp_alloc_stats.stats.op[s_mp_alloc_stats.op].frees++;
+   s_mp_alloc_stats.stats.live -= size;
+   MP_HEAP_FREE(mem, size);
+}
+#endif
+
+#endif
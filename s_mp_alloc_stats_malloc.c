@@ -0,0 +1,22 @@
+#include "tommath_private.h"
+#ifdef S_MP_ALLOC_STATS_MALLOC_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_ALLOC_STATS
+void *s_mp_alloc_stats_malloc(size_t size)
+{
+   mp_alloc_counters *c = &s_mp_alloc_stats.stats.op[s_mp_alloc_stats.op];
+   void *mem = MP_HEAP_MALLOC(size);
+
+   if (mem != NULL) {
+      c->allocs++;
+      c->bytes += size;
+      s_mp_alloc_stats.stats.live += size;
+      c->peak = MP_MAX(c->peak, s_mp_alloc_stats.stats.live);
+   }
+   return mem;
+}
+#endif
+
+#endif
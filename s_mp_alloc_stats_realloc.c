@@ -0,0 +1,22 @@
+#include "tommath_private.h"
+#ifdef S_MP_ALLOC_STATS_REALLOC_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_ALLOC_STATS
+void *s_mp_alloc_stats_realloc(void *mem, size_t oldsize, size_t newsize)
+{
+   mp_alloc_counters *c = &s_mp_alloc_stats.stats.op[s_mp_alloc_stats.op];
+   void *p = MP_HEAP_REALLOC(mem, oldsize, newsize);
+
+   if (p != NULL) {
+      c->allocs++;
+      c->bytes += newsize;
+      s_mp_alloc_stats.stats.live += newsize - oldsize;
+      c->peak = MP_MAX(c->peak, s_mp_alloc_stats.stats.live);
+   }
+   return p;
+}
+#endif
+
+#endif
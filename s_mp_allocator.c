@@ -0,0 +1,32 @@
+#include "tommath_private.h"
+#ifdef S_MP_ALLOCATOR_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#include <stdlib.h>
+
+/* default heap functions of the runtime allocator */
+static void *s_malloc(void *ctx, size_t size)
+{
+   (void)ctx;
+   return malloc(size);
+}
+
+static void *s_realloc(void *ctx, void *mem, size_t oldsize, size_t newsize)
+{
+   (void)ctx;
+   (void)oldsize;
+   return realloc(mem, newsize);
+}
+
+static void s_free(void *ctx, void *mem, size_t size)
+{
+   (void)ctx;
+   (void)size;
+   free(mem);
+}
+
+const mp_allocator s_mp_allocator_default = { s_malloc, s_realloc, s_free, NULL };
+mp_allocator s_mp_allocator = { s_malloc, s_realloc, s_free, NULL };
+
+#endif
@@ -0,0 +1,14 @@
+#include "tommath_private.h"
+#ifdef S_MP_BATCH_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_HAS_PTHREAD
+/* worker threads of the batch functions, guarded by s_mp_batch_lock */
+s_mp_batch_pool_state s_mp_batch_pool;
+pthread_mutex_t s_mp_batch_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t s_mp_batch_work_cond = PTHREAD_COND_INITIALIZER,
+               s_mp_batch_idle_cond = PTHREAD_COND_INITIALIZER;
+#endif
+
+#endif
@@ -0,0 +1,58 @@
+#include "tommath_private.h"
+#ifdef S_MP_BATCH_RUN_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* apply "op" to the elements 0 to n-1, together with the workers if the pool is idle */
+mp_err s_mp_batch_run(s_mp_batch_op op, const void *args, mp_err *errs, size_t n)
+{
+   s_mp_batch_job job;
+#ifdef MP_HAS_PTHREAD
+   bool shared = false;
+#endif
+
+   job.op = op;
+   job.args = args;
+   job.errs = errs;
+   job.n = n;
+   job.next = job.done = 0u;
+   job.failed = n;
+   job.err = MP_OKAY;
+   job.workers = 0;
+#if !defined(MP_FIXED_CUTOFFS) && defined(MP_THREAD_LOCAL)
+   job.cutoffs = s_mp_cutoffs_thread;
+#endif
+
+#ifdef MP_HAS_PTHREAD
+   if (n > 1u) {
+      MP_BATCH_LOCK();
+      if ((s_mp_batch_pool.job == NULL) && !s_mp_batch_pool.stop &&
+          (s_mp_batch_start() == MP_OKAY) && (s_mp_batch_pool.threads > 0)) {
+         job.workers = s_mp_batch_pool.threads;
+         s_mp_batch_pool.job = &job;
+         s_mp_batch_pool.gen++;
+         shared = true;
+         (void)pthread_cond_broadcast(&s_mp_batch_work_cond);
+      }
+      MP_BATCH_UNLOCK();
+   }
+#endif
+
+   s_mp_batch_work(&job);
+
+#ifdef MP_HAS_PTHREAD
+   if (shared) {
+      /* the job lives on this stack, wait until no worker uses it anymore */
+      MP_BATCH_LOCK();
+      while ((job.done < n) || (s_mp_batch_pool.busy > 0)) {
+         (void)pthread_cond_wait(&s_mp_batch_idle_cond, &s_mp_batch_lock);
+      }
+      s_mp_batch_pool.job = NULL;
+      (void)pthread_cond_broadcast(&s_mp_batch_idle_cond);
+      MP_BATCH_UNLOCK();
+   }
+#endif
+
+   return job.err;
+}
+#endif
@@ -0,0 +1,109 @@
+#include "tommath_private.h"
+#ifdef S_MP_BATCH_START_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_HAS_PTHREAD
+#include <unistd.h>
+
+static bool s_batch_atfork_done = false;
+
+/* the lock is held over a fork, the workers do not exist in the child */
+static void s_batch_atfork_prepare(void)
+{
+   MP_BATCH_LOCK();
+}
+
+static void s_batch_atfork_parent(void)
+{
+   MP_BATCH_UNLOCK();
+}
+
+static void s_batch_atfork_child(void)
+{
+   s_mp_batch_pool.threads = 0;
+   s_mp_batch_pool.busy = 0;
+   s_mp_batch_pool.stop = false;
+   s_mp_batch_pool.job = NULL;
+   (void)pthread_mutex_init(&s_mp_batch_lock, NULL);
+   (void)pthread_cond_init(&s_mp_batch_work_cond, NULL);
+   (void)pthread_cond_init(&s_mp_batch_idle_cond, NULL);
+}
+
+static void *s_batch_worker(void *arg)
+{
+   s_mp_batch_job *job;
+   unsigned long gen = 0uL;
+
+   if (s_mp_batch_pool.config.start_fn != NULL) {
+      s_mp_batch_pool.config.start_fn(s_mp_batch_pool.config.ctx, (int)(uintptr_t)arg);
+   }
+
+   MP_BATCH_LOCK();
+   for (;;) {
+      while (!s_mp_batch_pool.stop && ((s_mp_batch_pool.job == NULL) || (s_mp_batch_pool.gen == gen))) {
+         (void)pthread_cond_wait(&s_mp_batch_work_cond, &s_mp_batch_lock);
+      }
+      if (s_mp_batch_pool.stop) {
+         break;
+      }
+      gen = s_mp_batch_pool.gen;
+      job = s_mp_batch_pool.job;
+      s_mp_batch_pool.busy++;
+      MP_BATCH_UNLOCK();
+
+#if !defined(MP_FIXED_CUTOFFS) && defined(MP_THREAD_LOCAL)
+      s_mp_cutoffs_thread = job->cutoffs;
+#endif
+      s_mp_batch_work(job);
+
+      MP_BATCH_LOCK();
+      if (--s_mp_batch_pool.busy == 0) {
+         (void)pthread_cond_broadcast(&s_mp_batch_idle_cond);
+      }
+   }
+   MP_BATCH_UNLOCK();
+
+   /* the scratch region and the digit cache are released at the thread exit */
+   return NULL;
+}
+#endif
+
+/* start the configured number of workers unless they are running, called with the lock held */
+mp_err s_mp_batch_start(void)
+{
+#ifdef MP_HAS_PTHREAD
+   int i;
+
+   if (s_mp_batch_pool.threads > 0) {
+      return MP_OKAY;
+   }
+
+   if (!s_batch_atfork_done) {
+      if (pthread_atfork(s_batch_atfork_prepare, s_batch_atfork_parent, s_batch_atfork_child) != 0) {
+         return MP_ERR;
+      }
+      s_batch_atfork_done = true;
+   }
+
+   if (!s_mp_batch_pool.configured) {
+      /* one worker per online processor besides the caller */
+      long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+      s_mp_batch_pool.config.threads = (cpus > 1L) ? (int)MP_MIN(cpus - 1L, (long)MP_BATCH_MAX_THREADS) : 0;
+      s_mp_batch_pool.config.start_fn = NULL;
+      s_mp_batch_pool.config.ctx = NULL;
+   }
+
+   /* run with less workers if not all of them can be created */
+   for (i = 0; i < s_mp_batch_pool.config.threads; i++) {
+      if (pthread_create(&s_mp_batch_pool.thread[i], NULL, s_batch_worker, (void *)(uintptr_t)i) != 0) {
+         break;
+      }
+      s_mp_batch_pool.threads++;
+   }
+   return MP_OKAY;
+#else
+   return MP_ERR;
+#endif
+}
+#endif
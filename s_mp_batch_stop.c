@@ -0,0 +1,31 @@
+#include "tommath_private.h"
+#ifdef S_MP_BATCH_STOP_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* wait for the current batch to finish and stop the workers */
+void s_mp_batch_stop(void)
+{
+#ifdef MP_HAS_PTHREAD
+   int i, threads;
+
+   MP_BATCH_LOCK();
+   while (s_mp_batch_pool.job != NULL) {
+      (void)pthread_cond_wait(&s_mp_batch_idle_cond, &s_mp_batch_lock);
+   }
+   s_mp_batch_pool.stop = true;
+   threads = s_mp_batch_pool.threads;
+   (void)pthread_cond_broadcast(&s_mp_batch_work_cond);
+   MP_BATCH_UNLOCK();
+
+   for (i = 0; i < threads; i++) {
+      (void)pthread_join(s_mp_batch_pool.thread[i], NULL);
+   }
+
+   MP_BATCH_LOCK();
+   s_mp_batch_pool.threads = 0;
+   s_mp_batch_pool.stop = false;
+   MP_BATCH_UNLOCK();
+#endif
+}
+#endif
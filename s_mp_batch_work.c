@@ -0,0 +1,44 @@
+#include "tommath_private.h"
+#ifdef S_MP_BATCH_WORK_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* take chunks of the job until no elements are left. The chunks shrink
+ * with the remaining elements, such that all threads finish at about the
+ * same time even if the elements differ in cost.
+ */
+void s_mp_batch_work(s_mp_batch_job *job)
+{
+   size_t i, first = 0u, last = 0u, chunk;
+   mp_err err;
+
+   for (;;) {
+      MP_BATCH_LOCK();
+      job->done += last - first;
+      if (job->next == job->n) {
+         MP_BATCH_UNLOCK();
+         return;
+      }
+      chunk = (job->n - job->next) / (2u * ((size_t)job->workers + 1u));
+      first = job->next;
+      last = first + MP_MAX(chunk, 1u);
+      job->next = last;
+      MP_BATCH_UNLOCK();
+
+      for (i = first; i < last; i++) {
+         err = job->op(job->args, i);
+         if (job->errs != NULL) {
+            job->errs[i] = err;
+         }
+         if (err != MP_OKAY) {
+            MP_BATCH_LOCK();
+            if (i < job->failed) {
+               job->failed = i;
+               job->err = err;
+            }
+            MP_BATCH_UNLOCK();
+         }
+      }
+   }
+}
+#endif
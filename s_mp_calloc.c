@@ -0,0 +1,21 @@
+#include "tommath_private.h"
+#ifdef S_MP_CALLOC_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* allocate zeroed memory via the runtime allocator */
+void *s_mp_calloc(size_t nmemb, size_t size)
+{
+   void *mem;
+
+   if ((size != 0u) && (nmemb > (SIZE_MAX / size))) {
+      return NULL;
+   }
+
+   mem = MP_MALLOC(nmemb * size);
+   if (mem != NULL) {
+      s_mp_zero_buf(mem, nmemb * size);
+   }
+   return mem;
+}
+#endif
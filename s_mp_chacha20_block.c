@@ -0,0 +1,61 @@
+#include "tommath_private.h"
+#ifdef S_MP_CHACHA20_BLOCK_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* ChaCha20 block function, RFC 8439 section 2.3 */
+
+#define S_ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define S_QUARTERROUND(x, a, b, c, d)                     \
+   do {                                                   \
+      x[a] += x[b]; x[d] ^= x[a]; x[d] = S_ROTL32(x[d], 16); \
+      x[c] += x[d]; x[b] ^= x[c]; x[b] = S_ROTL32(x[b], 12); \
+      x[a] += x[b]; x[d] ^= x[a]; x[d] = S_ROTL32(x[d], 8);  \
+      x[c] += x[d]; x[b] ^= x[c]; x[b] = S_ROTL32(x[b], 7);  \
+   } while (0)
+
+void s_mp_chacha20_block(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3], uint8_t out[64])
+{
+   uint32_t in[16], x[16];
+   int i;
+
+   /* "expand 32-byte k" */
+   in[0] = 0x61707865u;
+   in[1] = 0x3320646eu;
+   in[2] = 0x79622d32u;
+   in[3] = 0x6b206574u;
+   for (i = 0; i < 8; i++) {
+      in[4 + i] = key[i];
+   }
+   in[12] = counter;
+   in[13] = nonce[0];
+   in[14] = nonce[1];
+   in[15] = nonce[2];
+
+   for (i = 0; i < 16; i++) {
+      x[i] = in[i];
+   }
+   for (i = 0; i < 10; i++) {
+      S_QUARTERROUND(x, 0, 4,  8, 12);
+      S_QUARTERROUND(x, 1, 5,  9, 13);
+      S_QUARTERROUND(x, 2, 6, 10, 14);
+      S_QUARTERROUND(x, 3, 7, 11, 15);
+      S_QUARTERROUND(x, 0, 5, 10, 15);
+      S_QUARTERROUND(x, 1, 6, 11, 12);
+      S_QUARTERROUND(x, 2, 7,  8, 13);
+      S_QUARTERROUND(x, 3, 4,  9, 14);
+   }
+
+   /* serialize little endian */
+   for (i = 0; i < 16; i++) {
+      uint32_t v = x[i] + in[i];
+      out[(4 * i) + 0] = (uint8_t)(v & 0xFFu);
+      out[(4 * i) + 1] = (uint8_t)((v >> 8) & 0xFFu);
+      out[(4 * i) + 2] = (uint8_t)((v >> 16) & 0xFFu);
+      out[(4 * i) + 3] = (uint8_t)((v >> 24) & 0xFFu);
+   }
+}
+
+#undef S_QUARTERROUND
+#undef S_ROTL32
+#endif
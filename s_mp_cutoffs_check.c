@@ -0,0 +1,28 @@
+#include "tommath_private.h"
+#ifdef S_MP_CUTOFFS_CHECK_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* MP_VAL if the cutoffs cannot be installed */
+mp_err s_mp_cutoffs_check(const mp_cutoffs *cutoffs)
+{
+   /* Toom-Cook needs at least one digit in each of the three parts, so does
+    * each half of the recursive division
+    */
+   if ((cutoffs->mul_karatsuba < MP_MIN_CUTOFF) || (cutoffs->sqr_karatsuba < MP_MIN_CUTOFF) ||
+       (cutoffs->mul_toom < MP_MIN_CUTOFF) || (cutoffs->sqr_toom < MP_MIN_CUTOFF) ||
+       (cutoffs->div_recursive < (2 * MP_MIN_CUTOFF)) || (cutoffs->mul_balance < 2) ||
+       (cutoffs->mul_comba < 0) || (cutoffs->sqr_comba < 0)) {
+      return MP_VAL;
+   }
+
+   /* the windows grow with the exponent */
+   if ((cutoffs->exptmod_win3 < 0) ||
+       (cutoffs->exptmod_win4 < cutoffs->exptmod_win3) || (cutoffs->exptmod_win5 < cutoffs->exptmod_win4) ||
+       (cutoffs->exptmod_win6 < cutoffs->exptmod_win5) || (cutoffs->exptmod_win7 < cutoffs->exptmod_win6) ||
+       (cutoffs->exptmod_win8 < cutoffs->exptmod_win7)) {
+      return MP_VAL;
+   }
+   return MP_OKAY;
+}
+#endif
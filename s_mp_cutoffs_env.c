@@ -0,0 +1,54 @@
+#include "tommath_private.h"
+#ifdef S_MP_CUTOFFS_ENV_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_HAS_CUTOFFS_ENV
+#include <stdlib.h>
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#include <unistd.h>
+#endif
+
+#ifdef MP_THREAD_LOCAL
+MP_THREAD_LOCAL bool s_mp_cutoffs_env_done;
+#else
+bool s_mp_cutoffs_env_done;
+#endif
+
+static void s_cutoffs_env_load(void)
+{
+   const char *path;
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+   /* as secure_getenv, setuid and setgid programs do not take the path from the environment */
+   if ((getuid() != geteuid()) || (getgid() != getegid())) {
+      return;
+   }
+#endif
+   path = getenv("LTM_CUTOFFS");
+   /* a missing or broken file leaves the compiled-in cutoffs in place */
+   if ((path != NULL) && (*path != '\0')) {
+      (void)s_mp_cutoffs_load(path);
+   }
+}
+
+#ifdef MP_HAS_PTHREAD
+static pthread_once_t s_cutoffs_env_once = PTHREAD_ONCE_INIT;
+#endif
+
+/* load the file of LTM_CUTOFFS at the first use of the cutoffs */
+void s_mp_cutoffs_env(void)
+{
+#ifdef MP_HAS_PTHREAD
+   (void)pthread_once(&s_cutoffs_env_once, s_cutoffs_env_load);
+   /* without a flag per thread every call goes through pthread_once */
+#  ifdef MP_THREAD_LOCAL
+   s_mp_cutoffs_env_done = true;
+#  endif
+#else
+   s_mp_cutoffs_env_done = true;
+   s_cutoffs_env_load();
+#endif
+}
+#endif
+
+#endif
@@ -0,0 +1,26 @@
+#include "tommath_private.h"
+#ifdef S_MP_CUTOFFS_FIELDS_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* the names of the cutoffs in the files of mp_cutoffs_load and mp_cutoffs_save, as printed by etc/tune */
+const s_mp_cutoffs_field s_mp_cutoffs_fields[MP_CUTOFFS_FIELDS] = {
+#define S_FIELD(n, f) { #n "_CUTOFF", offsetof(mp_cutoffs, f) }
+   S_FIELD(MUL_KARATSUBA, mul_karatsuba),
+   S_FIELD(SQR_KARATSUBA, sqr_karatsuba),
+   S_FIELD(MUL_TOOM, mul_toom),
+   S_FIELD(SQR_TOOM, sqr_toom),
+   S_FIELD(MUL_COMBA, mul_comba),
+   S_FIELD(SQR_COMBA, sqr_comba),
+   S_FIELD(MUL_BALANCE, mul_balance),
+   S_FIELD(DIV_RECURSIVE, div_recursive),
+   S_FIELD(EXPTMOD_WIN3, exptmod_win3),
+   S_FIELD(EXPTMOD_WIN4, exptmod_win4),
+   S_FIELD(EXPTMOD_WIN5, exptmod_win5),
+   S_FIELD(EXPTMOD_WIN6, exptmod_win6),
+   S_FIELD(EXPTMOD_WIN7, exptmod_win7),
+   S_FIELD(EXPTMOD_WIN8, exptmod_win8)
+#undef S_FIELD
+};
+
+#endif
@@ -0,0 +1,120 @@
+#include "tommath_private.h"
+#ifdef S_MP_CUTOFFS_LOAD_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#if !defined(MP_FIXED_CUTOFFS) && !defined(MP_NO_FILE)
+#include <string.h>
+
+static bool s_cutoffs_space(char c)
+{
+   return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+}
+
+/* the index of the cutoff "name" of "len" characters, or -1 */
+static int s_cutoffs_field(const char *name, size_t len)
+{
+   int i;
+   size_t k;
+   for (i = 0; i < MP_CUTOFFS_FIELDS; ++i) {
+      const char *s = s_mp_cutoffs_fields[i].name;
+      for (k = 0u; (k < len) && (s[k] == name[k]); ++k) {}
+      if ((k == len) && (s[k] == '\0')) {
+         return i;
+      }
+   }
+   return -1;
+}
+
+/* one "NAME_CUTOFF = value" per line, '#' starts a comment */
+static mp_err s_cutoffs_parse(FILE *stream, mp_cutoffs *cutoffs)
+{
+   char line[128];
+
+   while (fgets(line, (int)sizeof(line), stream) != NULL) {
+      const char *p = line, *name;
+      size_t len;
+      int i, value;
+
+      /* no line of the format is that long or contains a NUL */
+      len = strlen(line);
+      if ((len == 0u) || ((line[len - 1u] != '\n') && (feof(stream) == 0))) {
+         return MP_VAL;
+      }
+
+      while (s_cutoffs_space(*p)) {
+         ++p;
+      }
+      if ((*p == '\0') || (*p == '#')) {
+         continue;
+      }
+
+      name = p;
+      while (((*p >= 'A') && (*p <= 'Z')) || ((*p >= '0') && (*p <= '9')) || (*p == '_')) {
+         ++p;
+      }
+      if ((i = s_cutoffs_field(name, (size_t)(p - name))) < 0) {
+         return MP_VAL;
+      }
+
+      while (s_cutoffs_space(*p)) {
+         ++p;
+      }
+      if (*p++ != '=') {
+         return MP_VAL;
+      }
+      while (s_cutoffs_space(*p)) {
+         ++p;
+      }
+
+      if ((*p < '0') || (*p > '9')) {
+         return MP_VAL;
+      }
+      for (value = 0; (*p >= '0') && (*p <= '9'); ++p) {
+         int d = *p - '0';
+         if (value > ((INT_MAX - d) / 10)) {
+            return MP_VAL;
+         }
+         value = (value * 10) + d;
+      }
+
+      while (s_cutoffs_space(*p)) {
+         ++p;
+      }
+      if (*p != '\0') {
+         return MP_VAL;
+      }
+
+      *(int *)(void *)((char *)cutoffs + s_mp_cutoffs_fields[i].offset) = value;
+   }
+   return (ferror(stream) != 0) ? MP_ERR : MP_OKAY;
+}
+
+/* load the global cutoffs, they are left alone on error */
+mp_err s_mp_cutoffs_load(const char *path)
+{
+   mp_cutoffs cutoffs;
+   mp_err err;
+   FILE *stream;
+
+   if ((stream = fopen(path, "r")) == NULL) {
+      return MP_ERR;
+   }
+
+   /* the cutoffs which are not in the file are kept */
+   s_mp_cutoffs_get_global(&cutoffs);
+   err = s_cutoffs_parse(stream, &cutoffs);
+   fclose(stream);
+   if (err != MP_OKAY) {
+      return err;
+   }
+
+   if ((err = s_mp_cutoffs_check(&cutoffs)) != MP_OKAY) {
+      return err;
+   }
+   s_mp_cutoffs_set_global(&cutoffs);
+   return MP_OKAY;
+}
+#endif
+
+#endif
@@ -0,0 +1,29 @@
+#include "tommath_private.h"
+#ifdef S_MP_CUTOFFS_SET_GLOBAL_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifndef MP_FIXED_CUTOFFS
+/* install checked cutoffs for all threads, the caller makes sure that no other
+ * thread reads them meanwhile
+ */
+void s_mp_cutoffs_set_global(const mp_cutoffs *cutoffs)
+{
+   MP_MUL_KARATSUBA_CUTOFF = cutoffs->mul_karatsuba;
+   MP_SQR_KARATSUBA_CUTOFF = cutoffs->sqr_karatsuba;
+   MP_MUL_TOOM_CUTOFF = cutoffs->mul_toom;
+   MP_SQR_TOOM_CUTOFF = cutoffs->sqr_toom;
+   MP_MUL_COMBA_CUTOFF = cutoffs->mul_comba;
+   MP_SQR_COMBA_CUTOFF = cutoffs->sqr_comba;
+   MP_MUL_BALANCE_CUTOFF = cutoffs->mul_balance;
+   MP_DIV_RECURSIVE_CUTOFF = cutoffs->div_recursive;
+   MP_EXPTMOD_WIN3_CUTOFF = cutoffs->exptmod_win3;
+   MP_EXPTMOD_WIN4_CUTOFF = cutoffs->exptmod_win4;
+   MP_EXPTMOD_WIN5_CUTOFF = cutoffs->exptmod_win5;
+   MP_EXPTMOD_WIN6_CUTOFF = cutoffs->exptmod_win6;
+   MP_EXPTMOD_WIN7_CUTOFF = cutoffs->exptmod_win7;
+   MP_EXPTMOD_WIN8_CUTOFF = cutoffs->exptmod_win8;
+}
+#endif
+
+#endif
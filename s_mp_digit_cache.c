@@ -0,0 +1,11 @@
+#include "tommath_private.h"
+#ifdef S_MP_DIGIT_CACHE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_DIGIT_CACHE
+/* digit cache of the current thread */
+MP_THREAD_LOCAL s_mp_digit_cache_state s_mp_digit_cache;
+#endif
+
+#endif
@@ -0,0 +1,20 @@
+#include "tommath_private.h"
+#ifdef S_MP_DIGIT_CACHE_CLASS_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* smallest size class which holds "size" digits, -1 if there is none */
+int s_mp_digit_cache_class(int size)
+{
+#ifdef MP_DIGIT_CACHE
+   int k = 0;
+   while ((k < MP_DIGIT_CACHE_CLASSES) && ((1 << (k + MP_DIGIT_CACHE_MIN)) < size)) {
+      k++;
+   }
+   return (k < MP_DIGIT_CACHE_CLASSES) ? k : -1;
+#else
+   (void)size;
+   return -1;
+#endif
+}
+#endif
@@ -0,0 +1,34 @@
+#include "tommath_private.h"
+#ifdef S_MP_DIGS_ALLOC_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* allocate zeroed digits, "size" is rounded up to the size class of the digit cache */
+mp_digit *s_mp_digs_alloc(int *size)
+{
+#ifdef MP_DIGIT_CACHE
+   int k = s_mp_digit_cache_class(*size);
+   if ((k >= 0) && !MP_SCRATCH_STRICT) {
+      *size = 1 << (k + MP_DIGIT_CACHE_MIN);
+      if (s_mp_digit_cache.count[k] > 0) {
+         mp_digit *dp = s_mp_digit_cache.slot[k][--s_mp_digit_cache.count[k]];
+         s_mp_digit_cache.stats.hits++;
+         s_mp_digit_cache.stats.bytes -= (size_t)*size * sizeof(mp_digit);
+#ifdef MP_NO_ZERO_ON_FREE
+         /* cached digits are only zeroed on free otherwise */
+         s_mp_zero_digs(dp, *size);
+#endif
+         return dp;
+      }
+   }
+#endif
+   if (MP_SCRATCH_STRICT) {
+      /* never touch the heap while running on a caller supplied region */
+      return s_mp_scratch_alloc(*size);
+   }
+#ifdef MP_DIGIT_CACHE
+   s_mp_digit_cache.stats.misses++;
+#endif
+   return (mp_digit *) MP_CALLOC((size_t)*size, sizeof(mp_digit));
+}
+#endif
@@ -0,0 +1,26 @@
+#include "tommath_private.h"
+#ifdef S_MP_DIGS_FREE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* free digits, buffers of a size class are kept in the digit cache if there is room */
+void s_mp_digs_free(mp_digit *dp, int size)
+{
+#ifdef MP_DIGIT_CACHE
+   int k = s_mp_digit_cache_class(size);
+   if ((k >= 0) && (size == (1 << (k + MP_DIGIT_CACHE_MIN))) &&
+       (s_mp_digit_cache.count[k] < MP_DIGIT_CACHE_DEPTH)) {
+#ifndef MP_NO_ZERO_ON_FREE
+      s_mp_zero_digs(dp, size);
+#endif
+      s_mp_digit_cache.slot[k][s_mp_digit_cache.count[k]++] = dp;
+      s_mp_thread_atexit();
+      s_mp_digit_cache.stats.retained++;
+      s_mp_digit_cache.stats.bytes += (size_t)size * sizeof(mp_digit);
+      return;
+   }
+   s_mp_digit_cache.stats.released++;
+#endif
+   MP_FREE_DIGS(dp, size);
+}
+#endif
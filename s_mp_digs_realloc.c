@@ -0,0 +1,40 @@
+#include "tommath_private.h"
+#ifdef S_MP_DIGS_REALLOC_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* resize digits, "newsize" is rounded up to the size class of the digit cache.
+ * Within the classes the digits move to a buffer of the new class, the excess
+ * digits are not cleared.
+ */
+mp_digit *s_mp_digs_realloc(mp_digit *dp, int oldsize, int *newsize)
+{
+#ifdef MP_DIGIT_CACHE
+   int k = s_mp_digit_cache_class(*newsize);
+   if ((k >= 0) && !MP_SCRATCH_STRICT) {
+      mp_digit *ndp;
+      int size = 1 << (k + MP_DIGIT_CACHE_MIN);
+      if (size == oldsize) {
+         *newsize = size;
+         return dp;
+      }
+      if ((ndp = s_mp_digs_alloc(&size)) == NULL) {
+         return NULL;
+      }
+      s_mp_copy_digs(ndp, dp, MP_MIN(oldsize, size));
+      s_mp_digs_free(dp, oldsize);
+      *newsize = size;
+      return ndp;
+   }
+#endif
+   if (MP_SCRATCH_STRICT) {
+      /* heap digits are never grown while running on a caller supplied region */
+      return NULL;
+   }
+   /* the fixed heap functions do not take the old size */
+   (void)oldsize;
+   return (mp_digit *) MP_REALLOC(dp,
+                                  (size_t)oldsize * sizeof(mp_digit),
+                                  (size_t)*newsize * sizeof(mp_digit));
+}
+#endif
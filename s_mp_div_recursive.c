@@ -20,12 +20,22 @@ static mp_err s_recursion(const mp_int *a, const mp_int *b, mp_int *q, mp_int *r
    mp_int A1, A2, B1, B0, Q1, Q0, R1, R0, t;
    int m = a->used - b->used, k = m/2;
 
-   if (m < (MP_MUL_KARATSUBA_CUTOFF)) {
+   if (m < (MP_CUTOFF(div_recursive, DIV_RECURSIVE) / 2)) {
       return s_mp_div_school(a, b, q, r);
    }
 
-   if ((err = mp_init_multi(&A1, &A2, &B1, &B0, &Q1, &Q0, &R1, &R0, &t, NULL)) != MP_OKAY) {
-      goto LBL_ERR;
+   /* grow the results first, such that they are not moved above the temporaries */
+   if ((err = mp_grow(q, m + 2)) != MP_OKAY) {
+      return err;
+   }
+   if ((err = mp_grow(r, b->used + 1)) != MP_OKAY) {
+      return err;
+   }
+
+   /* the temporaries of each level are released when the level returns */
+   s_mp_scratch_begin();
+   if ((err = s_mp_scratch_init_multi(&A1, &A2, &B1, &B0, &Q1, &Q0, &R1, &R0, &t, NULL)) != MP_OKAY) {
+      goto LBL_SCRATCH;
    }
 
    /* B1 = b / beta^k, B0 = b % beta^k*/
@@ -73,6 +83,8 @@ static mp_err s_recursion(const mp_int *a, const mp_int *b, mp_int *q, mp_int *r
 
 LBL_ERR:
    mp_clear_multi(&A1, &A2, &B1, &B0, &Q1, &Q0, &R1, &R0, &t, NULL);
+LBL_SCRATCH:
+   s_mp_scratch_end();
    return err;
 }
 
@@ -85,8 +97,15 @@ mp_err s_mp_div_recursive(const mp_int *a, const mp_int *b, mp_int *q, mp_int *r
    mp_digit msb_b, msb;
    mp_int A, B, Q, Q1, R, A_div, A_mod;
 
-   if ((err = mp_init_multi(&A, &B, &Q, &Q1, &R, &A_div, &A_mod, NULL)) != MP_OKAY) {
-      goto LBL_ERR;
+   s_mp_scratch_begin();
+
+   /* Q and R are exchanged into the result, so they are taken from the heap */
+   if ((err = mp_init_multi(&Q, &R, NULL)) != MP_OKAY) {
+      goto LBL_SCRATCH;
+   }
+   if ((err = s_mp_scratch_init_multi(&A, &B, &Q1, &A_div, &A_mod, NULL)) != MP_OKAY) {
+      mp_clear_multi(&Q, &R, NULL);
+      goto LBL_SCRATCH;
    }
 
    /* most significant bit of a limb */
@@ -153,6 +172,8 @@ mp_err s_mp_div_recursive(const mp_int *a, const mp_int *b, mp_int *q, mp_int *r
    }
 LBL_ERR:
    mp_clear_multi(&A, &B, &Q, &Q1, &R, &A_div, &A_mod, NULL);
+LBL_SCRATCH:
+   s_mp_scratch_end();
    return err;
 }
 
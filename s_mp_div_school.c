@@ -19,7 +19,8 @@
 mp_err s_mp_div_school(const mp_int *a, const mp_int *b, mp_int *c, mp_int *d)
 {
    mp_int q, x, y, t1, t2;
-   int n, t, i, norm;
+   int n, t, i, j, norm;
+   mp_digit u;
    bool neg;
    mp_err err;
 
@@ -107,19 +108,28 @@ mp_err s_mp_div_school(const mp_int *a, const mp_int *b, mp_int *c, mp_int *d)
          t2.used = 3;
       } while (mp_cmp_mag(&t1, &t2) == MP_GT);
 
-      /* step 3.3 x = x - q{i-t-1} * y * b**{i-t-1} */
-      if ((err = mp_mul_d(&y, q.dp[(i - t) - 1], &t1)) != MP_OKAY)       goto LBL_Y;
-      if ((err = mp_lshd(&t1, (i - t) - 1)) != MP_OKAY)                  goto LBL_Y;
-      if ((err = mp_sub(&x, &t1, &x)) != MP_OKAY)                        goto LBL_Y;
+      /* step 3.3 x = x - q{i-t-1} * y * b**{i-t-1}, in place on the digits of x */
+      u = mpl_submul_1(y.dp, y.used, q.dp[(i - t) - 1], x.dp + ((i - t) - 1));
+      for (j = i; (j < x.used) && (u != 0u); j++) {
+         mp_digit r = x.dp[j] - u;
+         u = r >> (MP_SIZEOF_BITS(mp_digit) - 1u);
+         x.dp[j] = r & MP_MASK;
+      }
 
-      /* if x < 0 then { x = x + y*b**{i-t-1}; q{i-t-1} -= 1; } */
-      if (mp_isneg(&x)) {
-         if ((err = mp_copy(&y, &t1)) != MP_OKAY)                        goto LBL_Y;
-         if ((err = mp_lshd(&t1, (i - t) - 1)) != MP_OKAY)               goto LBL_Y;
-         if ((err = mp_add(&x, &t1, &x)) != MP_OKAY)                     goto LBL_Y;
+      /* if x < 0 then { x = x + y*b**{i-t-1}; q{i-t-1} -= 1; }, the carry
+       * out of the top digit cancels the borrow
+       */
+      if (u != 0u) {
+         u = mpl_add_n(x.dp + ((i - t) - 1), y.dp, x.dp + ((i - t) - 1), y.used);
+         for (j = i; (j < x.used) && (u != 0u); j++) {
+            x.dp[j] += u;
+            u = x.dp[j] >> MP_DIGIT_BIT;
+            x.dp[j] &= MP_MASK;
+         }
 
          q.dp[(i - t) - 1] = (q.dp[(i - t) - 1] - 1uL) & MP_MASK;
       }
+      mp_clamp(&x);
    }
 
    /* now q is the quotient and x is the remainder
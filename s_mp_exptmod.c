@@ -21,21 +21,7 @@ mp_err s_mp_exptmod(const mp_int *G, const mp_int *X, const mp_int *P, mp_int *Y
 
    /* find window size */
    x = mp_count_bits(X);
-   if (x <= 7) {
-      winsize = 2;
-   } else if (x <= 36) {
-      winsize = 3;
-   } else if (x <= 140) {
-      winsize = 4;
-   } else if (x <= 450) {
-      winsize = 5;
-   } else if (x <= 1303) {
-      winsize = 6;
-   } else if (x <= 3529) {
-      winsize = 7;
-   } else {
-      winsize = 8;
-   }
+   winsize = s_mp_exptmod_winsize(x);
 
    winsize = MAX_WINSIZE ? MP_MIN(MAX_WINSIZE, winsize) : winsize;
 
@@ -34,38 +34,26 @@ mp_err s_mp_exptmod_fast(const mp_int *G, const mp_int *X, const mp_int *P, mp_i
 
    /* find window size */
    x = mp_count_bits(X);
-   if (x <= 7) {
-      winsize = 2;
-   } else if (x <= 36) {
-      winsize = 3;
-   } else if (x <= 140) {
-      winsize = 4;
-   } else if (x <= 450) {
-      winsize = 5;
-   } else if (x <= 1303) {
-      winsize = 6;
-   } else if (x <= 3529) {
-      winsize = 7;
-   } else {
-      winsize = 8;
-   }
+   winsize = s_mp_exptmod_winsize(x);
 
    winsize = MAX_WINSIZE ? MP_MIN(MAX_WINSIZE, winsize) : winsize;
 
-   /* init M array */
+   /* init M array, the table does not escape so it lives in the scratch region */
+   s_mp_scratch_begin();
+
    /* init first cell */
-   if ((err = mp_init_size(&M[1], P->alloc)) != MP_OKAY) {
-      return err;
+   if ((err = s_mp_scratch_init(&M[1], P->alloc)) != MP_OKAY) {
+      goto LBL_SCRATCH;
    }
 
    /* now init the second half of the array */
    for (x = 1<<(winsize-1); x < (1 << winsize); x++) {
-      if ((err = mp_init_size(&M[x], P->alloc)) != MP_OKAY) {
+      if ((err = s_mp_scratch_init(&M[x], P->alloc)) != MP_OKAY) {
          for (y = 1<<(winsize-1); y < x; y++) {
             mp_clear(&M[y]);
          }
          mp_clear(&M[1]);
-         return err;
+         goto LBL_SCRATCH;
       }
    }
 
@@ -249,6 +237,8 @@ LBL_M:
    for (x = 1<<(winsize-1); x < (1 << winsize); x++) {
       mp_clear(&M[x]);
    }
+LBL_SCRATCH:
+   s_mp_scratch_end();
    return err;
 }
 #endif
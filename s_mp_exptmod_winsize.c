@@ -0,0 +1,25 @@
+#include "tommath_private.h"
+#ifdef S_MP_EXPTMOD_WINSIZE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* size of the sliding window of s_mp_exptmod and s_mp_exptmod_fast for an exponent of "bits" bits */
+int s_mp_exptmod_winsize(int bits)
+{
+   MP_CUTOFFS_ENV();
+   if (bits < MP_CUTOFF(exptmod_win3, EXPTMOD_WIN3)) {
+      return 2;
+   } else if (bits < MP_CUTOFF(exptmod_win4, EXPTMOD_WIN4)) {
+      return 3;
+   } else if (bits < MP_CUTOFF(exptmod_win5, EXPTMOD_WIN5)) {
+      return 4;
+   } else if (bits < MP_CUTOFF(exptmod_win6, EXPTMOD_WIN6)) {
+      return 5;
+   } else if (bits < MP_CUTOFF(exptmod_win7, EXPTMOD_WIN7)) {
+      return 6;
+   } else if (bits < MP_CUTOFF(exptmod_win8, EXPTMOD_WIN8)) {
+      return 7;
+   }
+   return 8;
+}
+#endif
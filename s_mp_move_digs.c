@@ -0,0 +1,30 @@
+#include "tommath_private.h"
+#ifdef S_MP_MOVE_DIGS_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_USE_MEMOPS
+#  include <string.h>
+#endif
+
+/* like s_mp_copy_digs, but the source and destination may overlap */
+void s_mp_move_digs(mp_digit *d, const mp_digit *s, int digits)
+{
+#ifdef MP_USE_MEMOPS
+   if (digits > 0) {
+      memmove(d, s, (size_t)digits * sizeof(mp_digit));
+   }
+#else
+   if (d < s) {
+      while (digits-- > 0) {
+         *d++ = *s++;
+      }
+   } else {
+      while (digits-- > 0) {
+         d[digits] = s[digits];
+      }
+   }
+#endif
+}
+
+#endif
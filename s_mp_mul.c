@@ -6,6 +6,7 @@
 /* multiplies |a| * |b| and only computes upto digs digits of result
  * HAC pp. 595, Algorithm 14.12  Modified so you can control how
  * many digits of output are created.
+ * This is the baseline, the callers decide whether Comba is used instead.
  */
 mp_err s_mp_mul(const mp_int *a, const mp_int *b, mp_int *c, int digs)
 {
@@ -13,12 +14,6 @@ mp_err s_mp_mul(const mp_int *a, const mp_int *b, mp_int *c, int digs)
    mp_err  err;
    int     pa, ix;
 
-   /* can we use the fast multiplier? */
-   if ((digs < MP_WARRAY) &&
-       (MP_MIN(a->used, b->used) < MP_MAX_COMBA)) {
-      return s_mp_mul_comba(a, b, c, digs);
-   }
-
    if ((err = mp_init_size(&t, digs)) != MP_OKAY) {
       return err;
    }
@@ -27,35 +22,29 @@ mp_err s_mp_mul(const mp_int *a, const mp_int *b, mp_int *c, int digs)
    /* compute the digits of the product directly */
    pa = a->used;
    for (ix = 0; ix < pa; ix++) {
-      int iy, pb;
-      mp_digit u = 0;
+      int pb;
+      mp_digit u;
 
       /* limit ourselves to making digs digits of output */
       pb = MP_MIN(b->used, digs - ix);
 
       /* compute the columns of the output and propagate the carry */
-      for (iy = 0; iy < pb; iy++) {
-         /* compute the column as a mp_word */
-         mp_word r = (mp_word)t.dp[ix + iy] +
-                     ((mp_word)a->dp[ix] * (mp_word)b->dp[iy]) +
-                     (mp_word)u;
-
-         /* the new column is the lower part of the result */
-         t.dp[ix + iy] = (mp_digit)(r & (mp_word)MP_MASK);
+      u = mpl_addmul_1(b->dp, pb, a->dp[ix], t.dp + ix);
 
-         /* get the carry word from the result */
-         u       = (mp_digit)(r >> (mp_word)MP_DIGIT_BIT);
-      }
       /* set carry if it is placed below digs */
-      if ((ix + iy) < digs) {
+      if ((ix + pb) < digs) {
          t.dp[ix + pb] = u;
       }
    }
 
    mp_clamp(&t);
-   mp_exch(&t, c);
+
+   /* copy instead of exchanging, the result keeps the digits it was grown to
+    * by mp_mul and is not moved within the scratch region
+    */
+   err = mp_copy(&t, c);
 
    mp_clear(&t);
-   return MP_OKAY;
+   return err;
 }
 #endif
@@ -15,10 +15,17 @@ mp_err s_mp_mul_balance(const mp_int *a, const mp_int *b, mp_int *c)
    if ((err = mp_init_size(&a0, bsize + 2)) != MP_OKAY) {
       return err;
    }
-   if ((err = mp_init_multi(&tmp, &r, NULL)) != MP_OKAY) {
+   /* both grow up to the size of the result, allocate them at once so that
+    * they are not moved above the temps of the products while shifting
+    */
+   if ((err = mp_init_size(&tmp, a->used + b->used + 1)) != MP_OKAY) {
       mp_clear(&a0);
       return err;
    }
+   if ((err = mp_init_size(&r, a->used + b->used + 1)) != MP_OKAY) {
+      mp_clear_multi(&a0, &tmp, NULL);
+      return err;
+   }
 
    /* Make sure that A is the larger one*/
    if (a->used < b->used) {
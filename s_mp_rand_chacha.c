@@ -0,0 +1,141 @@
+#include "tommath_private.h"
+#ifdef S_MP_RAND_CHACHA_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* Per-thread ChaCha20 generator, the default random source.
+ *
+ * The platform source is only used to seed the key. Each refill of
+ * the buffer produces MP_RAND_CHACHA_BLOCKS blocks, the first 32 bytes
+ * replace the key and the rest is handed out and erased on use, such
+ * that a later compromise of the state does not reveal earlier output.
+ * The key is seeded again after MP_RAND_CHACHA_RESEED bytes and in the
+ * child after a fork.
+ *
+ * Without thread local storage the platform source is used directly.
+ */
+#ifdef MP_THREAD_LOCAL
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+#define S_ATFORK_C
+#include <pthread.h>
+#endif
+
+#ifndef MP_RAND_CHACHA_BLOCKS
+#  define MP_RAND_CHACHA_BLOCKS 16
+#endif
+#ifndef MP_RAND_CHACHA_RESEED
+#  define MP_RAND_CHACHA_RESEED (1uL << 24)
+#endif
+
+typedef struct {
+   uint32_t key[8];
+   uint8_t buf[64 * MP_RAND_CHACHA_BLOCKS];
+   size_t avail;       /* unused bytes at the end of buf */
+   size_t left;        /* bytes until the next reseed */
+   unsigned long gen;  /* fork generation of the seed */
+   bool seeded;
+} s_chacha_ctx;
+
+static MP_THREAD_LOCAL s_chacha_ctx s_chacha;
+
+/* incremented in the child process after each fork */
+static volatile unsigned long s_fork_gen = 0uL;
+
+#ifdef S_ATFORK_C
+static volatile int s_atfork_done = 0;
+static void s_atfork_child(void)
+{
+   s_fork_gen++;
+}
+#endif
+
+static mp_err s_chacha_seed(void)
+{
+   uint8_t seed[32];
+   mp_err err;
+   int i;
+
+#ifdef S_ATFORK_C
+   if (s_atfork_done == 0) {
+      if (pthread_atfork(NULL, NULL, s_atfork_child) != 0) {
+         return MP_ERR;
+      }
+      s_atfork_done = 1;
+   }
+#endif
+   if ((err = s_mp_rand_platform(seed, sizeof(seed))) != MP_OKAY) {
+      return err;
+   }
+   for (i = 0; i < 8; i++) {
+      s_chacha.key[i] = (uint32_t)seed[4 * i]
+                        | ((uint32_t)seed[(4 * i) + 1] << 8)
+                        | ((uint32_t)seed[(4 * i) + 2] << 16)
+                        | ((uint32_t)seed[(4 * i) + 3] << 24);
+   }
+   s_mp_zero_buf(seed, sizeof(seed));
+   s_mp_zero_buf(s_chacha.buf, sizeof(s_chacha.buf));
+   s_chacha.avail = 0u;
+   s_chacha.left = MP_RAND_CHACHA_RESEED;
+   s_chacha.gen = s_fork_gen;
+   s_chacha.seeded = true;
+   return MP_OKAY;
+}
+
+static void s_chacha_refill(void)
+{
+   static const uint32_t nonce[3] = { 0u, 0u, 0u };
+   uint32_t i;
+
+   for (i = 0u; i < (uint32_t)MP_RAND_CHACHA_BLOCKS; i++) {
+      s_mp_chacha20_block(s_chacha.key, i, nonce, s_chacha.buf + (64u * i));
+   }
+   /* fast key erasure: the first 32 bytes are the next key */
+   for (i = 0u; i < 8u; i++) {
+      s_chacha.key[i] = (uint32_t)s_chacha.buf[4u * i]
+                        | ((uint32_t)s_chacha.buf[(4u * i) + 1u] << 8)
+                        | ((uint32_t)s_chacha.buf[(4u * i) + 2u] << 16)
+                        | ((uint32_t)s_chacha.buf[(4u * i) + 3u] << 24);
+   }
+   s_mp_zero_buf(s_chacha.buf, 32u);
+   s_chacha.avail = sizeof(s_chacha.buf) - 32u;
+}
+
+mp_err s_mp_rand_chacha(void *p, size_t n)
+{
+   uint8_t *q = (uint8_t *)p;
+   mp_err err;
+
+   if (!s_chacha.seeded || (s_chacha.gen != s_fork_gen) || (s_chacha.left < n)) {
+      if ((err = s_chacha_seed()) != MP_OKAY) {
+         return err;
+      }
+   }
+   s_chacha.left -= MP_MIN(s_chacha.left, n);
+
+   while (n > 0u) {
+      uint8_t *src;
+      if (s_chacha.avail == 0u) {
+         s_chacha_refill();
+      }
+      /* hand out the buffered bytes and erase them */
+      src = s_chacha.buf + (sizeof(s_chacha.buf) - s_chacha.avail);
+      while ((n > 0u) && (s_chacha.avail > 0u)) {
+         *q++ = *src;
+         *src++ = 0u;
+         s_chacha.avail--;
+         n--;
+      }
+   }
+   return MP_OKAY;
+}
+
+#else
+
+mp_err s_mp_rand_chacha(void *p, size_t n)
+{
+   return s_mp_rand_platform(p, n);
+}
+
+#endif
+#endif
@@ -0,0 +1,33 @@
+#include "tommath_private.h"
+#ifdef S_MP_RAND_DIGS_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* fill "digits" digits from "rng" or from the random source if it is NULL */
+mp_err s_mp_rand_digs(mp_rng *rng, mp_digit *dp, int digits)
+{
+   size_t size = (size_t)digits * sizeof(mp_digit);
+   mp_err err;
+   int i;
+
+   if (rng != NULL) {
+      mp_rng_bytes(rng, dp, size);
+   } else if ((err = s_mp_rand_source(dp, size)) != MP_OKAY) {
+      return err;
+   }
+
+   /* read the bytes as little endian, such that a stream gives the same
+    * numbers on all platforms with the same digit size
+    */
+   for (i = 0; i < digits; i++) {
+      const uint8_t *b = (const uint8_t *)(dp + i);
+      mp_digit d = 0u;
+      size_t k;
+      for (k = sizeof(mp_digit); k > 0u; k--) {
+         d = (d << 8) | (mp_digit)b[k - 1u];
+      }
+      dp[i] = d & MP_MASK;
+   }
+   return MP_OKAY;
+}
+#endif
@@ -10,9 +10,18 @@ typedef struct {
    uint64_t b;
    uint64_t c;
    uint64_t d;
+   bool seeded;
 } ranctx;
 
+/* The state is per thread where possible. Threads which did not call
+ * s_mp_rand_jenkins_init start from the last seed given.
+ */
+#ifdef MP_THREAD_LOCAL
+static MP_THREAD_LOCAL ranctx jenkins_x;
+#else
 static ranctx jenkins_x;
+#endif
+static uint64_t jenkins_seed;
 
 #define rot(x,k) (((x)<<(k))|((x)>>(64-(k))))
 static uint64_t s_rand_jenkins_val(void)
@@ -28,8 +37,10 @@ static uint64_t s_rand_jenkins_val(void)
 void s_mp_rand_jenkins_init(uint64_t seed)
 {
    int i;
+   jenkins_seed = seed;
    jenkins_x.a = 0xF1EA5EEDuL;
    jenkins_x.b = jenkins_x.c = jenkins_x.d = seed;
+   jenkins_x.seeded = true;
    for (i = 0; i < 20; ++i) {
       (void)s_rand_jenkins_val();
    }
@@ -38,6 +49,9 @@ void s_mp_rand_jenkins_init(uint64_t seed)
 mp_err s_mp_rand_jenkins(void *p, size_t n)
 {
    char *q = (char *)p;
+   if (!jenkins_x.seeded) {
+      s_mp_rand_jenkins_init(jenkins_seed);
+   }
    while (n > 0u) {
       int i;
       uint64_t x = s_rand_jenkins_val();
@@ -0,0 +1,11 @@
+#include "tommath_private.h"
+#ifdef S_MP_SCRATCH_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_THREAD_LOCAL
+/* scratch region of the current thread */
+MP_THREAD_LOCAL s_mp_scratch_arena s_mp_scratch;
+#endif
+
+#endif
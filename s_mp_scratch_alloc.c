@@ -0,0 +1,36 @@
+#include "tommath_private.h"
+#ifdef S_MP_SCRATCH_ALLOC_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* allocate zeroed digits at the top of the scratch region, returns NULL
+ * if no scope is open or if the region is exhausted
+ */
+mp_digit *s_mp_scratch_alloc(int size)
+{
+#ifdef MP_THREAD_LOCAL
+   mp_digit *dp;
+
+   if (s_mp_scratch.depth == 0) {
+      return NULL;
+   }
+
+   if (((s_mp_scratch.size - s_mp_scratch.top) < (size_t)size) ||
+       (s_mp_scratch.nblk == MP_SCRATCH_BLOCKS)) {
+      /* remember how large the region should have been */
+      s_mp_scratch.spill += (size_t)size;
+      s_mp_scratch.wanted = MP_MAX(s_mp_scratch.wanted, s_mp_scratch.top + s_mp_scratch.spill);
+      return NULL;
+   }
+
+   dp = s_mp_scratch.base + s_mp_scratch.top;
+   s_mp_scratch.blk[s_mp_scratch.nblk++] = s_mp_scratch.top << 1;
+   s_mp_scratch.top += (size_t)size;
+   s_mp_zero_digs(dp, size);
+   return dp;
+#else
+   (void)size;
+   return NULL;
+#endif
+}
+#endif
@@ -0,0 +1,13 @@
+#include "tommath_private.h"
+#ifdef S_MP_SCRATCH_BEGIN_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* open a scratch scope, which must be closed by s_mp_scratch_end */
+void s_mp_scratch_begin(void)
+{
+#ifdef MP_THREAD_LOCAL
+   s_mp_scratch.depth++;
+#endif
+}
+#endif
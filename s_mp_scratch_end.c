@@ -0,0 +1,28 @@
+#include "tommath_private.h"
+#ifdef S_MP_SCRATCH_END_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* close a scratch scope, the outermost one releases the whole region */
+void s_mp_scratch_end(void)
+{
+#ifdef MP_THREAD_LOCAL
+   if (--s_mp_scratch.depth != 0) {
+      return;
+   }
+
+   s_mp_scratch.top = 0u;
+   s_mp_scratch.nblk = 0;
+
+   if (!s_mp_scratch.strict && (s_mp_scratch.wanted > s_mp_scratch.size)) {
+      /* enlarge the region for the next call, on failure the heap is used as before */
+      size_t size = MP_MIN(MP_MAX(s_mp_scratch.wanted, 2u * s_mp_scratch.size),
+                           (size_t)MP_SCRATCH_MAX / sizeof(mp_digit));
+      if ((size > s_mp_scratch.size) && (mp_scratch_reserve(size * sizeof(mp_digit)) != MP_OKAY)) {
+         s_mp_scratch.wanted = 0u;
+      }
+   }
+   s_mp_scratch.spill = s_mp_scratch.wanted = 0u;
+#endif
+}
+#endif
@@ -0,0 +1,60 @@
+#include "tommath_private.h"
+#ifdef S_MP_SCRATCH_FREE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_THREAD_LOCAL
+static void s_drop_block(int i)
+{
+   for (; i < (s_mp_scratch.nblk - 1); i++) {
+      s_mp_scratch.blk[i] = s_mp_scratch.blk[i + 1];
+   }
+   s_mp_scratch.nblk--;
+}
+#endif
+
+/* free digits of the scratch region, the block is released together
+ * with all freed blocks below it once it is at the top
+ */
+void s_mp_scratch_free(mp_digit *dp, int size)
+{
+#ifdef MP_THREAD_LOCAL
+   size_t off = (size_t)(dp - s_mp_scratch.base) << 1;
+   int i;
+
+#ifndef MP_NO_ZERO_ON_FREE
+   s_mp_zero_digs(dp, size);
+#else
+   (void)size;
+#endif
+
+   /* blocks are mostly freed close to the top */
+   for (i = s_mp_scratch.nblk - 1; i >= 0; i--) {
+      if (s_mp_scratch.blk[i] == off) {
+         s_mp_scratch.blk[i] |= 1u;
+         break;
+      }
+   }
+
+   /* merge with freed neighbours, a block ends where the next one starts,
+    * so dropping the entry of the upper one of two freed blocks joins them.
+    * This bounds the number of entries by twice the number of live blocks.
+    */
+   if (i >= 0) {
+      if (((i + 1) < s_mp_scratch.nblk) && ((s_mp_scratch.blk[i + 1] & 1u) != 0u)) {
+         s_drop_block(i + 1);
+      }
+      if ((i > 0) && ((s_mp_scratch.blk[i - 1] & 1u) != 0u)) {
+         s_drop_block(i);
+      }
+   }
+
+   while ((s_mp_scratch.nblk > 0) && ((s_mp_scratch.blk[s_mp_scratch.nblk - 1] & 1u) != 0u)) {
+      s_mp_scratch.top = s_mp_scratch.blk[--s_mp_scratch.nblk] >> 1;
+   }
+#else
+   (void)dp;
+   (void)size;
+#endif
+}
+#endif
@@ -0,0 +1,30 @@
+#include "tommath_private.h"
+#ifdef S_MP_SCRATCH_INIT_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* init a temporary for a given number of digits in the scratch region,
+ * falls back to the heap if the region is exhausted
+ */
+mp_err s_mp_scratch_init(mp_int *a, int size)
+{
+   mp_digit *dp;
+
+   size = MP_MAX(MP_MIN_DIGIT_COUNT, size);
+
+   if (size > MP_MAX_DIGIT_COUNT) {
+      return MP_OVF;
+   }
+
+   if ((dp = s_mp_scratch_alloc(size)) == NULL) {
+      return mp_init_size(a, size);
+   }
+
+   a->dp    = dp;
+   a->used  = 0;
+   a->alloc = size;
+   a->sign  = MP_ZPOS;
+
+   return MP_OKAY;
+}
+#endif
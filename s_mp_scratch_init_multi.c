@@ -0,0 +1,42 @@
+#include "tommath_private.h"
+#ifdef S_MP_SCRATCH_INIT_MULTI_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#include <stdarg.h>
+
+/* like mp_init_multi, but for temporaries in the scratch region */
+mp_err s_mp_scratch_init_multi(mp_int *mp, ...)
+{
+   mp_err err = MP_OKAY;
+   int n = 0;                 /* Number of ok inits */
+   mp_int *cur_arg = mp;
+   va_list args;
+
+   va_start(args, mp);        /* init args to next argument from caller */
+   while (cur_arg != NULL) {
+      err = s_mp_scratch_init(cur_arg, MP_DEFAULT_DIGIT_COUNT);
+      if (err != MP_OKAY) {
+         /* Oops - error! Back-track and mp_clear what we already
+            succeeded in init-ing, then return error.
+         */
+         va_list clean_args;
+
+         /* now start cleaning up */
+         cur_arg = mp;
+         va_start(clean_args, mp);
+         while (n-- != 0) {
+            mp_clear(cur_arg);
+            cur_arg = va_arg(clean_args, mp_int *);
+         }
+         va_end(clean_args);
+         break;
+      }
+      n++;
+      cur_arg = va_arg(args, mp_int *);
+   }
+   va_end(args);
+   return err;
+}
+
+#endif
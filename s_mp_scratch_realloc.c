@@ -0,0 +1,42 @@
+#include "tommath_private.h"
+#ifdef S_MP_SCRATCH_REALLOC_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* grow digits of the scratch region. The block at the top is grown in
+ * place, other blocks are moved to the top. If the region is exhausted
+ * the block is moved to the heap, unless in strict mode.
+ */
+mp_digit *s_mp_scratch_realloc(mp_digit *dp, int oldsize, int newsize)
+{
+#ifdef MP_THREAD_LOCAL
+   size_t off = (size_t)(dp - s_mp_scratch.base);
+   mp_digit *ndp;
+
+   if ((s_mp_scratch.nblk > 0) && (s_mp_scratch.blk[s_mp_scratch.nblk - 1] == (off << 1)) &&
+       ((s_mp_scratch.size - off) >= (size_t)newsize)) {
+      s_mp_scratch.top = off + (size_t)newsize;
+      return dp;
+   }
+
+   if ((ndp = s_mp_scratch_alloc(newsize)) == NULL) {
+      if (s_mp_scratch.strict) {
+         return NULL;
+      }
+      ndp = (mp_digit *) MP_MALLOC((size_t)newsize * sizeof(mp_digit));
+      if (ndp == NULL) {
+         return NULL;
+      }
+   }
+
+   s_mp_copy_digs(ndp, dp, oldsize);
+   s_mp_scratch_free(dp, oldsize);
+   return ndp;
+#else
+   (void)dp;
+   (void)oldsize;
+   (void)newsize;
+   return NULL;
+#endif
+}
+#endif
@@ -0,0 +1,17 @@
+#include "tommath_private.h"
+#ifdef S_MP_SCRATCH_RELEASE_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* release the scratch region of the calling thread, it must not be in use */
+void s_mp_scratch_release(void)
+{
+#ifdef MP_THREAD_LOCAL
+   if (s_mp_scratch.base != NULL) {
+      MP_FREE_BUF(s_mp_scratch.base, s_mp_scratch.size * sizeof(mp_digit));
+   }
+   s_mp_scratch.base = NULL;
+   s_mp_scratch.size = 0u;
+#endif
+}
+#endif
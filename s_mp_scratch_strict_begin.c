@@ -0,0 +1,29 @@
+#include "tommath_private.h"
+#ifdef S_MP_SCRATCH_STRICT_BEGIN_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* replace the scratch region of the thread by a caller supplied one of
+ * "size" digits and take all allocations from it until s_mp_scratch_strict_end
+ */
+mp_err s_mp_scratch_strict_begin(mp_digit *scratch, size_t size)
+{
+#ifdef MP_THREAD_LOCAL
+   if (s_mp_scratch.depth != 0) {
+      return MP_VAL;
+   }
+
+   s_mp_scratch.own_base = s_mp_scratch.base;
+   s_mp_scratch.own_size = s_mp_scratch.size;
+   s_mp_scratch.base = scratch;
+   s_mp_scratch.size = (scratch != NULL) ? size : 0u;
+   s_mp_scratch.strict = true;
+   s_mp_scratch_begin();
+   return MP_OKAY;
+#else
+   (void)scratch;
+   (void)size;
+   return MP_ERR;
+#endif
+}
+#endif
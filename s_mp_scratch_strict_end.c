@@ -0,0 +1,16 @@
+#include "tommath_private.h"
+#ifdef S_MP_SCRATCH_STRICT_END_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* restore the scratch region of the thread */
+void s_mp_scratch_strict_end(void)
+{
+#ifdef MP_THREAD_LOCAL
+   s_mp_scratch_end();
+   s_mp_scratch.base = s_mp_scratch.own_base;
+   s_mp_scratch.size = s_mp_scratch.own_size;
+   s_mp_scratch.strict = false;
+#endif
+}
+#endif
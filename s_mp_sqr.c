@@ -7,59 +7,29 @@
 mp_err s_mp_sqr(const mp_int *a, mp_int *b)
 {
    mp_int   t;
-   int      ix, pa;
+   int      pa;
    mp_err   err;
 
    pa = a->used;
-   if ((err = mp_init_size(&t, (2 * pa) + 1)) != MP_OKAY) {
-      return err;
+   if (pa == 0) {
+      mp_zero(b);
+      return MP_OKAY;
    }
 
-   /* default used is maximum possible size */
-   t.used = (2 * pa) + 1;
-
-   for (ix = 0; ix < pa; ix++) {
-      mp_digit u;
-      int iy;
-
-      /* first calculate the digit at 2*ix */
-      /* calculate double precision result */
-      mp_word r = (mp_word)t.dp[2*ix] +
-                  ((mp_word)a->dp[ix] * (mp_word)a->dp[ix]);
-
-      /* store lower part in result */
-      t.dp[ix+ix] = (mp_digit)(r & (mp_word)MP_MASK);
-
-      /* get the carry */
-      u           = (mp_digit)(r >> (mp_word)MP_DIGIT_BIT);
-
-      for (iy = ix + 1; iy < pa; iy++) {
-         /* first calculate the product */
-         r       = (mp_word)a->dp[ix] * (mp_word)a->dp[iy];
-
-         /* now calculate the double precision result, note we use
-          * addition instead of *2 since it's easier to optimize
-          */
-         r       = (mp_word)t.dp[ix + iy] + r + r + (mp_word)u;
-
-         /* store lower part */
-         t.dp[ix + iy] = (mp_digit)(r & (mp_word)MP_MASK);
-
-         /* get carry */
-         u       = (mp_digit)(r >> (mp_word)MP_DIGIT_BIT);
-      }
-      /* propagate upwards */
-      while (u != 0uL) {
-         r       = (mp_word)t.dp[ix + iy] + (mp_word)u;
-         t.dp[ix + iy] = (mp_digit)(r & (mp_word)MP_MASK);
-         u       = (mp_digit)(r >> (mp_word)MP_DIGIT_BIT);
-         ++iy;
-      }
+   if ((err = mp_init_size(&t, 2 * pa)) != MP_OKAY) {
+      return err;
    }
 
+   t.used = 2 * pa;
+   mpl_sqr_basecase(a->dp, pa, t.dp);
+
    mp_clamp(&t);
-   mp_exch(&t, b);
+
+   /* copy instead of exchanging, the result keeps the digits it was grown to
+    * by mp_mul and is not moved within the scratch region
+    */
+   err = mp_copy(&t, b);
    mp_clear(&t);
-   return MP_OKAY;
+   return err;
 }
 #endif
@@ -0,0 +1,11 @@
+#include "tommath_private.h"
+#ifdef S_MP_STATS_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_STATS
+/* dispatch statistics of the current thread */
+MP_THREAD_LOCAL mp_stats s_mp_stats;
+#endif
+
+#endif
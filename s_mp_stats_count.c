@@ -0,0 +1,19 @@
+#include "tommath_private.h"
+#ifdef S_MP_STATS_COUNT_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#ifdef MP_STATS
+/* count a call of "path" on an operand of "size" digits */
+void s_mp_stats_count(mp_stats_path path, int size)
+{
+   int k = 0;
+   while (((size >>= 1) > 0) && (k < (MP_STATS_BUCKETS - 1))) {
+      ++k;
+   }
+   s_mp_stats.calls[path]++;
+   s_mp_stats.size[path][k]++;
+}
+#endif
+
+#endif
@@ -17,25 +17,13 @@ mp_err s_mp_sub(const mp_int *a, const mp_int *b, mp_int *c)
 
    c->used = max;
 
-   /* set carry to zero */
-   u = 0;
-   for (i = 0; i < min; i++) {
-      /* T[i] = A[i] - B[i] - U */
-      c->dp[i] = (a->dp[i] - b->dp[i]) - u;
-
-      /* U = carry bit of T[i]
-       * Note this saves performing an AND operation since
-       * if a carry does occur it will propagate all the way to the
-       * MSB.  As a result a single shift is enough to get the carry
-       */
-      u = c->dp[i] >> (MP_SIZEOF_BITS(mp_digit) - 1u);
-
-      /* Clear carry from T[i] */
-      c->dp[i] &= MP_MASK;
-   }
+   /* subtract the common digits */
+   u = mpl_sub_n(a->dp, b->dp, c->dp, min);
 
-   /* now copy higher words if any, e.g. if A has more digits than B  */
-   for (; i < max; i++) {
+   /* now the higher digits of A, the borrow stops at
+    * the first digit above zero and the rest is copied
+    */
+   for (i = min; (i < max) && (u != 0u); i++) {
       /* T[i] = A[i] - U */
       c->dp[i] = a->dp[i] - u;
 
@@ -45,6 +33,9 @@ mp_err s_mp_sub(const mp_int *a, const mp_int *b, mp_int *c)
       /* Clear carry from T[i] */
       c->dp[i] &= MP_MASK;
    }
+   if ((c != a) && (i < max)) {
+      s_mp_copy_digs(c->dp + i, a->dp + i, max - i);
+   }
 
    /* clear digits above used (since we may not have grown result above) */
    s_mp_zero_digs(c->dp + c->used, oldused - c->used);
@@ -0,0 +1,38 @@
+#include "tommath_private.h"
+#ifdef S_MP_SUB_DIGS_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/* c = a - b for n digits, returns the borrow.
+ *
+ * Like s_mp_add_digs the borrow of a digit is only taken from the next
+ * digit, the block is walked once more if a digit which was zero wrapped.
+ */
+mp_digit s_mp_sub_digs(const mp_digit *a, const mp_digit *b, mp_digit *c, int n)
+{
+   int i, j, m;
+   mp_digit s, u = 0u, o, acc;
+
+   for (i = 0; i < n; i += m) {
+      m = MP_MIN(n - i, MP_CARRY_BLOCK);
+      acc = 0u;
+      for (j = i; j < (i + m); j++) {
+         s = a[j] - b[j];
+         c[j] = (s & MP_MASK) - u;
+         u = s >> (MP_SIZEOF_BITS(mp_digit) - 1u);
+         acc |= c[j];
+      }
+
+      if ((acc >> MP_DIGIT_BIT) != 0u) {
+         o = 0u;
+         for (j = i; j < (i + m); j++) {
+            c[j] -= o;
+            o = c[j] >> (MP_SIZEOF_BITS(mp_digit) - 1u);
+            c[j] &= MP_MASK;
+         }
+         u |= o;
+      }
+   }
+   return u;
+}
+#endif
@@ -0,0 +1,42 @@
+#include "tommath_private.h"
+#ifdef S_MP_THREAD_ATEXIT_C
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#if defined(MP_HAS_PTHREAD) && defined(MP_THREAD_LOCAL)
+static pthread_once_t s_thread_exit_once = PTHREAD_ONCE_INIT;
+static pthread_key_t s_thread_exit_key;
+static bool s_thread_exit_key_ok = false;
+static MP_THREAD_LOCAL bool s_thread_exit_set = false;
+
+/* runs in the exiting thread, its thread local storage is still there */
+static void s_thread_exit(void *arg)
+{
+   (void)arg;
+   /* registered again if a later destructor uses the library */
+   s_thread_exit_set = false;
+   s_mp_scratch_release();
+   mp_digit_cache_flush();
+}
+
+static void s_thread_exit_key_create(void)
+{
+   s_thread_exit_key_ok = (pthread_key_create(&s_thread_exit_key, s_thread_exit) == 0);
+}
+#endif
+
+/* release the heap memory held by the calling thread when it exits */
+void s_mp_thread_atexit(void)
+{
+#if defined(MP_HAS_PTHREAD) && defined(MP_THREAD_LOCAL)
+   if (s_thread_exit_set) {
+      return;
+   }
+   (void)pthread_once(&s_thread_exit_once, s_thread_exit_key_create);
+   /* any value but NULL makes the destructor run */
+   if (s_thread_exit_key_ok && (pthread_setspecific(s_thread_exit_key, &s_thread_exit_once) == 0)) {
+      s_thread_exit_set = true;
+   }
+#endif
+}
+#endif
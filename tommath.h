@@ -121,9 +121,31 @@ extern int
 MP_MUL_KARATSUBA_CUTOFF,
 MP_SQR_KARATSUBA_CUTOFF,
 MP_MUL_TOOM_CUTOFF,
-MP_SQR_TOOM_CUTOFF;
+MP_SQR_TOOM_CUTOFF,
+MP_MUL_COMBA_CUTOFF,
+MP_SQR_COMBA_CUTOFF,
+MP_MUL_BALANCE_CUTOFF,
+MP_DIV_RECURSIVE_CUTOFF,
+MP_EXPTMOD_WIN3_CUTOFF,
+MP_EXPTMOD_WIN4_CUTOFF,
+MP_EXPTMOD_WIN5_CUTOFF,
+MP_EXPTMOD_WIN6_CUTOFF,
+MP_EXPTMOD_WIN7_CUTOFF,
+MP_EXPTMOD_WIN8_CUTOFF;
 #endif
 
+/* a set of cutoffs which can be installed for a single thread, start from mp_cutoffs_get() */
+typedef struct {
+   int mul_karatsuba, sqr_karatsuba,
+       mul_toom, sqr_toom,
+       mul_comba, sqr_comba,          /* Comba is used below, the baseline from here on */
+       mul_balance,                   /* ratio of the sizes from which the product is balanced */
+       div_recursive,                 /* digits of the divisor */
+       exptmod_win3, exptmod_win4,    /* bits of the exponent from which a window of */
+       exptmod_win5, exptmod_win6,    /* this size is used */
+       exptmod_win7, exptmod_win8;
+} mp_cutoffs;
+
 /* define this to use lower memory usage routines (exptmods mostly) */
 /* #define MP_LOW_MEM */
 
@@ -171,13 +193,141 @@ MP_SQR_TOOM_CUTOFF;
 #  define MP_DEPRECATED_PRAGMA(s)
 #endif
 
-/* the infamous mp_int structure */
+/* the infamous mp_int structure
+ *
+ * If MP_INLINE_DIGITS is defined, small values are kept in the structure
+ * itself and only larger ones are put on the heap. This changes the ABI,
+ * the library and the application must be built with the same value, and
+ * an mp_int must not be moved by assignment, use mp_exch instead.
+ */
 typedef struct  {
    int used, alloc;
    mp_sign sign;
    mp_digit *dp;
+#ifdef MP_INLINE_DIGITS
+   mp_digit inl[MP_INLINE_DIGITS];
+#endif
 } mp_int;
 
+/* heap functions, all of them get the user context pointer "ctx" and
+ * realloc and free also get the size of the allocated memory block
+ */
+typedef struct {
+   void *(*malloc_fn)(void *ctx, size_t size);
+   void *(*realloc_fn)(void *ctx, void *mem, size_t oldsize, size_t newsize);
+   void (*free_fn)(void *ctx, void *mem, size_t size);
+   void *ctx;
+} mp_allocator;
+
+/* replace the heap functions, NULL restores the default ones. This must be done
+ * before any mp_int is initialized, since memory is not moved between allocators.
+ * The workers of the batch functions are stopped, such that their cached digits
+ * are returned to the previous allocator.
+ */
+mp_err mp_set_allocator(const mp_allocator *allocator) MP_WUR;
+
+/* statistics of the digit cache of the calling thread */
+typedef struct {
+   size_t hits;      /* allocations served from the cache */
+   size_t misses;    /* allocations passed to the heap */
+   size_t retained;  /* frees kept in the cache */
+   size_t released;  /* frees passed to the heap */
+   size_t bytes;     /* bytes currently held by the cache */
+} mp_digit_cache_stats;
+
+/* get the statistics of the digit cache, MP_ERR if built without MP_DIGIT_CACHE */
+mp_err mp_digit_cache_stats_get(mp_digit_cache_stats *stats) MP_WUR;
+
+/* return the digit buffers cached by the calling thread to the heap */
+void mp_digit_cache_flush(void);
+
+/* functions the heap statistics are attributed to, the outermost one wins */
+typedef enum {
+   MP_ALLOC_OP_NONE = 0,           /* outside of the functions below */
+   MP_ALLOC_OP_MUL,                /* mp_mul */
+   MP_ALLOC_OP_DIV,                /* mp_div */
+   MP_ALLOC_OP_EXPTMOD,            /* mp_exptmod */
+   MP_ALLOC_OP_INVMOD,             /* mp_invmod */
+   MP_ALLOC_OP_GCD,                /* mp_gcd */
+   MP_ALLOC_OP_SQRTMOD,            /* mp_sqrtmod_prime */
+   MP_ALLOC_OP_PRIME,              /* mp_prime_is_prime */
+   MP_ALLOC_OP_TO_RADIX,           /* mp_to_radix */
+   MP_ALLOC_OP_COUNT
+} mp_alloc_op;
+
+typedef struct {
+   size_t allocs;  /* calls of malloc and realloc */
+   size_t frees;   /* calls of free */
+   size_t bytes;   /* bytes requested */
+   size_t peak;    /* highest number of live bytes of the thread */
+} mp_alloc_counters;
+
+/* heap statistics of the calling thread */
+typedef struct {
+   size_t live;    /* bytes currently allocated */
+   mp_alloc_counters op[MP_ALLOC_OP_COUNT];
+} mp_alloc_stats;
+
+/* get the heap statistics, MP_ERR if built without MP_ALLOC_STATS */
+mp_err mp_alloc_stats_get(mp_alloc_stats *stats) MP_WUR;
+
+/* reset the counters and the peaks of the calling thread */
+void mp_alloc_stats_reset(void);
+
+/* the paths taken by the dispatching functions, counted with MP_STATS */
+typedef enum {
+   MP_STATS_MUL_BASECASE = 0,      /* mp_mul: schoolbook */
+   MP_STATS_MUL_COMBA,
+   MP_STATS_MUL_KARATSUBA,
+   MP_STATS_MUL_TOOM,
+   MP_STATS_MUL_BALANCE,           /* unbalanced operands */
+   MP_STATS_SQR_BASECASE,          /* mp_mul of a number with itself */
+   MP_STATS_SQR_COMBA,
+   MP_STATS_SQR_KARATSUBA,
+   MP_STATS_SQR_TOOM,
+   MP_STATS_EXPTMOD_MONTGOMERY,    /* mp_exptmod: odd modulus */
+   MP_STATS_EXPTMOD_DR,            /* diminished radix modulus */
+   MP_STATS_EXPTMOD_2K,            /* modulus 2^p - k */
+   MP_STATS_EXPTMOD_2K_L,          /* modulus 2^p - k with a large k */
+   MP_STATS_EXPTMOD_BARRETT,       /* any other modulus */
+   MP_STATS_DIV_TRIVIAL,           /* mp_div: |a| < |b| */
+   MP_STATS_DIV_RECURSIVE,
+   MP_STATS_DIV_SCHOOL,
+   MP_STATS_DIV_SMALL,
+   MP_STATS_PATH_COUNT
+} mp_stats_path;
+
+#define MP_STATS_BUCKETS 32
+
+/* dispatch statistics of the calling thread */
+typedef struct {
+   uint64_t calls[MP_STATS_PATH_COUNT];
+   /* the calls by the size of the operand in digits, bucket k holds the
+    * sizes from 2^k to 2^(k+1) - 1, bucket 0 also the size 0
+    */
+   uint64_t size[MP_STATS_PATH_COUNT][MP_STATS_BUCKETS];
+} mp_stats;
+
+/* get the dispatch statistics, MP_ERR if built without MP_STATS */
+mp_err mp_stats_snapshot(mp_stats *stats) MP_WUR;
+
+/* reset the dispatch statistics of the calling thread */
+void mp_stats_reset(void);
+
+/* install cutoffs for the calling thread only, NULL returns to the global ones.
+ * MP_ERR if the cutoffs are fixed at compile time or threads are not supported.
+ */
+mp_err mp_cutoffs_set_thread(const mp_cutoffs *cutoffs) MP_WUR;
+
+/* get the cutoffs used by the calling thread */
+void mp_cutoffs_get(mp_cutoffs *cutoffs);
+
+/* measure the cutoffs of Karatsuba, Toom-Cook and the recursive division within
+ * a few seconds and install them for all threads. MP_ERR if the cutoffs are fixed.
+ * Not thread safe, call it before other threads use the library.
+ */
+mp_err mp_cutoffs_autotune(void) MP_WUR;
+
 /* error code to char* string */
 const char *mp_error_to_string(mp_err code) MP_WUR;
 
@@ -206,6 +356,9 @@ mp_err mp_grow(mp_int *a, int size) MP_WUR;
 /* init to a given number of digits */
 mp_err mp_init_size(mp_int *a, int size) MP_WUR;
 
+/* reserve (or release with 0) the scratch region of the calling thread */
+mp_err mp_scratch_reserve(size_t size) MP_WUR;
+
 /* ---> Basic Manipulations <--- */
 #define mp_iszero(a) ((a)->used == 0)
 #define mp_isneg(a)  ((a)->sign == MP_NEG)
@@ -312,6 +465,31 @@ mp_err mp_rand(mp_int *a, int digits) MP_WUR;
 /* use custom random data source instead of source provided the platform */
 void mp_rand_source(mp_err(*source)(void *out, size_t size));
 
+/* deterministic random stream, ChaCha20 keyed by the seed with the stream number as nonce */
+typedef struct {
+   uint32_t key[8];
+   uint64_t stream;
+   uint64_t block;     /* next block to generate */
+   uint8_t buf[64];
+   unsigned int avail; /* unused bytes at the end of buf */
+} mp_rng;
+
+/* start stream "stream" of "seed", different streams of the same seed are independent */
+void mp_rng_init(mp_rng *rng, uint64_t seed, uint64_t stream);
+/* skip the next "blocks" blocks of 64 bytes */
+void mp_rng_jump(mp_rng *rng, uint64_t blocks);
+/* read the next "size" bytes of the stream */
+void mp_rng_bytes(mp_rng *rng, void *out, size_t size);
+
+/* like mp_rand but taking the bytes from "rng", or from the random source if it is NULL.
+ * The result has exactly "digits" digits, the highest one is drawn again until it is nonzero.
+ */
+mp_err mp_rand_ex(mp_rng *rng, mp_int *a, int digits) MP_WUR;
+/* a = uniform random number in [0, 2**bits) */
+mp_err mp_rand_bits(mp_rng *rng, mp_int *a, int bits) MP_WUR;
+/* a = uniform random number in [0, n), n > 0 */
+mp_err mp_rand_range(mp_rng *rng, mp_int *a, const mp_int *n) MP_WUR;
+
 /* ---> binary operations <--- */
 
 /* c = a XOR b (two complement) */
@@ -361,6 +539,13 @@ mp_err mp_div(const mp_int *a, const mp_int *b, mp_int *c, mp_int *d) MP_WUR;
 /* c = a mod b, 0 <= c < b  */
 mp_err mp_mod(const mp_int *a, const mp_int *b, mp_int *c) MP_WUR;
 
+/* residues[i] = a mod moduli[i] for 0 <= i < n, using a remainder tree */
+mp_err mp_mod_multi(const mp_int *a, const mp_int *moduli, size_t n, mp_int *residues) MP_WUR;
+
+/* same, but builds the tree over at most "block" moduli at a time to bound the memory */
+mp_err mp_mod_multi_stream(const mp_int *a, const mp_int *moduli, size_t n, mp_int *residues,
+                           size_t block) MP_WUR;
+
 /* Increment "a" by one like "a++". Changes input! */
 #define mp_incr(a) mp_add_d((a), 1u, (a))
 
@@ -488,6 +673,81 @@ mp_err mp_reduce_2k_l(mp_int *a, const mp_int *n, const mp_int *d) MP_WUR;
 /* Y = G**X (mod P) */
 mp_err mp_exptmod(const mp_int *G, const mp_int *X, const mp_int *P, mp_int *Y) MP_WUR;
 
+/* ---> Allocation free variants <--- */
+
+/* These run entirely on a caller supplied scratch region of "size" digits and
+ * never touch the heap. The results must be grown by the caller beforehand,
+ * MP_MEM is returned if the scratch region or a result is too small.
+ */
+
+/* number of scratch digits for a product of numbers with up to "size" digits */
+size_t mp_mul_itch(int size) MP_WUR;
+
+/* c = a * b */
+mp_err mp_mul_scratch(const mp_int *a, const mp_int *b, mp_int *c, mp_digit *scratch, size_t size) MP_WUR;
+
+/* number of scratch digits for a division of numbers with up to "asize" and "bsize" digits */
+size_t mp_div_itch(int asize, int bsize) MP_WUR;
+
+/* a/b => cb + d == a */
+mp_err mp_div_scratch(const mp_int *a, const mp_int *b, mp_int *c, mp_int *d, mp_digit *scratch, size_t size) MP_WUR;
+
+/* number of scratch digits for an exponentiation modulo P with 0 <= G < P */
+size_t mp_exptmod_itch(const mp_int *P) MP_WUR;
+
+/* Y = G**X (mod P) */
+mp_err mp_exptmod_scratch(const mp_int *G, const mp_int *X, const mp_int *P, mp_int *Y,
+                          mp_digit *scratch, size_t size) MP_WUR;
+
+/* ---> Digit vectors <--- */
+
+/* These are the kernels of the functions above on little endian arrays of
+ * "n" digits, each below 2**MP_DIGIT_BIT. They neither allocate nor clamp,
+ * the output array must hold the number of digits stated and may only be
+ * the same as an input where that is mentioned.
+ */
+
+/* c = a + b, returns the carry, c may be a or b */
+mp_digit mpl_add_n(const mp_digit *a, const mp_digit *b, mp_digit *c, int n);
+
+/* c = a - b, returns the borrow, c may be a or b */
+mp_digit mpl_sub_n(const mp_digit *a, const mp_digit *b, mp_digit *c, int n);
+
+/* c = a * b, returns the high digit, c may be a */
+mp_digit mpl_mul_1(const mp_digit *a, int n, mp_digit b, mp_digit *c);
+
+/* c = c + a * b, returns the high digit */
+mp_digit mpl_addmul_1(const mp_digit *a, int n, mp_digit b, mp_digit *c);
+
+/* c = c - a * b, returns the high digit which was borrowed */
+mp_digit mpl_submul_1(const mp_digit *a, int n, mp_digit b, mp_digit *c);
+
+/* c = a * b with c of an + bn digits, an and bn > 0 */
+void mpl_mul_basecase(const mp_digit *a, int an, const mp_digit *b, int bn, mp_digit *c);
+
+/* b = a * a with b of 2 * n digits, n > 0 */
+void mpl_sqr_basecase(const mp_digit *a, int n, mp_digit *b);
+
+/* c = x/B**n (mod m) for x < m * B**n of 2 * n digits, which are destroyed.
+ * rho is set by mp_montgomery_setup, the result is below 2 * m and m is
+ * to be subtracted once if it is not below m or the returned carry is set.
+ * c may be x.
+ */
+mp_digit mpl_redc_1(mp_digit *x, const mp_digit *m, int n, mp_digit rho, mp_digit *c);
+
+/* c = a / b for b != 0, returns the remainder, c may be a */
+mp_digit mpl_divrem_1(const mp_digit *a, int n, mp_digit b, mp_digit *c);
+
+/* c = a * 2**b for 0 < b < MP_DIGIT_BIT and n > 0, returns the bits shifted out.
+ * c may be at or above a.
+ */
+mp_digit mpl_lshift(const mp_digit *a, int n, int b, mp_digit *c);
+
+/* c = a / 2**b for 0 < b < MP_DIGIT_BIT and n > 0, returns the bits shifted out.
+ * c may be at or below a.
+ */
+mp_digit mpl_rshift(const mp_digit *a, int n, int b, mp_digit *c);
+
 /* ---> Primes <--- */
 
 /* performs one Fermat test of "a" using base "b".
@@ -553,6 +813,41 @@ mp_err mp_prime_next_prime(mp_int *a, int t, bool bbs_style) MP_WUR;
  */
 mp_err mp_prime_rand(mp_int *a, int t, int size, int flags) MP_WUR;
 
+/* ---> Batches <--- */
+
+/* These apply an operation to the elements of arrays of operands, which are
+ * distributed over a pool of worker threads and the calling thread. The error
+ * of each element is stored in "errs" unless it is NULL, the functions return
+ * the error of the first element which failed or MP_OKAY.
+ */
+
+/* worker threads of the batch functions */
+typedef struct {
+   int threads;                               /* number of workers, 0 runs on the caller only */
+   void (*start_fn)(void *ctx, int worker);   /* optional, called by each worker when started,
+                                               * e.g. to set its processor affinity */
+   void *ctx;
+} mp_batch_config;
+
+/* configure the workers, NULL selects one per online processor besides the caller.
+ * The workers are started on the next batch, MP_ERR if threads are not supported.
+ */
+mp_err mp_batch_config_set(const mp_batch_config *config) MP_WUR;
+
+/* Y[i] = G[i]**X[i] (mod P[i]) */
+mp_err mp_batch_exptmod(const mp_int *G, const mp_int *X, const mp_int *P, mp_int *Y,
+                        mp_err *errs, size_t n) MP_WUR;
+
+/* d[i] = a[i] * b[i] (mod c[i]) */
+mp_err mp_batch_mulmod(const mp_int *a, const mp_int *b, const mp_int *c, mp_int *d,
+                       mp_err *errs, size_t n) MP_WUR;
+
+/* c[i] = 1/a[i] (mod b[i]) */
+mp_err mp_batch_invmod(const mp_int *a, const mp_int *b, mp_int *c, mp_err *errs, size_t n) MP_WUR;
+
+/* result[i] = mp_prime_is_prime(a[i], t) */
+mp_err mp_batch_prime_is_prime(const mp_int *a, int t, bool *result, mp_err *errs, size_t n) MP_WUR;
+
 /* ---> radix conversion <--- */
 int mp_count_bits(const mp_int *a) MP_WUR;
 
@@ -573,6 +868,27 @@ mp_err mp_radix_size_overestimate(const mp_int *a, const int radix, size_t *size
 #ifndef MP_NO_FILE
 mp_err mp_fread(mp_int *a, int radix, FILE *stream) MP_WUR;
 mp_err mp_fwrite(const mp_int *a, int radix, FILE *stream) MP_WUR;
+
+/* native limb files, the digits are written as they are stored in memory */
+mp_err mp_fwrite_limbs(const mp_int *a, FILE *stream) MP_WUR;
+
+/* load a native limb file, either copied into an initialized "a" or mapped
+ * read-only without copying. A mapped "a" must only be used as input and
+ * must be released with mp_mmap_unload instead of mp_clear.
+ */
+mp_err mp_mmap_load(mp_int *a, const char *path, bool copy) MP_WUR;
+void mp_mmap_unload(mp_int *a);
+
+/* load the cutoffs of all threads from lines "NAME_CUTOFF = value" as printed by
+ * etc/tune, '#' starts a comment. The cutoffs which are not listed are kept.
+ * MP_VAL if the file is malformed or a cutoff is out of range, MP_ERR if the
+ * file cannot be read or the cutoffs are fixed.
+ * Not thread safe, call it before other threads use the library.
+ */
+mp_err mp_cutoffs_load(const char *path) MP_WUR;
+
+/* save the cutoffs used by the calling thread in the format of mp_cutoffs_load */
+mp_err mp_cutoffs_save(const char *path) MP_WUR;
 #endif
 
 #define mp_to_binary(M, S, N)  mp_to_radix((M), (S), (N), NULL, 2)
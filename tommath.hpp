@@ -0,0 +1,883 @@
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#ifndef TOMMATH_HPP_
+#define TOMMATH_HPP_
+
+/* C++11 interface, header only.
+ *
+ * tommath::integer owns an mp_int. Moving steals the digits, the binary
+ * operators build expressions which are evaluated into the digits of the
+ * destination and the compound assignments work on the digits already
+ * allocated. Errors are
+ * thrown, MP_MEM as std::bad_alloc and all others as tommath::error.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "tommath.h"
+
+namespace tommath {
+
+class error : public std::runtime_error {
+public:
+   explicit error(mp_err err) : std::runtime_error(mp_error_to_string(err)), err_(err) {}
+   mp_err code() const noexcept
+   {
+      return err_;
+   }
+private:
+   mp_err err_;
+};
+
+namespace detail {
+inline void check(mp_err err)
+{
+   if (err == MP_MEM) {
+      throw std::bad_alloc();
+   }
+   if (err != MP_OKAY) {
+      throw error(err);
+   }
+}
+}
+
+class integer;
+
+template <typename Op, typename L, typename R> struct expr;
+template <typename Op, typename L> struct shift_expr;
+
+namespace detail {
+/* selects the constructor which leaves the integer without digits */
+struct empty_t {};
+
+template <typename T> struct is_expr : std::false_type {};
+}
+
+class integer {
+public:
+   integer()
+   {
+      detail::check(mp_init(&m_));
+   }
+
+   template <typename T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, int>::type = 0>
+   integer(T v)
+   {
+      detail::check(mp_init_i64(&m_, static_cast<std::int64_t>(v)));
+   }
+
+   template <typename T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, int>::type = 0>
+   integer(T v)
+   {
+      detail::check(mp_init_u64(&m_, static_cast<std::uint64_t>(v)));
+   }
+
+   explicit integer(const char *str, int radix = 10) : integer()
+   {
+      detail::check(mp_read_radix(&m_, str, radix));
+   }
+
+   explicit integer(const std::string &str, int radix = 10) : integer(str.c_str(), radix) {}
+
+   /* evaluates an expression, see below */
+   template <typename E, typename std::enable_if<detail::is_expr<typename std::decay<E>::type>::value, int>::type = 0>
+   integer(E &&e);
+
+   /* a zero without digits, they are allocated on the first write */
+   explicit integer(detail::empty_t) noexcept
+   {
+      release();
+   }
+
+   integer(const integer &other)
+   {
+      detail::check(mp_init_copy(&m_, &other.m_));
+   }
+
+   /* takes the digits of "other", which is left zero without digits of its own */
+   integer(integer &&other) noexcept : m_(other.m_)
+   {
+#ifdef MP_INLINE_DIGITS
+      if (other.m_.dp == other.m_.inl) {
+         m_.dp = m_.inl;
+      }
+#endif
+      other.release();
+   }
+
+   ~integer()
+   {
+      mp_clear(&m_);
+   }
+
+   /* copies into the digits already allocated */
+   integer &operator=(const integer &other)
+   {
+      if (this != &other) {
+         detail::check(mp_copy(&other.m_, get()));
+      }
+      return *this;
+   }
+
+   /* exchanges the digits, the old ones are freed with "other" */
+   integer &operator=(integer &&other) noexcept
+   {
+      swap(other);
+      return *this;
+   }
+
+   /* evaluates an expression into the digits already allocated */
+   template <typename E, typename std::enable_if<detail::is_expr<typename std::decay<E>::type>::value, int>::type = 0>
+   integer &operator=(E &&e);
+
+   void swap(integer &other) noexcept
+   {
+      mp_exch(&m_, &other.m_);
+   }
+
+   /* makes room for "digits" digits without changing the value */
+   void reserve(int digits)
+   {
+      detail::check(mp_grow(get(), digits));
+   }
+
+   int capacity() const noexcept
+   {
+      return m_.alloc;
+   }
+
+   void shrink_to_fit()
+   {
+      detail::check(mp_shrink(get()));
+   }
+
+   /* the mp_int, for the functions of the C interface */
+   mp_int *get()
+   {
+      if (m_.dp == NULL) {
+         detail::check(mp_init(&m_));
+      }
+      return &m_;
+   }
+
+   const mp_int *get() const noexcept
+   {
+      return &m_;
+   }
+
+   bool is_zero() const noexcept
+   {
+      return mp_iszero(&m_);
+   }
+
+   bool is_neg() const noexcept
+   {
+      return mp_isneg(&m_);
+   }
+
+   bool is_odd() const noexcept
+   {
+      return mp_isodd(&m_);
+   }
+
+   int bits() const noexcept
+   {
+      return mp_count_bits(&m_);
+   }
+
+   explicit operator bool() const noexcept
+   {
+      return !mp_iszero(&m_);
+   }
+
+   std::int64_t to_i64() const noexcept
+   {
+      return mp_get_i64(&m_);
+   }
+
+   std::uint64_t to_u64() const noexcept
+   {
+      return mp_get_u64(&m_);
+   }
+
+   double to_double() const noexcept
+   {
+      return mp_get_double(&m_);
+   }
+
+   std::string to_string(int radix = 10) const
+   {
+      std::size_t size, written;
+      detail::check(mp_radix_size(&m_, radix, &size));
+      std::string str(size, '\0');
+      detail::check(mp_to_radix(&m_, &str[0], size, &written, radix));
+      str.resize(written - 1u);
+      return str;
+   }
+
+   integer &operator+=(const integer &b)
+   {
+      detail::check(mp_add(get(), &b.m_, get()));
+      return *this;
+   }
+
+   integer &operator-=(const integer &b)
+   {
+      detail::check(mp_sub(get(), &b.m_, get()));
+      return *this;
+   }
+
+   integer &operator*=(const integer &b)
+   {
+      detail::check(mp_mul(get(), &b.m_, get()));
+      return *this;
+   }
+
+   /* truncating division like mp_div, the quotient and the remainder
+    * below bring their own digits
+    */
+   integer &operator/=(const integer &b)
+   {
+      detail::check(mp_div(get(), &b.m_, get(), NULL));
+      return *this;
+   }
+
+   /* remainder with the sign of b like mp_mod */
+   integer &operator%=(const integer &b)
+   {
+      detail::check(mp_mod(get(), &b.m_, get()));
+      return *this;
+   }
+
+   integer &operator&=(const integer &b)
+   {
+      detail::check(mp_and(get(), &b.m_, get()));
+      return *this;
+   }
+
+   integer &operator|=(const integer &b)
+   {
+      detail::check(mp_or(get(), &b.m_, get()));
+      return *this;
+   }
+
+   integer &operator^=(const integer &b)
+   {
+      detail::check(mp_xor(get(), &b.m_, get()));
+      return *this;
+   }
+
+   integer &operator<<=(int b)
+   {
+      detail::check(mp_mul_2d(get(), b, get()));
+      return *this;
+   }
+
+   /* rounds towards negative infinity like mp_signed_rsh */
+   integer &operator>>=(int b)
+   {
+      detail::check(mp_signed_rsh(get(), b, get()));
+      return *this;
+   }
+
+   integer &operator++()
+   {
+      detail::check(mp_incr(get()));
+      return *this;
+   }
+
+   integer &operator--()
+   {
+      detail::check(mp_decr(get()));
+      return *this;
+   }
+
+   integer operator-() const &
+   {
+      integer r(*this);
+      detail::check(mp_neg(&r.m_, &r.m_));
+      return r;
+   }
+
+   integer operator-() &&
+   {
+      detail::check(mp_neg(get(), get()));
+      return std::move(*this);
+   }
+
+   integer operator~() const
+   {
+      integer r;
+      detail::check(mp_complement(&m_, &r.m_));
+      return r;
+   }
+
+private:
+   /* leaves a valid zero behind after the digits were taken */
+   void release() noexcept
+   {
+#ifdef MP_INLINE_DIGITS
+      int i;
+      m_.dp = m_.inl;
+      m_.alloc = MP_INLINE_DIGITS;
+      for (i = 0; i < MP_INLINE_DIGITS; i++) {
+         m_.inl[i] = 0;
+      }
+#else
+      /* get() allocates the digits again on the next write */
+      m_.dp = NULL;
+      m_.alloc = 0;
+#endif
+      m_.used = 0;
+      m_.sign = MP_ZPOS;
+   }
+
+   mp_int m_;
+};
+
+inline void swap(integer &a, integer &b) noexcept
+{
+   a.swap(b);
+}
+
+/* ---> expressions <--- */
+
+/* The binary operators and shifts build an expression which is evaluated
+ * when it is assigned to an integer, straight into the digits of that
+ * integer. Each node writes its result into the destination and works on
+ * it in place, a temporary is only needed for the second of two
+ * subexpressions. (a * b + c) % m is one multiplication into the
+ * destination, one addition and one reduction in place.
+ *
+ * (x * y) % m, (x + y) % m and (x - y) % m of integers are evaluated by
+ * mp_mulmod, mp_addmod and mp_submod, x * x by mp_mul squares and
+ * x * x % m is mp_sqrmod. Integer operands which are rvalues are kept in
+ * the expression by reference and lend their digits to the result when it
+ * is evaluated, unless the expression refers to them more than once.
+ *
+ * The integers referred to must live until the expression is assigned, so
+ * expressions should not be stored in "auto" variables.
+ */
+template <typename Op, typename L, typename R>
+struct expr {
+   L l;
+   R r;
+};
+
+template <typename Op, typename L>
+struct shift_expr {
+   L l;
+   int k;
+};
+
+namespace detail {
+
+struct add_op {
+   typedef std::true_type rhs_in_place;
+   static mp_err call(const mp_int *a, const mp_int *b, mp_int *c)
+   {
+      return mp_add(a, b, c);
+   }
+   static mp_err call_mod(const mp_int *a, const mp_int *b, const mp_int *m, mp_int *c)
+   {
+      return mp_addmod(a, b, m, c);
+   }
+};
+
+struct sub_op {
+   typedef std::true_type rhs_in_place;
+   static mp_err call(const mp_int *a, const mp_int *b, mp_int *c)
+   {
+      return mp_sub(a, b, c);
+   }
+   static mp_err call_mod(const mp_int *a, const mp_int *b, const mp_int *m, mp_int *c)
+   {
+      return mp_submod(a, b, m, c);
+   }
+};
+
+struct mul_op {
+   typedef std::true_type rhs_in_place;
+   static mp_err call(const mp_int *a, const mp_int *b, mp_int *c)
+   {
+      return mp_mul(a, b, c);
+   }
+   static mp_err call_mod(const mp_int *a, const mp_int *b, const mp_int *m, mp_int *c)
+   {
+      return (a == b) ? mp_sqrmod(a, m, c) : mp_mulmod(a, b, m, c);
+   }
+};
+
+/* the division does not take its result in place of the divisor */
+struct div_op {
+   typedef std::false_type rhs_in_place;
+   static mp_err call(const mp_int *a, const mp_int *b, mp_int *c)
+   {
+      return mp_div(a, b, c, NULL);
+   }
+};
+
+struct mod_op {
+   typedef std::false_type rhs_in_place;
+   static mp_err call(const mp_int *a, const mp_int *b, mp_int *c)
+   {
+      return mp_mod(a, b, c);
+   }
+};
+
+struct and_op {
+   typedef std::true_type rhs_in_place;
+   static mp_err call(const mp_int *a, const mp_int *b, mp_int *c)
+   {
+      return mp_and(a, b, c);
+   }
+};
+
+struct or_op {
+   typedef std::true_type rhs_in_place;
+   static mp_err call(const mp_int *a, const mp_int *b, mp_int *c)
+   {
+      return mp_or(a, b, c);
+   }
+};
+
+struct xor_op {
+   typedef std::true_type rhs_in_place;
+   static mp_err call(const mp_int *a, const mp_int *b, mp_int *c)
+   {
+      return mp_xor(a, b, c);
+   }
+};
+
+struct shl_op {
+   static mp_err call(const mp_int *a, int k, mp_int *c)
+   {
+      return mp_mul_2d(a, k, c);
+   }
+};
+
+struct shr_op {
+   static mp_err call(const mp_int *a, int k, mp_int *c)
+   {
+      return mp_signed_rsh(a, k, c);
+   }
+};
+
+/* the operations which have a modular variant */
+template <typename Op> struct has_mod : std::false_type {};
+template <> struct has_mod<add_op> : std::true_type {};
+template <> struct has_mod<sub_op> : std::true_type {};
+template <> struct has_mod<mul_op> : std::true_type {};
+
+template <typename Op, typename L, typename R> struct is_expr<expr<Op, L, R> > : std::true_type {};
+template <typename Op, typename L> struct is_expr<shift_expr<Op, L> > : std::true_type {};
+
+template <typename T> struct is_leaf : std::is_same<typename std::decay<T>::type, integer> {};
+
+/* an operand of the operators */
+template <typename T>
+struct is_operand : std::integral_constant<bool,
+      is_leaf<T>::value || is_expr<typename std::decay<T>::type>::value || std::is_integral<typename std::decay<T>::type>::value> {};
+
+/* at least one operand has to be ours, the others may be integral */
+template <typename A, typename B>
+struct is_operand_pair : std::integral_constant<bool,
+      is_operand<A>::value && is_operand<B>::value &&
+      !(std::is_integral<typename std::decay<A>::type>::value && std::is_integral<typename std::decay<B>::type>::value)> {};
+
+/* how an operand is kept: integers by reference, everything else by value */
+template <typename T, bool = std::is_integral<typename std::decay<T>::type>::value>
+struct store {
+   typedef typename std::decay<T>::type type;
+};
+template <typename T> struct store<T, true> {
+   typedef integer type;
+};
+template <> struct store<integer, false> {
+   typedef integer &&type;
+};
+template <> struct store<integer &, false> {
+   typedef const integer &type;
+};
+template <> struct store<const integer &, false> {
+   typedef const integer &type;
+};
+
+inline bool contains(const integer &a, const integer &d) noexcept
+{
+   return &a == &d;
+}
+
+/* operands held by value or as rvalues may lend their digits */
+template <typename T> struct is_lent : std::integral_constant<bool, !std::is_lvalue_reference<T>::value> {};
+
+/* the root of an expression which is evaluated more than once, nothing is lent */
+struct shared_t {};
+
+/* number of references to "d" in the expression */
+inline int refs(const shared_t &, const integer &) noexcept
+{
+   return 2;
+}
+
+inline int refs(const integer &a, const integer &d) noexcept
+{
+   return (&a == &d) ? 1 : 0;
+}
+
+template <typename Op, typename L, typename R>
+int refs(const expr<Op, L, R> &e, const integer &d) noexcept
+{
+   return refs(e.l, d) + refs(e.r, d);
+}
+
+template <typename Op, typename L>
+int refs(const shift_expr<Op, L> &e, const integer &d) noexcept
+{
+   return refs(e.l, d);
+}
+
+template <typename Op, typename L, typename R>
+bool contains(const expr<Op, L, R> &e, const integer &d) noexcept
+{
+   return contains(e.l, d) || contains(e.r, d);
+}
+
+template <typename Op, typename L>
+bool contains(const shift_expr<Op, L> &e, const integer &d) noexcept
+{
+   return contains(e.l, d);
+}
+
+template <typename Op, typename L, typename R, typename T> void eval(integer &d, expr<Op, L, R> &e, const T &root);
+template <typename Op, typename L, typename T> void eval(integer &d, shift_expr<Op, L> &e, const T &root);
+template <typename Op, typename L, typename R, typename M, typename T>
+void eval(integer &d, expr<mod_op, expr<Op, L, R>, M> &e, const T &root);
+
+/* both operands are integers, the result goes into the one which lends its
+ * digits if there is one and nothing else in "root" refers to it
+ */
+template <typename Op, typename L, typename R, typename T>
+void eval_leaves(integer &d, expr<Op, L, R> &e, const T &, std::false_type, std::false_type)
+{
+   check(Op::call(e.l.get(), e.r.get(), d.get()));
+}
+
+template <typename Op, typename L, typename R, typename T, typename B>
+void eval_leaves(integer &d, expr<Op, L, R> &e, const T &root, std::true_type, B)
+{
+   if (refs(root, e.l) == 1) {
+      check(Op::call(e.l.get(), e.r.get(), e.l.get()));
+      d.swap(e.l);
+   } else {
+      eval_leaves(d, e, root, std::false_type(), B());
+   }
+}
+
+template <typename Op, typename L, typename R, typename T>
+void eval_leaves(integer &d, expr<Op, L, R> &e, const T &root, std::false_type, std::true_type)
+{
+   if (Op::rhs_in_place::value && (refs(root, e.r) == 1)) {
+      check(Op::call(e.l.get(), e.r.get(), e.r.get()));
+      d.swap(e.r);
+   } else {
+      check(Op::call(e.l.get(), e.r.get(), d.get()));
+   }
+}
+
+template <typename Op, typename L, typename R, typename T>
+void eval_bin(integer &d, expr<Op, L, R> &e, const T &root, std::true_type, std::true_type)
+{
+   eval_leaves(d, e, root, is_lent<L>(), is_lent<R>());
+}
+
+/* (expression) op integer, the expression is evaluated into d unless the
+ * integer is d
+ */
+template <typename Op, typename L, typename R, typename T>
+void eval_bin(integer &d, expr<Op, L, R> &e, const T &root, std::false_type, std::true_type)
+{
+   if (contains(e.r, d)) {
+      integer t((empty_t()));
+      eval(t, e.l, root);
+      check(Op::call(t.get(), e.r.get(), d.get()));
+   } else {
+      eval(d, e.l, root);
+      check(Op::call(d.get(), e.r.get(), d.get()));
+   }
+}
+
+/* integer op (expression) */
+template <typename Op, typename L, typename R, typename T>
+void eval_bin(integer &d, expr<Op, L, R> &e, const T &root, std::true_type, std::false_type)
+{
+   if (!Op::rhs_in_place::value || contains(e.l, d)) {
+      integer t((empty_t()));
+      eval(t, e.r, root);
+      check(Op::call(e.l.get(), t.get(), d.get()));
+   } else {
+      eval(d, e.r, root);
+      check(Op::call(e.l.get(), d.get(), d.get()));
+   }
+}
+
+/* (expression) op (expression), the right one is evaluated first such that
+ * the left one can be evaluated into d even if the right one reads it
+ */
+template <typename Op, typename L, typename R, typename T>
+void eval_bin(integer &d, expr<Op, L, R> &e, const T &root, std::false_type, std::false_type)
+{
+   integer t((empty_t()));
+   eval(t, e.r, root);
+   eval(d, e.l, root);
+   check(Op::call(d.get(), t.get(), d.get()));
+}
+
+template <typename Op, typename L, typename R, typename T>
+void eval(integer &d, expr<Op, L, R> &e, const T &root)
+{
+   eval_bin(d, e, root, is_leaf<L>(), is_leaf<R>());
+}
+
+template <typename Op, typename L, typename T>
+void eval_shift_leaf(integer &d, shift_expr<Op, L> &e, const T &, std::false_type)
+{
+   check(Op::call(e.l.get(), e.k, d.get()));
+}
+
+template <typename Op, typename L, typename T>
+void eval_shift_leaf(integer &d, shift_expr<Op, L> &e, const T &root, std::true_type)
+{
+   if (refs(root, e.l) == 1) {
+      check(Op::call(e.l.get(), e.k, e.l.get()));
+      d.swap(e.l);
+   } else {
+      check(Op::call(e.l.get(), e.k, d.get()));
+   }
+}
+
+template <typename Op, typename L, typename T>
+void eval_shift(integer &d, shift_expr<Op, L> &e, const T &root, std::true_type)
+{
+   eval_shift_leaf(d, e, root, is_lent<L>());
+}
+
+template <typename Op, typename L, typename T>
+void eval_shift(integer &d, shift_expr<Op, L> &e, const T &root, std::false_type)
+{
+   eval(d, e.l, root);
+   check(Op::call(d.get(), e.k, d.get()));
+}
+
+template <typename Op, typename L, typename T>
+void eval(integer &d, shift_expr<Op, L> &e, const T &root)
+{
+   eval_shift(d, e, root, is_leaf<L>());
+}
+
+/* (x op y) % m of integers in one call, the modular functions write their
+ * product into the destination before they read m
+ */
+template <typename Op, typename L, typename R, typename M, typename T>
+void eval_mod(integer &d, expr<mod_op, expr<Op, L, R>, M> &e, const T &root, std::true_type)
+{
+   if (contains(e.r, d)) {
+      eval_bin(d, e, root, std::false_type(), std::true_type());
+   } else {
+      check(Op::call_mod(e.l.l.get(), e.l.r.get(), e.r.get(), d.get()));
+   }
+}
+
+template <typename Op, typename L, typename R, typename M, typename T>
+void eval_mod(integer &d, expr<mod_op, expr<Op, L, R>, M> &e, const T &root, std::false_type)
+{
+   eval_bin(d, e, root, std::false_type(), is_leaf<M>());
+}
+
+template <typename Op, typename L, typename R, typename M, typename T>
+void eval(integer &d, expr<mod_op, expr<Op, L, R>, M> &e, const T &root)
+{
+   eval_mod(d, e, root, std::integral_constant<bool, has_mod<Op>::value && is_leaf<L>::value &&
+            is_leaf<R>::value && is_leaf<M>::value>());
+}
+
+template <typename E>
+void evaluate(integer &d, E &&e, std::true_type)
+{
+   eval(d, e, e);
+}
+
+/* expressions which are lvalues may be evaluated again, nothing is lent
+ * and their operands are only read
+ */
+template <typename E>
+void evaluate(integer &d, E &&e, std::false_type)
+{
+   eval(d, const_cast<typename std::decay<E>::type &>(e), shared_t());
+}
+
+}
+
+template <typename E, typename std::enable_if<detail::is_expr<typename std::decay<E>::type>::value, int>::type>
+integer::integer(E &&e) : integer(detail::empty_t())
+{
+   detail::evaluate(*this, std::forward<E>(e), std::is_rvalue_reference<E &&>());
+}
+
+template <typename E, typename std::enable_if<detail::is_expr<typename std::decay<E>::type>::value, int>::type>
+integer &integer::operator=(E &&e)
+{
+   detail::evaluate(*this, std::forward<E>(e), std::is_rvalue_reference<E &&>());
+   return *this;
+}
+
+#define TOMMATH_BINARY_OP_(op, tag)                                                               \
+template <typename A, typename B,                                                                 \
+          typename std::enable_if<detail::is_operand_pair<A, B>::value, int>::type = 0>           \
+inline expr<detail::tag, typename detail::store<A>::type, typename detail::store<B>::type>        \
+operator op(A &&a, B &&b)                                                                         \
+{                                                                                                 \
+   expr<detail::tag, typename detail::store<A>::type, typename detail::store<B>::type> e =        \
+      { std::forward<A>(a), std::forward<B>(b) };                                                 \
+   return e;                                                                                      \
+}
+
+TOMMATH_BINARY_OP_(+, add_op)
+TOMMATH_BINARY_OP_(-, sub_op)
+TOMMATH_BINARY_OP_(*, mul_op)
+TOMMATH_BINARY_OP_(/, div_op)
+TOMMATH_BINARY_OP_(%, mod_op)
+TOMMATH_BINARY_OP_(&, and_op)
+TOMMATH_BINARY_OP_(|, or_op)
+TOMMATH_BINARY_OP_(^, xor_op)
+
+#undef TOMMATH_BINARY_OP_
+
+#define TOMMATH_SHIFT_OP_(op, tag)                                                                \
+template <typename A, typename std::enable_if<detail::is_operand<A>::value &&                     \
+          !std::is_integral<typename std::decay<A>::type>::value, int>::type = 0>                 \
+inline shift_expr<detail::tag, typename detail::store<A>::type> operator op(A &&a, int k)         \
+{                                                                                                 \
+   shift_expr<detail::tag, typename detail::store<A>::type> e = { std::forward<A>(a), k };       \
+   return e;                                                                                      \
+}
+
+TOMMATH_SHIFT_OP_(<<, shl_op)
+TOMMATH_SHIFT_OP_(>>, shr_op)
+
+#undef TOMMATH_SHIFT_OP_
+
+/* the unary operators evaluate an expression first */
+template <typename E, typename std::enable_if<detail::is_expr<typename std::decay<E>::type>::value, int>::type = 0>
+inline integer operator-(E &&e)
+{
+   return -integer(std::forward<E>(e));
+}
+
+template <typename E, typename std::enable_if<detail::is_expr<typename std::decay<E>::type>::value, int>::type = 0>
+inline integer operator~(E &&e)
+{
+   return ~integer(std::forward<E>(e));
+}
+
+inline int compare(const integer &a, const integer &b) noexcept
+{
+   return static_cast<int>(mp_cmp(a.get(), b.get()));
+}
+
+inline bool operator==(const integer &a, const integer &b) noexcept
+{
+   return compare(a, b) == 0;
+}
+
+inline bool operator!=(const integer &a, const integer &b) noexcept
+{
+   return compare(a, b) != 0;
+}
+
+inline bool operator<(const integer &a, const integer &b) noexcept
+{
+   return compare(a, b) < 0;
+}
+
+inline bool operator<=(const integer &a, const integer &b) noexcept
+{
+   return compare(a, b) <= 0;
+}
+
+inline bool operator>(const integer &a, const integer &b) noexcept
+{
+   return compare(a, b) > 0;
+}
+
+inline bool operator>=(const integer &a, const integer &b) noexcept
+{
+   return compare(a, b) >= 0;
+}
+
+inline integer abs(integer a)
+{
+   detail::check(mp_abs(a.get(), a.get()));
+   return a;
+}
+
+inline integer gcd(const integer &a, const integer &b)
+{
+   integer r;
+   detail::check(mp_gcd(a.get(), b.get(), r.get()));
+   return r;
+}
+
+inline integer lcm(const integer &a, const integer &b)
+{
+   integer r;
+   detail::check(mp_lcm(a.get(), b.get(), r.get()));
+   return r;
+}
+
+inline integer pow(const integer &a, int b)
+{
+   integer r;
+   detail::check(mp_expt_n(a.get(), b, r.get()));
+   return r;
+}
+
+inline integer sqrt(const integer &a)
+{
+   integer r;
+   detail::check(mp_sqrt(a.get(), r.get()));
+   return r;
+}
+
+/* a**b (mod m) */
+inline integer powmod(const integer &a, const integer &b, const integer &m)
+{
+   integer r;
+   detail::check(mp_exptmod(a.get(), b.get(), m.get(), r.get()));
+   return r;
+}
+
+/* 1/a (mod m) */
+inline integer invmod(const integer &a, const integer &m)
+{
+   integer r;
+   detail::check(mp_invmod(a.get(), m.get(), r.get()));
+   return r;
+}
+
+inline std::ostream &operator<<(std::ostream &os, const integer &a)
+{
+   std::ios_base::fmtflags base = os.flags() & std::ios_base::basefield;
+   return os << a.to_string((base == std::ios_base::hex) ? 16 : ((base == std::ios_base::oct) ? 8 : 10));
+}
+
+}
+
+#endif
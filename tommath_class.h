@@ -16,7 +16,14 @@
 #   define MP_ADD_C
 #   define MP_ADD_D_C
 #   define MP_ADDMOD_C
+#   define MP_ALLOC_STATS_GET_C
+#   define MP_ALLOC_STATS_RESET_C
 #   define MP_AND_C
+#   define MP_BATCH_CONFIG_SET_C
+#   define MP_BATCH_EXPTMOD_C
+#   define MP_BATCH_INVMOD_C
+#   define MP_BATCH_MULMOD_C
+#   define MP_BATCH_PRIME_IS_PRIME_C
 #   define MP_CLAMP_C
 #   define MP_CLEAR_C
 #   define MP_CLEAR_MULTI_C
@@ -28,10 +35,19 @@
 #   define MP_COPY_C
 #   define MP_COUNT_BITS_C
 #   define MP_CUTOFFS_C
+#   define MP_CUTOFFS_AUTOTUNE_C
+#   define MP_CUTOFFS_GET_C
+#   define MP_CUTOFFS_LOAD_C
+#   define MP_CUTOFFS_SAVE_C
+#   define MP_CUTOFFS_SET_THREAD_C
+#   define MP_DIGIT_CACHE_FLUSH_C
+#   define MP_DIGIT_CACHE_STATS_GET_C
 #   define MP_DIV_C
 #   define MP_DIV_2_C
 #   define MP_DIV_2D_C
 #   define MP_DIV_D_C
+#   define MP_DIV_ITCH_C
+#   define MP_DIV_SCRATCH_C
 #   define MP_DR_IS_MODULUS_C
 #   define MP_DR_REDUCE_C
 #   define MP_DR_SETUP_C
@@ -39,11 +55,14 @@
 #   define MP_EXCH_C
 #   define MP_EXPT_N_C
 #   define MP_EXPTMOD_C
+#   define MP_EXPTMOD_ITCH_C
+#   define MP_EXPTMOD_SCRATCH_C
 #   define MP_EXTEUCLID_C
 #   define MP_FREAD_C
 #   define MP_FROM_SBIN_C
 #   define MP_FROM_UBIN_C
 #   define MP_FWRITE_C
+#   define MP_FWRITE_LIMBS_C
 #   define MP_GCD_C
 #   define MP_GET_DOUBLE_C
 #   define MP_GET_I32_C
@@ -70,8 +89,12 @@
 #   define MP_LCM_C
 #   define MP_LOG_N_C
 #   define MP_LSHD_C
+#   define MP_MMAP_LOAD_C
+#   define MP_MMAP_UNLOAD_C
 #   define MP_MOD_C
 #   define MP_MOD_2D_C
+#   define MP_MOD_MULTI_C
+#   define MP_MOD_MULTI_STREAM_C
 #   define MP_MONTGOMERY_CALC_NORMALIZATION_C
 #   define MP_MONTGOMERY_REDUCE_C
 #   define MP_MONTGOMERY_SETUP_C
@@ -79,6 +102,8 @@
 #   define MP_MUL_2_C
 #   define MP_MUL_2D_C
 #   define MP_MUL_D_C
+#   define MP_MUL_ITCH_C
+#   define MP_MUL_SCRATCH_C
 #   define MP_MULMOD_C
 #   define MP_NEG_C
 #   define MP_OR_C
@@ -95,6 +120,9 @@
 #   define MP_RADIX_SIZE_C
 #   define MP_RADIX_SIZE_OVERESTIMATE_C
 #   define MP_RAND_C
+#   define MP_RAND_BITS_C
+#   define MP_RAND_EX_C
+#   define MP_RAND_RANGE_C
 #   define MP_READ_RADIX_C
 #   define MP_REDUCE_C
 #   define MP_REDUCE_2K_C
@@ -104,10 +132,15 @@
 #   define MP_REDUCE_IS_2K_C
 #   define MP_REDUCE_IS_2K_L_C
 #   define MP_REDUCE_SETUP_C
+#   define MP_RNG_BYTES_C
+#   define MP_RNG_INIT_C
+#   define MP_RNG_JUMP_C
 #   define MP_ROOT_N_C
 #   define MP_RSHD_C
 #   define MP_SBIN_SIZE_C
+#   define MP_SCRATCH_RESERVE_C
 #   define MP_SET_C
+#   define MP_SET_ALLOCATOR_C
 #   define MP_SET_DOUBLE_C
 #   define MP_SET_I32_C
 #   define MP_SET_I64_C
@@ -120,6 +153,8 @@
 #   define MP_SQRMOD_C
 #   define MP_SQRT_C
 #   define MP_SQRTMOD_PRIME_C
+#   define MP_STATS_RESET_C
+#   define MP_STATS_SNAPSHOT_C
 #   define MP_SUB_C
 #   define MP_SUB_D_C
 #   define MP_SUBMOD_C
@@ -131,13 +166,38 @@
 #   define MP_XOR_C
 #   define MP_ZERO_C
 #   define S_MP_ADD_C
+#   define S_MP_ADD_DIGS_C
+#   define S_MP_ALLOC_STATS_C
+#   define S_MP_ALLOC_STATS_FREE_C
+#   define S_MP_ALLOC_STATS_MALLOC_C
+#   define S_MP_ALLOC_STATS_REALLOC_C
+#   define S_MP_ALLOCATOR_C
+#   define S_MP_BATCH_C
+#   define S_MP_BATCH_RUN_C
+#   define S_MP_BATCH_START_C
+#   define S_MP_BATCH_STOP_C
+#   define S_MP_BATCH_WORK_C
+#   define S_MP_CALLOC_C
+#   define S_MP_CHACHA20_BLOCK_C
 #   define S_MP_COPY_DIGS_C
+#   define S_MP_CUTOFFS_CHECK_C
+#   define S_MP_CUTOFFS_ENV_C
+#   define S_MP_CUTOFFS_FIELDS_C
+#   define S_MP_CUTOFFS_GET_GLOBAL_C
+#   define S_MP_CUTOFFS_LOAD_C
+#   define S_MP_CUTOFFS_SET_GLOBAL_C
+#   define S_MP_DIGIT_CACHE_C
+#   define S_MP_DIGIT_CACHE_CLASS_C
+#   define S_MP_DIGS_ALLOC_C
+#   define S_MP_DIGS_FREE_C
+#   define S_MP_DIGS_REALLOC_C
 #   define S_MP_DIV_3_C
 #   define S_MP_DIV_RECURSIVE_C
 #   define S_MP_DIV_SCHOOL_C
 #   define S_MP_DIV_SMALL_C
 #   define S_MP_EXPTMOD_C
 #   define S_MP_EXPTMOD_FAST_C
+#   define S_MP_EXPTMOD_WINSIZE_C
 #   define S_MP_GET_BIT_C
 #   define S_MP_INVMOD_C
 #   define S_MP_INVMOD_ODD_C
@@ -145,6 +205,7 @@
 #   define S_MP_LOG_2EXPT_C
 #   define S_MP_LOG_D_C
 #   define S_MP_MONTGOMERY_REDUCE_COMBA_C
+#   define S_MP_MOVE_DIGS_C
 #   define S_MP_MUL_C
 #   define S_MP_MUL_BALANCE_C
 #   define S_MP_MUL_COMBA_C
@@ -156,15 +217,43 @@
 #   define S_MP_PRIME_TAB_C
 #   define S_MP_RADIX_MAP_C
 #   define S_MP_RADIX_SIZE_OVERESTIMATE_C
+#   define S_MP_RAND_CHACHA_C
+#   define S_MP_RAND_DIGS_C
 #   define S_MP_RAND_JENKINS_C
 #   define S_MP_RAND_PLATFORM_C
+#   define S_MP_SCRATCH_C
+#   define S_MP_SCRATCH_ALLOC_C
+#   define S_MP_SCRATCH_BEGIN_C
+#   define S_MP_SCRATCH_END_C
+#   define S_MP_SCRATCH_FREE_C
+#   define S_MP_SCRATCH_INIT_C
+#   define S_MP_SCRATCH_INIT_MULTI_C
+#   define S_MP_SCRATCH_REALLOC_C
+#   define S_MP_SCRATCH_RELEASE_C
+#   define S_MP_SCRATCH_STRICT_BEGIN_C
+#   define S_MP_SCRATCH_STRICT_END_C
 #   define S_MP_SQR_C
 #   define S_MP_SQR_COMBA_C
 #   define S_MP_SQR_KARATSUBA_C
 #   define S_MP_SQR_TOOM_C
+#   define S_MP_STATS_C
+#   define S_MP_STATS_COUNT_C
 #   define S_MP_SUB_C
+#   define S_MP_SUB_DIGS_C
+#   define S_MP_THREAD_ATEXIT_C
 #   define S_MP_ZERO_BUF_C
 #   define S_MP_ZERO_DIGS_C
+#   define MPL_ADD_N_C
+#   define MPL_ADDMUL_1_C
+#   define MPL_DIVREM_1_C
+#   define MPL_LSHIFT_C
+#   define MPL_MUL_1_C
+#   define MPL_MUL_BASECASE_C
+#   define MPL_REDC_1_C
+#   define MPL_RSHIFT_C
+#   define MPL_SQR_BASECASE_C
+#   define MPL_SUB_N_C
+#   define MPL_SUBMUL_1_C
 #endif
 #endif
 #if defined(MP_2EXPT_C)
@@ -186,6 +275,7 @@
 #   define MP_CLAMP_C
 #   define MP_GROW_C
 #   define MP_SUB_D_C
+#   define S_MP_COPY_DIGS_C
 #   define S_MP_ZERO_DIGS_C
 #endif
 
@@ -194,16 +284,49 @@
 #   define MP_MOD_C
 #endif
 
+#if defined(MP_ALLOC_STATS_GET_C)
+#endif
+
+#if defined(MP_ALLOC_STATS_RESET_C)
+#endif
+
 #if defined(MP_AND_C)
 #   define MP_CLAMP_C
 #   define MP_GROW_C
+#   define S_MP_ZERO_DIGS_C
+#endif
+
+#if defined(MP_BATCH_CONFIG_SET_C)
+#   define S_MP_BATCH_STOP_C
+#endif
+
+#if defined(MP_BATCH_EXPTMOD_C)
+#   define MP_EXPTMOD_C
+#   define S_MP_BATCH_RUN_C
+#endif
+
+#if defined(MP_BATCH_INVMOD_C)
+#   define MP_INVMOD_C
+#   define S_MP_BATCH_RUN_C
+#endif
+
+#if defined(MP_BATCH_MULMOD_C)
+#   define MP_MULMOD_C
+#   define S_MP_BATCH_RUN_C
+#endif
+
+#if defined(MP_BATCH_PRIME_IS_PRIME_C)
+#   define MP_PRIME_IS_PRIME_C
+#   define S_MP_BATCH_RUN_C
 #endif
 
 #if defined(MP_CLAMP_C)
 #endif
 
 #if defined(MP_CLEAR_C)
-#   define S_MP_ZERO_DIGS_C
+#   define S_MP_DIGS_FREE_C
+#   define S_MP_SCRATCH_C
+#   define S_MP_SCRATCH_FREE_C
 #endif
 
 #if defined(MP_CLEAR_MULTI_C)
@@ -224,7 +347,8 @@
 #endif
 
 #if defined(MP_COMPLEMENT_C)
-#   define MP_SUB_D_C
+#   define MP_ADD_D_C
+#   define MP_NEG_C
 #endif
 
 #if defined(MP_COPY_C)
@@ -239,6 +363,39 @@
 #if defined(MP_CUTOFFS_C)
 #endif
 
+#if defined(MP_CUTOFFS_AUTOTUNE_C)
+#   define MP_CLEAR_MULTI_C
+#   define MP_DIV_C
+#   define MP_GROW_C
+#   define MP_INIT_MULTI_C
+#   define MP_MUL_C
+#   define MP_ZERO_C
+#   define S_MP_CUTOFFS_CHECK_C
+#   define S_MP_CUTOFFS_GET_GLOBAL_C
+#   define S_MP_CUTOFFS_SET_GLOBAL_C
+#endif
+
+#if defined(MP_CUTOFFS_GET_C)
+#endif
+
+#if defined(MP_CUTOFFS_LOAD_C)
+#   define S_MP_CUTOFFS_LOAD_C
+#endif
+
+#if defined(MP_CUTOFFS_SAVE_C)
+#   define MP_CUTOFFS_GET_C
+#endif
+
+#if defined(MP_CUTOFFS_SET_THREAD_C)
+#   define S_MP_CUTOFFS_CHECK_C
+#endif
+
+#if defined(MP_DIGIT_CACHE_FLUSH_C)
+#endif
+
+#if defined(MP_DIGIT_CACHE_STATS_GET_C)
+#endif
+
 #if defined(MP_DIV_C)
 #   define MP_CMP_MAG_C
 #   define MP_COPY_C
@@ -249,19 +406,23 @@
 #endif
 
 #if defined(MP_DIV_2_C)
+#   define MPL_RSHIFT_C
 #   define MP_CLAMP_C
 #   define MP_GROW_C
 #   define S_MP_ZERO_DIGS_C
 #endif
 
 #if defined(MP_DIV_2D_C)
+#   define MPL_RSHIFT_C
 #   define MP_CLAMP_C
-#   define MP_COPY_C
+#   define MP_GROW_C
 #   define MP_MOD_2D_C
-#   define MP_RSHD_C
+#   define S_MP_MOVE_DIGS_C
+#   define S_MP_ZERO_DIGS_C
 #endif
 
 #if defined(MP_DIV_D_C)
+#   define MPL_DIVREM_1_C
 #   define MP_CLAMP_C
 #   define MP_CLEAR_C
 #   define MP_COPY_C
@@ -272,6 +433,19 @@
 #   define S_MP_DIV_3_C
 #endif
 
+#if defined(MP_DIV_ITCH_C)
+#   define MP_MUL_ITCH_C
+#endif
+
+#if defined(MP_DIV_SCRATCH_C)
+#   define MP_CLEAR_C
+#   define MP_COPY_C
+#   define MP_DIV_C
+#   define S_MP_SCRATCH_INIT_C
+#   define S_MP_SCRATCH_STRICT_BEGIN_C
+#   define S_MP_SCRATCH_STRICT_END_C
+#endif
+
 #if defined(MP_DR_IS_MODULUS_C)
 #endif
 
@@ -311,6 +485,20 @@
 #   define S_MP_EXPTMOD_FAST_C
 #endif
 
+#if defined(MP_EXPTMOD_ITCH_C)
+#   define MP_DIV_ITCH_C
+#   define MP_MUL_ITCH_C
+#endif
+
+#if defined(MP_EXPTMOD_SCRATCH_C)
+#   define MP_CLEAR_C
+#   define MP_COPY_C
+#   define MP_EXPTMOD_C
+#   define S_MP_SCRATCH_INIT_C
+#   define S_MP_SCRATCH_STRICT_BEGIN_C
+#   define S_MP_SCRATCH_STRICT_END_C
+#endif
+
 #if defined(MP_EXTEUCLID_C)
 #   define MP_CLEAR_MULTI_C
 #   define MP_COPY_C
@@ -343,9 +531,13 @@
 #if defined(MP_FWRITE_C)
 #   define MP_RADIX_SIZE_OVERESTIMATE_C
 #   define MP_TO_RADIX_C
+#   define S_MP_ALLOCATOR_C
 #   define S_MP_ZERO_BUF_C
 #endif
 
+#if defined(MP_FWRITE_LIMBS_C)
+#endif
+
 #if defined(MP_GCD_C)
 #   define MP_ABS_C
 #   define MP_CLEAR_C
@@ -383,10 +575,16 @@
 #endif
 
 #if defined(MP_GROW_C)
+#   define S_MP_COPY_DIGS_C
+#   define S_MP_DIGS_ALLOC_C
+#   define S_MP_DIGS_REALLOC_C
+#   define S_MP_SCRATCH_C
+#   define S_MP_SCRATCH_REALLOC_C
 #   define S_MP_ZERO_DIGS_C
 #endif
 
 #if defined(MP_INIT_C)
+#   define S_MP_DIGS_ALLOC_C
 #endif
 
 #if defined(MP_INIT_COPY_C)
@@ -421,6 +619,7 @@
 #endif
 
 #if defined(MP_INIT_SIZE_C)
+#   define S_MP_DIGS_ALLOC_C
 #endif
 
 #if defined(MP_INIT_U32_C)
@@ -484,9 +683,19 @@
 
 #if defined(MP_LSHD_C)
 #   define MP_GROW_C
+#   define S_MP_MOVE_DIGS_C
 #   define S_MP_ZERO_DIGS_C
 #endif
 
+#if defined(MP_MMAP_LOAD_C)
+#   define MP_GROW_C
+#   define S_MP_COPY_DIGS_C
+#   define S_MP_ZERO_DIGS_C
+#endif
+
+#if defined(MP_MMAP_UNLOAD_C)
+#endif
+
 #if defined(MP_MOD_C)
 #   define MP_ADD_C
 #   define MP_DIV_C
@@ -499,6 +708,21 @@
 #   define S_MP_ZERO_DIGS_C
 #endif
 
+#if defined(MP_MOD_MULTI_C)
+#   define MP_MOD_MULTI_STREAM_C
+#endif
+
+#if defined(MP_MOD_MULTI_STREAM_C)
+#   define MP_CLEAR_C
+#   define MP_COPY_C
+#   define MP_INIT_C
+#   define MP_MOD_C
+#   define MP_MUL_C
+#   define S_MP_ALLOCATOR_C
+#   define S_MP_BATCH_RUN_C
+#   define S_MP_ZERO_BUF_C
+#endif
+
 #if defined(MP_MONTGOMERY_CALC_NORMALIZATION_C)
 #   define MP_2EXPT_C
 #   define MP_CMP_MAG_C
@@ -509,6 +733,7 @@
 #endif
 
 #if defined(MP_MONTGOMERY_REDUCE_C)
+#   define MPL_ADDMUL_1_C
 #   define MP_CLAMP_C
 #   define MP_CMP_MAG_C
 #   define MP_GROW_C
@@ -521,6 +746,7 @@
 #endif
 
 #if defined(MP_MUL_C)
+#   define MP_GROW_C
 #   define S_MP_MUL_BALANCE_C
 #   define S_MP_MUL_C
 #   define S_MP_MUL_COMBA_C
@@ -533,18 +759,22 @@
 #endif
 
 #if defined(MP_MUL_2_C)
+#   define MPL_LSHIFT_C
 #   define MP_GROW_C
 #   define S_MP_ZERO_DIGS_C
 #endif
 
 #if defined(MP_MUL_2D_C)
+#   define MPL_LSHIFT_C
 #   define MP_CLAMP_C
-#   define MP_COPY_C
 #   define MP_GROW_C
-#   define MP_LSHD_C
+#   define MP_ZERO_C
+#   define S_MP_MOVE_DIGS_C
+#   define S_MP_ZERO_DIGS_C
 #endif
 
 #if defined(MP_MUL_D_C)
+#   define MPL_MUL_1_C
 #   define MP_CLAMP_C
 #   define MP_COPY_C
 #   define MP_GROW_C
@@ -553,6 +783,18 @@
 #   define S_MP_ZERO_DIGS_C
 #endif
 
+#if defined(MP_MUL_ITCH_C)
+#endif
+
+#if defined(MP_MUL_SCRATCH_C)
+#   define MP_CLEAR_C
+#   define MP_COPY_C
+#   define MP_MUL_C
+#   define S_MP_SCRATCH_INIT_C
+#   define S_MP_SCRATCH_STRICT_BEGIN_C
+#   define S_MP_SCRATCH_STRICT_END_C
+#endif
+
 #if defined(MP_MULMOD_C)
 #   define MP_MOD_C
 #   define MP_MUL_C
@@ -565,6 +807,8 @@
 #if defined(MP_OR_C)
 #   define MP_CLAMP_C
 #   define MP_GROW_C
+#   define S_MP_COPY_DIGS_C
+#   define S_MP_ZERO_DIGS_C
 #endif
 
 #if defined(MP_PACK_C)
@@ -657,6 +901,7 @@
 #   define MP_MUL_2_C
 #   define MP_PRIME_IS_PRIME_C
 #   define MP_SUB_D_C
+#   define S_MP_ALLOCATOR_C
 #   define S_MP_RAND_SOURCE_C
 #   define S_MP_ZERO_BUF_C
 #endif
@@ -674,7 +919,6 @@
 #   define MP_DIV_2_C
 #   define MP_GCD_C
 #   define MP_INIT_C
-#   define MP_INIT_MULTI_C
 #   define MP_KRONECKER_C
 #   define MP_MOD_C
 #   define MP_MUL_2_C
@@ -685,6 +929,9 @@
 #   define MP_SUB_C
 #   define MP_SUB_D_C
 #   define S_MP_GET_BIT_C
+#   define S_MP_SCRATCH_BEGIN_C
+#   define S_MP_SCRATCH_END_C
+#   define S_MP_SCRATCH_INIT_MULTI_C
 #endif
 
 #if defined(MP_RADIX_SIZE_C)
@@ -697,11 +944,30 @@
 #endif
 
 #if defined(MP_RAND_C)
-#   define MP_GROW_C
+#   define MP_RAND_EX_C
 #   define MP_RAND_SOURCE_C
+#   define S_MP_RAND_CHACHA_C
+#endif
+
+#if defined(MP_RAND_BITS_C)
+#   define MP_CLAMP_C
+#   define MP_GROW_C
 #   define MP_ZERO_C
-#   define S_MP_RAND_PLATFORM_C
-#   define S_MP_RAND_SOURCE_C
+#   define S_MP_RAND_DIGS_C
+#endif
+
+#if defined(MP_RAND_EX_C)
+#   define MP_GROW_C
+#   define MP_ZERO_C
+#   define S_MP_RAND_DIGS_C
+#endif
+
+#if defined(MP_RAND_RANGE_C)
+#   define MP_CLEAR_C
+#   define MP_CMP_MAG_C
+#   define MP_COUNT_BITS_C
+#   define MP_INIT_COPY_C
+#   define MP_RAND_BITS_C
 #endif
 
 #if defined(MP_READ_RADIX_C)
@@ -723,6 +989,7 @@
 #   define MP_SET_C
 #   define MP_SUB_C
 #   define S_MP_MUL_C
+#   define S_MP_MUL_COMBA_C
 #   define S_MP_MUL_HIGH_C
 #   define S_MP_MUL_HIGH_COMBA_C
 #   define S_MP_SUB_C
@@ -778,6 +1045,16 @@
 #   define MP_DIV_C
 #endif
 
+#if defined(MP_RNG_BYTES_C)
+#   define S_MP_CHACHA20_BLOCK_C
+#endif
+
+#if defined(MP_RNG_INIT_C)
+#endif
+
+#if defined(MP_RNG_JUMP_C)
+#endif
+
 #if defined(MP_ROOT_N_C)
 #   define MP_2EXPT_C
 #   define MP_ADD_D_C
@@ -798,6 +1075,7 @@
 
 #if defined(MP_RSHD_C)
 #   define MP_ZERO_C
+#   define S_MP_MOVE_DIGS_C
 #   define S_MP_ZERO_DIGS_C
 #endif
 
@@ -805,10 +1083,23 @@
 #   define MP_UBIN_SIZE_C
 #endif
 
+#if defined(MP_SCRATCH_RESERVE_C)
+#   define S_MP_ALLOCATOR_C
+#   define S_MP_SCRATCH_C
+#   define S_MP_SCRATCH_RELEASE_C
+#   define S_MP_THREAD_ATEXIT_C
+#endif
+
 #if defined(MP_SET_C)
 #   define S_MP_ZERO_DIGS_C
 #endif
 
+#if defined(MP_SET_ALLOCATOR_C)
+#   define MP_DIGIT_CACHE_FLUSH_C
+#   define S_MP_ALLOCATOR_C
+#   define S_MP_BATCH_STOP_C
+#endif
+
 #if defined(MP_SET_DOUBLE_C)
 #   define MP_DIV_2D_C
 #   define MP_MUL_2D_C
@@ -840,10 +1131,12 @@
 #endif
 
 #if defined(MP_SHRINK_C)
+#   define S_MP_DIGS_REALLOC_C
+#   define S_MP_SCRATCH_C
 #endif
 
 #if defined(MP_SIGNED_RSH_C)
-#   define MP_ADD_D_C
+#   define MP_CNT_LSB_C
 #   define MP_DIV_2D_C
 #   define MP_SUB_D_C
 #endif
@@ -874,13 +1167,21 @@
 #   define MP_DIV_2_C
 #   define MP_DIV_D_C
 #   define MP_EXPTMOD_C
-#   define MP_INIT_MULTI_C
 #   define MP_KRONECKER_C
 #   define MP_MULMOD_C
 #   define MP_SET_C
 #   define MP_SQRMOD_C
 #   define MP_SUB_D_C
 #   define MP_ZERO_C
+#   define S_MP_SCRATCH_BEGIN_C
+#   define S_MP_SCRATCH_END_C
+#   define S_MP_SCRATCH_INIT_MULTI_C
+#endif
+
+#if defined(MP_STATS_RESET_C)
+#endif
+
+#if defined(MP_STATS_SNAPSHOT_C)
 #endif
 
 #if defined(MP_SUB_C)
@@ -893,6 +1194,7 @@
 #   define MP_ADD_D_C
 #   define MP_CLAMP_C
 #   define MP_GROW_C
+#   define S_MP_COPY_DIGS_C
 #   define S_MP_ZERO_DIGS_C
 #endif
 
@@ -931,6 +1233,8 @@
 #if defined(MP_XOR_C)
 #   define MP_CLAMP_C
 #   define MP_GROW_C
+#   define S_MP_COPY_DIGS_C
+#   define S_MP_ZERO_DIGS_C
 #endif
 
 #if defined(MP_ZERO_C)
@@ -938,14 +1242,103 @@
 #endif
 
 #if defined(S_MP_ADD_C)
+#   define MPL_ADD_N_C
 #   define MP_CLAMP_C
 #   define MP_GROW_C
+#   define S_MP_COPY_DIGS_C
 #   define S_MP_ZERO_DIGS_C
 #endif
 
+#if defined(S_MP_ADD_DIGS_C)
+#endif
+
+#if defined(S_MP_ALLOC_STATS_C)
+#endif
+
+#if defined(S_MP_ALLOC_STATS_FREE_C)
+#endif
+
+#if defined(S_MP_ALLOC_STATS_MALLOC_C)
+#endif
+
+#if defined(S_MP_ALLOC_STATS_REALLOC_C)
+#endif
+
+#if defined(S_MP_ALLOCATOR_C)
+#endif
+
+#if defined(S_MP_BATCH_C)
+#endif
+
+#if defined(S_MP_BATCH_RUN_C)
+#   define S_MP_BATCH_START_C
+#   define S_MP_BATCH_WORK_C
+#endif
+
+#if defined(S_MP_BATCH_START_C)
+#   define S_MP_BATCH_WORK_C
+#endif
+
+#if defined(S_MP_BATCH_STOP_C)
+#endif
+
+#if defined(S_MP_BATCH_WORK_C)
+#endif
+
+#if defined(S_MP_CALLOC_C)
+#   define S_MP_ALLOCATOR_C
+#   define S_MP_ZERO_BUF_C
+#endif
+
+#if defined(S_MP_CHACHA20_BLOCK_C)
+#endif
+
 #if defined(S_MP_COPY_DIGS_C)
 #endif
 
+#if defined(S_MP_CUTOFFS_CHECK_C)
+#endif
+
+#if defined(S_MP_CUTOFFS_ENV_C)
+#endif
+
+#if defined(S_MP_CUTOFFS_FIELDS_C)
+#endif
+
+#if defined(S_MP_CUTOFFS_GET_GLOBAL_C)
+#endif
+
+#if defined(S_MP_CUTOFFS_LOAD_C)
+#   define S_MP_CUTOFFS_CHECK_C
+#   define S_MP_CUTOFFS_GET_GLOBAL_C
+#   define S_MP_CUTOFFS_SET_GLOBAL_C
+#endif
+
+#if defined(S_MP_CUTOFFS_SET_GLOBAL_C)
+#endif
+
+#if defined(S_MP_DIGIT_CACHE_C)
+#endif
+
+#if defined(S_MP_DIGIT_CACHE_CLASS_C)
+#endif
+
+#if defined(S_MP_DIGS_ALLOC_C)
+#   define S_MP_CALLOC_C
+#   define S_MP_SCRATCH_ALLOC_C
+#   define S_MP_SCRATCH_C
+#endif
+
+#if defined(S_MP_DIGS_FREE_C)
+#   define S_MP_ALLOCATOR_C
+#   define S_MP_ZERO_DIGS_C
+#endif
+
+#if defined(S_MP_DIGS_REALLOC_C)
+#   define S_MP_ALLOCATOR_C
+#   define S_MP_SCRATCH_C
+#endif
+
 #if defined(S_MP_DIV_3_C)
 #   define MP_CLAMP_C
 #   define MP_CLEAR_C
@@ -960,6 +1353,7 @@
 #   define MP_COPY_C
 #   define MP_DIV_2D_C
 #   define MP_EXCH_C
+#   define MP_GROW_C
 #   define MP_INIT_MULTI_C
 #   define MP_LSHD_C
 #   define MP_MUL_2D_C
@@ -968,15 +1362,18 @@
 #   define MP_SUB_D_C
 #   define MP_ZERO_C
 #   define S_MP_DIV_SCHOOL_C
+#   define S_MP_SCRATCH_BEGIN_C
+#   define S_MP_SCRATCH_END_C
+#   define S_MP_SCRATCH_INIT_MULTI_C
 #endif
 
 #if defined(S_MP_DIV_SCHOOL_C)
-#   define MP_ADD_C
+#   define MPL_ADD_N_C
+#   define MPL_SUBMUL_1_C
 #   define MP_CLAMP_C
 #   define MP_CLEAR_C
 #   define MP_CMP_C
 #   define MP_CMP_MAG_C
-#   define MP_COPY_C
 #   define MP_COUNT_BITS_C
 #   define MP_DIV_2D_C
 #   define MP_EXCH_C
@@ -1018,6 +1415,7 @@
 #   define MP_REDUCE_C
 #   define MP_REDUCE_SETUP_C
 #   define MP_SET_C
+#   define S_MP_EXPTMOD_WINSIZE_C
 #endif
 
 #if defined(S_MP_EXPTMOD_FAST_C)
@@ -1037,7 +1435,14 @@
 #   define MP_REDUCE_2K_C
 #   define MP_REDUCE_2K_SETUP_C
 #   define MP_SET_C
+#   define S_MP_EXPTMOD_WINSIZE_C
 #   define S_MP_MONTGOMERY_REDUCE_COMBA_C
+#   define S_MP_SCRATCH_BEGIN_C
+#   define S_MP_SCRATCH_END_C
+#   define S_MP_SCRATCH_INIT_C
+#endif
+
+#if defined(S_MP_EXPTMOD_WINSIZE_C)
 #endif
 
 #if defined(S_MP_GET_BIT_C)
@@ -1101,12 +1506,15 @@
 #   define S_MP_ZERO_DIGS_C
 #endif
 
+#if defined(S_MP_MOVE_DIGS_C)
+#endif
+
 #if defined(S_MP_MUL_C)
+#   define MPL_ADDMUL_1_C
 #   define MP_CLAMP_C
 #   define MP_CLEAR_C
-#   define MP_EXCH_C
+#   define MP_COPY_C
 #   define MP_INIT_SIZE_C
-#   define S_MP_MUL_COMBA_C
 #endif
 
 #if defined(S_MP_MUL_BALANCE_C)
@@ -1115,7 +1523,6 @@
 #   define MP_CLEAR_C
 #   define MP_CLEAR_MULTI_C
 #   define MP_EXCH_C
-#   define MP_INIT_MULTI_C
 #   define MP_INIT_SIZE_C
 #   define MP_LSHD_C
 #   define MP_MUL_C
@@ -1191,6 +1598,17 @@
 #   define S_MP_LOG_2EXPT_C
 #endif
 
+#if defined(S_MP_RAND_CHACHA_C)
+#   define S_MP_CHACHA20_BLOCK_C
+#   define S_MP_RAND_PLATFORM_C
+#   define S_MP_ZERO_BUF_C
+#endif
+
+#if defined(S_MP_RAND_DIGS_C)
+#   define MP_RNG_BYTES_C
+#   define S_MP_RAND_SOURCE_C
+#endif
+
 #if defined(S_MP_RAND_JENKINS_C)
 #   define S_MP_RAND_JENKINS_INIT_C
 #endif
@@ -1198,11 +1616,69 @@
 #if defined(S_MP_RAND_PLATFORM_C)
 #endif
 
+#if defined(S_MP_SCRATCH_C)
+#endif
+
+#if defined(S_MP_SCRATCH_ALLOC_C)
+#   define S_MP_SCRATCH_C
+#   define S_MP_ZERO_DIGS_C
+#endif
+
+#if defined(S_MP_SCRATCH_BEGIN_C)
+#   define S_MP_SCRATCH_C
+#endif
+
+#if defined(S_MP_SCRATCH_END_C)
+#   define MP_SCRATCH_RESERVE_C
+#   define S_MP_SCRATCH_C
+#endif
+
+#if defined(S_MP_SCRATCH_FREE_C)
+#   define S_MP_SCRATCH_C
+#   define S_MP_ZERO_DIGS_C
+#endif
+
+#if defined(S_MP_SCRATCH_INIT_C)
+#   define MP_INIT_SIZE_C
+#   define S_MP_SCRATCH_ALLOC_C
+#endif
+
+#if defined(S_MP_SCRATCH_INIT_MULTI_C)
+#   define MP_CLEAR_C
+#   define S_MP_SCRATCH_INIT_C
+#endif
+
+#if defined(S_MP_SCRATCH_REALLOC_C)
+#   define S_MP_ALLOCATOR_C
+#   define S_MP_COPY_DIGS_C
+#   define S_MP_SCRATCH_ALLOC_C
+#   define S_MP_SCRATCH_C
+#   define S_MP_SCRATCH_FREE_C
+#endif
+
+#if defined(S_MP_SCRATCH_RELEASE_C)
+#   define S_MP_ALLOCATOR_C
+#   define S_MP_SCRATCH_C
+#   define S_MP_ZERO_BUF_C
+#endif
+
+#if defined(S_MP_SCRATCH_STRICT_BEGIN_C)
+#   define S_MP_SCRATCH_BEGIN_C
+#   define S_MP_SCRATCH_C
+#endif
+
+#if defined(S_MP_SCRATCH_STRICT_END_C)
+#   define S_MP_SCRATCH_C
+#   define S_MP_SCRATCH_END_C
+#endif
+
 #if defined(S_MP_SQR_C)
+#   define MPL_SQR_BASECASE_C
 #   define MP_CLAMP_C
 #   define MP_CLEAR_C
-#   define MP_EXCH_C
+#   define MP_COPY_C
 #   define MP_INIT_SIZE_C
+#   define MP_ZERO_C
 #endif
 
 #if defined(S_MP_SQR_COMBA_C)
@@ -1237,18 +1713,76 @@
 #   define S_MP_COPY_DIGS_C
 #endif
 
+#if defined(S_MP_STATS_C)
+#endif
+
+#if defined(S_MP_STATS_COUNT_C)
+#endif
+
 #if defined(S_MP_SUB_C)
+#   define MPL_SUB_N_C
 #   define MP_CLAMP_C
 #   define MP_GROW_C
+#   define S_MP_COPY_DIGS_C
 #   define S_MP_ZERO_DIGS_C
 #endif
 
+#if defined(S_MP_SUB_DIGS_C)
+#endif
+
+#if defined(S_MP_THREAD_ATEXIT_C)
+#   define MP_DIGIT_CACHE_FLUSH_C
+#   define S_MP_SCRATCH_RELEASE_C
+#endif
+
 #if defined(S_MP_ZERO_BUF_C)
 #endif
 
 #if defined(S_MP_ZERO_DIGS_C)
 #endif
 
+#if defined(MPL_ADD_N_C)
+#   define S_MP_ADD_DIGS_C
+#endif
+
+#if defined(MPL_ADDMUL_1_C)
+#endif
+
+#if defined(MPL_DIVREM_1_C)
+#endif
+
+#if defined(MPL_LSHIFT_C)
+#endif
+
+#if defined(MPL_MUL_1_C)
+#endif
+
+#if defined(MPL_MUL_BASECASE_C)
+#   define MPL_ADDMUL_1_C
+#   define MPL_MUL_1_C
+#endif
+
+#if defined(MPL_REDC_1_C)
+#   define MPL_ADDMUL_1_C
+#   define MPL_ADD_N_C
+#endif
+
+#if defined(MPL_RSHIFT_C)
+#endif
+
+#if defined(MPL_SQR_BASECASE_C)
+#   define MPL_ADDMUL_1_C
+#   define MPL_LSHIFT_C
+#   define MPL_MUL_1_C
+#endif
+
+#if defined(MPL_SUB_N_C)
+#   define S_MP_SUB_DIGS_C
+#endif
+
+#if defined(MPL_SUBMUL_1_C)
+#endif
+
 #ifdef LTM_INSIDE
 #undef LTM_INSIDE
 #ifdef LTM3
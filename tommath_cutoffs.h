@@ -11,3 +11,13 @@
 #define MP_DEFAULT_SQR_KARATSUBA_CUTOFF 120
 #define MP_DEFAULT_MUL_TOOM_CUTOFF      350
 #define MP_DEFAULT_SQR_TOOM_CUTOFF      400
+#define MP_DEFAULT_MUL_COMBA_CUTOFF     INT_MAX
+#define MP_DEFAULT_SQR_COMBA_CUTOFF     INT_MAX
+#define MP_DEFAULT_MUL_BALANCE_CUTOFF   2
+#define MP_DEFAULT_DIV_RECURSIVE_CUTOFF 161
+#define MP_DEFAULT_EXPTMOD_WIN3_CUTOFF  8
+#define MP_DEFAULT_EXPTMOD_WIN4_CUTOFF  37
+#define MP_DEFAULT_EXPTMOD_WIN5_CUTOFF  141
+#define MP_DEFAULT_EXPTMOD_WIN6_CUTOFF  451
+#define MP_DEFAULT_EXPTMOD_WIN7_CUTOFF  1304
+#define MP_DEFAULT_EXPTMOD_WIN8_CUTOFF  3530
@@ -0,0 +1,543 @@
+/* LibTomMath, multiple-precision integer library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#ifndef TOMMATH_FIXED_HPP_
+#define TOMMATH_FIXED_HPP_
+
+/* C++14 fixed width integers, header only.
+ *
+ * tommath::fixed<Bits> is an unsigned integer below 2**Bits in the digits
+ * of an mp_int, which are stored inline. Its size is known at compile time,
+ * such that there is no allocation, no clamping and every loop of the
+ * kernels below has a constant trip count, which the compiler unrolls.
+ * The arithmetic operators wrap around like those of the unsigned types,
+ * tommath::montgomery<Bits> does the arithmetic modulo an odd number.
+ *
+ * All of it is constexpr, constants like a modulus can be written as a
+ * literal, e.g. 0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff_u256,
+ * and are evaluated at compile time.
+ */
+
+#if (__cplusplus < 201402L) && !(defined(_MSVC_LANG) && (_MSVC_LANG >= 201402L))
+#   error tommath_fixed.hpp needs C++14
+#endif
+
+#include <climits>
+
+#include "tommath.hpp"
+
+namespace tommath {
+
+template <int Bits> class montgomery;
+
+namespace detail {
+
+/* the same as mp_word in the library */
+#if defined(MP_16BIT)
+typedef std::uint32_t word;
+#elif defined(MP_64BIT)
+typedef unsigned long word __attribute__((mode(TI)));
+#else
+typedef std::uint64_t word;
+#endif
+
+/* the number of digits which can be summed up in a column of the comba
+ * multiplication, MP_MAX_COMBA of the library
+ */
+constexpr int fixed_comba = 1 << ((int)(sizeof(word) * CHAR_BIT) - (2 * MP_DIGIT_BIT));
+
+/* c = a + b of N digits, returns the carry, c may be a or b */
+template <int N>
+constexpr mp_digit fixed_add(const mp_digit *a, const mp_digit *b, mp_digit *c)
+{
+   mp_digit u = 0;
+   for (int i = 0; i < N; ++i) {
+      mp_digit t = static_cast<mp_digit>(a[i] + b[i] + u);
+      u = static_cast<mp_digit>(t >> MP_DIGIT_BIT);
+      c[i] = static_cast<mp_digit>(t & MP_MASK);
+   }
+   return u;
+}
+
+/* c = a - b of N digits, returns the borrow, c may be a or b */
+template <int N>
+constexpr mp_digit fixed_sub(const mp_digit *a, const mp_digit *b, mp_digit *c)
+{
+   mp_digit u = 0;
+   for (int i = 0; i < N; ++i) {
+      mp_digit t = static_cast<mp_digit>(a[i] - b[i] - u);
+      u = static_cast<mp_digit>(t >> ((sizeof(mp_digit) * CHAR_BIT) - 1u));
+      c[i] = static_cast<mp_digit>(t & MP_MASK);
+   }
+   return u;
+}
+
+template <int N>
+constexpr int fixed_cmp(const mp_digit *a, const mp_digit *b)
+{
+   for (int i = N - 1; i >= 0; --i) {
+      if (a[i] != b[i]) {
+         return (a[i] > b[i]) ? 1 : -1;
+      }
+   }
+   return 0;
+}
+
+/* c = c + a * b of N digits, returns the high digit */
+template <int N>
+constexpr mp_digit fixed_addmul_1(const mp_digit *a, mp_digit b, mp_digit *c)
+{
+   mp_digit u = 0;
+   for (int i = 0; i < N; ++i) {
+      word t = static_cast<word>(c[i]) + (static_cast<word>(a[i]) * b) + u;
+      c[i] = static_cast<mp_digit>(t & MP_MASK);
+      u = static_cast<mp_digit>(t >> MP_DIGIT_BIT);
+   }
+   return u;
+}
+
+/* c = a * b with c of 2 * N digits, by columns like s_mp_mul_comba or by
+ * rows if a column could overflow the double digit
+ */
+template <int N>
+constexpr void fixed_mul(const mp_digit *a, const mp_digit *b, mp_digit *c)
+{
+   if (N < fixed_comba) {
+      word w = 0;
+      for (int k = 0; k < (2 * N) - 1; ++k) {
+         int i = (k < N) ? 0 : ((k - N) + 1), j = k - i;
+         for (; (i < N) && (j >= 0); ++i, --j) {
+            w += static_cast<word>(a[i]) * b[j];
+         }
+         c[k] = static_cast<mp_digit>(w & MP_MASK);
+         w >>= MP_DIGIT_BIT;
+      }
+      c[(2 * N) - 1] = static_cast<mp_digit>(w);
+   } else {
+      for (int i = 0; i < N; ++i) {
+         c[i] = 0;
+      }
+      for (int i = 0; i < N; ++i) {
+         c[i + N] = fixed_addmul_1<N>(b, a[i], c + i);
+      }
+   }
+}
+
+/* c = x/B**N (mod m) of x < m * B**N with 2 * N digits, which are destroyed,
+ * like mpl_redc_1. The result is below m.
+ */
+template <int N>
+constexpr void fixed_redc(mp_digit *x, const mp_digit *m, mp_digit rho, mp_digit *c)
+{
+   mp_digit u = 0;
+   for (int i = 0; i < N; ++i) {
+      mp_digit mu = static_cast<mp_digit>((static_cast<word>(x[i]) * rho) & MP_MASK);
+      x[i] = fixed_addmul_1<N>(m, mu, x + i);
+   }
+   u = fixed_add<N>(x + N, x, c);
+   if ((u != 0u) || (fixed_cmp<N>(c, m) >= 0)) {
+      fixed_sub<N>(c, m, c);
+   }
+}
+
+}
+
+template <int Bits>
+class fixed {
+   static_assert(Bits > 0, "a fixed width integer needs at least one bit");
+
+public:
+   /* the number of digits, each of MP_DIGIT_BIT bits */
+   static constexpr int digits = (Bits + MP_DIGIT_BIT - 1) / MP_DIGIT_BIT;
+
+   constexpr fixed() noexcept : dp_{} {}
+
+   template <typename T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, int>::type = 0>
+   constexpr fixed(T v) noexcept : dp_{}
+   {
+      std::uint64_t u = v;
+      for (int i = 0; (i < digits) && (u != 0u); ++i) {
+         dp_[i] = static_cast<mp_digit>(u & MP_MASK);
+         u >>= MP_DIGIT_BIT;
+      }
+      mask();
+   }
+
+   /* copies the digits of a, which must neither be negative nor have more than Bits bits */
+   explicit fixed(const mp_int *a) : dp_{}
+   {
+      if (mp_isneg(a) || (mp_count_bits(a) > Bits)) {
+         throw error(MP_VAL);
+      }
+      for (int i = 0; i < a->used; ++i) {
+         dp_[i] = a->dp[i];
+      }
+   }
+
+   explicit fixed(const integer &a) : fixed(a.get()) {}
+
+   /* decimal, or hexadecimal with a leading 0x, "'" separates digits */
+   static constexpr fixed parse(const char *str)
+   {
+      fixed r;
+      mp_digit radix = 10;
+      if ((str[0] == '0') && ((str[1] == 'x') || (str[1] == 'X'))) {
+         radix = 16;
+         str += 2;
+      }
+      if (*str == '\0') {
+         throw error(MP_VAL);
+      }
+      for (; *str != '\0'; ++str) {
+         char ch = *str;
+         mp_digit d = 0, u = 0;
+         if (ch == '\'') {
+            continue;
+         } else if ((ch >= '0') && (ch <= '9')) {
+            d = static_cast<mp_digit>(ch - '0');
+         } else if ((radix == 16) && (ch >= 'a') && (ch <= 'f')) {
+            d = static_cast<mp_digit>((ch - 'a') + 10);
+         } else if ((radix == 16) && (ch >= 'A') && (ch <= 'F')) {
+            d = static_cast<mp_digit>((ch - 'A') + 10);
+         } else {
+            throw error(MP_VAL);
+         }
+         u = d;
+         for (int i = 0; i < digits; ++i) {
+            detail::word t = (static_cast<detail::word>(r.dp_[i]) * radix) + u;
+            r.dp_[i] = static_cast<mp_digit>(t & MP_MASK);
+            u = static_cast<mp_digit>(t >> MP_DIGIT_BIT);
+         }
+         if ((u != 0u) || ((r.dp_[digits - 1] & static_cast<mp_digit>(~top_mask)) != 0u)) {
+            throw error(MP_VAL);
+         }
+      }
+      return r;
+   }
+
+   /* the digits without copying them. The mp_int must only be passed as a
+    * const argument and must not be cleared.
+    */
+   mp_int view() const noexcept
+   {
+      mp_int a = mp_int();
+      a.dp = const_cast<mp_digit *>(dp_);
+      a.alloc = digits;
+      a.used = used();
+      a.sign = MP_ZPOS;
+      return a;
+   }
+
+   integer to_integer() const
+   {
+      mp_int a = view();
+      integer r;
+      detail::check(mp_copy(&a, r.get()));
+      return r;
+   }
+
+   constexpr const mp_digit *data() const noexcept
+   {
+      return dp_;
+   }
+
+   constexpr mp_digit *data() noexcept
+   {
+      return dp_;
+   }
+
+   constexpr bool is_zero() const noexcept
+   {
+      return used() == 0;
+   }
+
+   constexpr bool is_odd() const noexcept
+   {
+      return (dp_[0] & 1u) != 0u;
+   }
+
+   constexpr bool bit(int i) const noexcept
+   {
+      return ((dp_[i / MP_DIGIT_BIT] >> (i % MP_DIGIT_BIT)) & 1u) != 0u;
+   }
+
+   constexpr int bits() const noexcept
+   {
+      int n = used(), r = 0;
+      if (n == 0) {
+         return 0;
+      }
+      for (mp_digit d = dp_[n - 1]; d != 0u; d >>= 1) {
+         ++r;
+      }
+      return ((n - 1) * MP_DIGIT_BIT) + r;
+   }
+
+   /* the digits without the leading zeros */
+   constexpr int used() const noexcept
+   {
+      int n = digits;
+      while ((n > 0) && (dp_[n - 1] == 0u)) {
+         --n;
+      }
+      return n;
+   }
+
+   constexpr fixed &operator+=(const fixed &b) noexcept
+   {
+      detail::fixed_add<digits>(dp_, b.dp_, dp_);
+      mask();
+      return *this;
+   }
+
+   constexpr fixed &operator-=(const fixed &b) noexcept
+   {
+      detail::fixed_sub<digits>(dp_, b.dp_, dp_);
+      mask();
+      return *this;
+   }
+
+   constexpr fixed &operator*=(const fixed &b) noexcept
+   {
+      mp_digit t[2 * digits] = {};
+      detail::fixed_mul<digits>(dp_, b.dp_, t);
+      for (int i = 0; i < digits; ++i) {
+         dp_[i] = t[i];
+      }
+      mask();
+      return *this;
+   }
+
+private:
+   static constexpr mp_digit top_mask = ((Bits % MP_DIGIT_BIT) == 0) ? MP_MASK :
+                                        static_cast<mp_digit>((static_cast<mp_digit>(1) << (Bits % MP_DIGIT_BIT)) - 1u);
+
+   /* reduces modulo 2**Bits */
+   constexpr void mask() noexcept
+   {
+      dp_[digits - 1] &= top_mask;
+   }
+
+   mp_digit dp_[digits];
+
+   friend class montgomery<Bits>;
+};
+
+template <int Bits>
+constexpr fixed<Bits> operator+(fixed<Bits> a, const fixed<Bits> &b) noexcept
+{
+   return a += b;
+}
+
+template <int Bits>
+constexpr fixed<Bits> operator-(fixed<Bits> a, const fixed<Bits> &b) noexcept
+{
+   return a -= b;
+}
+
+template <int Bits>
+constexpr fixed<Bits> operator*(fixed<Bits> a, const fixed<Bits> &b) noexcept
+{
+   return a *= b;
+}
+
+/* the full product */
+template <int Bits>
+constexpr fixed<2 * Bits> mul_wide(const fixed<Bits> &a, const fixed<Bits> &b) noexcept
+{
+   mp_digit t[2 * fixed<Bits>::digits] = {};
+   fixed<2 * Bits> r;
+   detail::fixed_mul<fixed<Bits>::digits>(a.data(), b.data(), t);
+   for (int i = 0; i < fixed<2 * Bits>::digits; ++i) {
+      r.data()[i] = t[i];
+   }
+   return r;
+}
+
+template <int Bits>
+constexpr int compare(const fixed<Bits> &a, const fixed<Bits> &b) noexcept
+{
+   return detail::fixed_cmp<fixed<Bits>::digits>(a.data(), b.data());
+}
+
+template <int Bits>
+constexpr bool operator==(const fixed<Bits> &a, const fixed<Bits> &b) noexcept
+{
+   return compare(a, b) == 0;
+}
+
+template <int Bits>
+constexpr bool operator!=(const fixed<Bits> &a, const fixed<Bits> &b) noexcept
+{
+   return compare(a, b) != 0;
+}
+
+template <int Bits>
+constexpr bool operator<(const fixed<Bits> &a, const fixed<Bits> &b) noexcept
+{
+   return compare(a, b) < 0;
+}
+
+template <int Bits>
+constexpr bool operator<=(const fixed<Bits> &a, const fixed<Bits> &b) noexcept
+{
+   return compare(a, b) <= 0;
+}
+
+template <int Bits>
+constexpr bool operator>(const fixed<Bits> &a, const fixed<Bits> &b) noexcept
+{
+   return compare(a, b) > 0;
+}
+
+template <int Bits>
+constexpr bool operator>=(const fixed<Bits> &a, const fixed<Bits> &b) noexcept
+{
+   return compare(a, b) >= 0;
+}
+
+template <int Bits>
+std::ostream &operator<<(std::ostream &os, const fixed<Bits> &a)
+{
+   return os << a.to_integer();
+}
+
+/* Arithmetic modulo an odd m below 2**Bits on numbers in Montgomery form,
+ * a * R (mod m) with R = B**digits. "to" and "from" convert into and out of
+ * it, the other functions take and return numbers below m in that form.
+ */
+template <int Bits>
+class montgomery {
+public:
+   typedef fixed<Bits> value_type;
+
+   constexpr explicit montgomery(const fixed<Bits> &m) : m_(m), r2_(), rho_(0)
+   {
+      detail::word x = 0;
+
+      if (!m.is_odd()) {
+         throw error(MP_VAL);
+      }
+
+      /* -1/m (mod B) by Newton's iteration like mp_montgomery_setup, each
+       * step doubles the bits which are correct, starting with four
+       */
+      x = (((m.dp_[0] + 2u) & 4u) << 1) + m.dp_[0];
+      for (int i = 4; i < MP_DIGIT_BIT; i *= 2) {
+         x *= 2u - (m.dp_[0] * x);
+      }
+      rho_ = static_cast<mp_digit>(((static_cast<detail::word>(1) << MP_DIGIT_BIT) - (x & MP_MASK)) & MP_MASK);
+
+      /* R**2 (mod m) by doubling 1 */
+      r2_.dp_[0] = (m.used() == 1 && m.dp_[0] == 1u) ? 0u : 1u;
+      for (int i = 0; i < 2 * n * MP_DIGIT_BIT; ++i) {
+         mp_digit u = detail::fixed_add<n>(r2_.dp_, r2_.dp_, r2_.dp_);
+         if ((u != 0u) || (r2_ >= m_)) {
+            detail::fixed_sub<n>(r2_.dp_, m_.dp_, r2_.dp_);
+         }
+      }
+   }
+
+   constexpr const fixed<Bits> &modulus() const noexcept
+   {
+      return m_;
+   }
+
+   /* a * R (mod m) for any a */
+   constexpr fixed<Bits> to(const fixed<Bits> &a) const noexcept
+   {
+      return mul(a, r2_);
+   }
+
+   constexpr fixed<Bits> from(const fixed<Bits> &a) const noexcept
+   {
+      mp_digit t[2 * n] = {};
+      fixed<Bits> r;
+      for (int i = 0; i < n; ++i) {
+         t[i] = a.dp_[i];
+      }
+      detail::fixed_redc<n>(t, m_.dp_, rho_, r.dp_);
+      return r;
+   }
+
+   constexpr fixed<Bits> one() const noexcept
+   {
+      return from(r2_);
+   }
+
+   constexpr fixed<Bits> mul(const fixed<Bits> &a, const fixed<Bits> &b) const noexcept
+   {
+      mp_digit t[2 * n] = {};
+      fixed<Bits> r;
+      detail::fixed_mul<n>(a.dp_, b.dp_, t);
+      detail::fixed_redc<n>(t, m_.dp_, rho_, r.dp_);
+      return r;
+   }
+
+   constexpr fixed<Bits> sqr(const fixed<Bits> &a) const noexcept
+   {
+      return mul(a, a);
+   }
+
+   constexpr fixed<Bits> add(const fixed<Bits> &a, const fixed<Bits> &b) const noexcept
+   {
+      fixed<Bits> r;
+      mp_digit u = detail::fixed_add<n>(a.dp_, b.dp_, r.dp_);
+      if ((u != 0u) || (r >= m_)) {
+         detail::fixed_sub<n>(r.dp_, m_.dp_, r.dp_);
+      }
+      return r;
+   }
+
+   constexpr fixed<Bits> sub(const fixed<Bits> &a, const fixed<Bits> &b) const noexcept
+   {
+      fixed<Bits> r;
+      if (detail::fixed_sub<n>(a.dp_, b.dp_, r.dp_) != 0u) {
+         detail::fixed_add<n>(r.dp_, m_.dp_, r.dp_);
+      }
+      return r;
+   }
+
+   /* a**e, left to right */
+   template <int EBits>
+   constexpr fixed<Bits> pow(const fixed<Bits> &a, const fixed<EBits> &e) const noexcept
+   {
+      fixed<Bits> r = one();
+      for (int i = e.bits() - 1; i >= 0; --i) {
+         r = sqr(r);
+         if (e.bit(i)) {
+            r = mul(r, a);
+         }
+      }
+      return r;
+   }
+
+private:
+   static constexpr int n = fixed<Bits>::digits;
+
+   fixed<Bits> m_, r2_;
+   mp_digit rho_;
+};
+
+namespace literals {
+
+#define TOMMATH_FIXED_LITERAL_(bits)                                                              \
+template <char... C>                                                                              \
+constexpr fixed<bits> operator"" _u##bits()                                                       \
+{                                                                                                 \
+   const char str[] = { C..., '\0' };                                                             \
+   return fixed<bits>::parse(str);                                                                \
+}
+
+TOMMATH_FIXED_LITERAL_(128)
+TOMMATH_FIXED_LITERAL_(192)
+TOMMATH_FIXED_LITERAL_(256)
+TOMMATH_FIXED_LITERAL_(384)
+TOMMATH_FIXED_LITERAL_(512)
+
+#undef TOMMATH_FIXED_LITERAL_
+
+}
+
+}
+
+#endif
@@ -65,12 +65,32 @@ do {                                                    \
 } while (0)
 #endif
 
+/* Thread local storage
+ * --------------------
+ *
+ * Used for per-thread caches, which are disabled if the compiler
+ * does not support thread local storage or if MP_NO_THREAD_LOCAL
+ * is defined.
+ */
+#if !defined(MP_NO_THREAD_LOCAL) && !defined(MP_THREAD_LOCAL)
+#  if defined(__GNUC__)
+#     define MP_THREAD_LOCAL __thread
+#  elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#     define MP_THREAD_LOCAL _Thread_local
+#  elif defined(_MSC_VER)
+#     define MP_THREAD_LOCAL __declspec(thread)
+#  endif
+#endif
+
 /* Tunable cutoffs
  * ---------------
  *
  *  - In the default settings, a cutoff X can be modified at runtime
  *    by adjusting the corresponding X_CUTOFF variable.
  *
+ *  - A thread can install its own cutoffs by mp_cutoffs_set_thread,
+ *    the library reads them by MP_CUTOFF.
+ *
  *  - Tunability of the library can be disabled at compile time
  *    by defining the MP_FIXED_CUTOFFS macro.
  *
@@ -86,16 +106,113 @@ do {                                                    \
 #  define MP_SQR_KARATSUBA_CUTOFF MP_DEFAULT_SQR_KARATSUBA_CUTOFF
 #  define MP_MUL_TOOM_CUTOFF      MP_DEFAULT_MUL_TOOM_CUTOFF
 #  define MP_SQR_TOOM_CUTOFF      MP_DEFAULT_SQR_TOOM_CUTOFF
+#  define MP_MUL_COMBA_CUTOFF     MP_DEFAULT_MUL_COMBA_CUTOFF
+#  define MP_SQR_COMBA_CUTOFF     MP_DEFAULT_SQR_COMBA_CUTOFF
+#  define MP_MUL_BALANCE_CUTOFF   MP_DEFAULT_MUL_BALANCE_CUTOFF
+#  define MP_DIV_RECURSIVE_CUTOFF MP_DEFAULT_DIV_RECURSIVE_CUTOFF
+#  define MP_EXPTMOD_WIN3_CUTOFF  MP_DEFAULT_EXPTMOD_WIN3_CUTOFF
+#  define MP_EXPTMOD_WIN4_CUTOFF  MP_DEFAULT_EXPTMOD_WIN4_CUTOFF
+#  define MP_EXPTMOD_WIN5_CUTOFF  MP_DEFAULT_EXPTMOD_WIN5_CUTOFF
+#  define MP_EXPTMOD_WIN6_CUTOFF  MP_DEFAULT_EXPTMOD_WIN6_CUTOFF
+#  define MP_EXPTMOD_WIN7_CUTOFF  MP_DEFAULT_EXPTMOD_WIN7_CUTOFF
+#  define MP_EXPTMOD_WIN8_CUTOFF  MP_DEFAULT_EXPTMOD_WIN8_CUTOFF
+#  define MP_CUTOFF(c, C)         MP_##C##_CUTOFF
+#elif defined(MP_THREAD_LOCAL)
+/* the cutoffs installed by mp_cutoffs_set_thread take precedence */
+typedef struct {
+   mp_cutoffs cutoffs;
+   bool set;
+} s_mp_cutoffs_state;
+extern MP_PRIVATE MP_THREAD_LOCAL s_mp_cutoffs_state s_mp_cutoffs_thread;
+#  define MP_CUTOFF(c, C)         (s_mp_cutoffs_thread.set ? s_mp_cutoffs_thread.cutoffs.c : MP_##C##_CUTOFF)
+#else
+#  define MP_CUTOFF(c, C)         MP_##C##_CUTOFF
+#endif
+
+/* smallest cutoff of Karatsuba and Toom-Cook accepted by mp_cutoffs_set_thread,
+ * the smallest ratio of s_mp_mul_balance is 2
+ */
+#define MP_MIN_CUTOFF 3
+
+/* the cutoffs in the files of mp_cutoffs_load and mp_cutoffs_save */
+typedef struct {
+   const char *name;
+   size_t offset;
+} s_mp_cutoffs_field;
+#define MP_CUTOFFS_FIELDS 14
+extern MP_PRIVATE const s_mp_cutoffs_field s_mp_cutoffs_fields[MP_CUTOFFS_FIELDS];
+
+MP_PRIVATE mp_err s_mp_cutoffs_check(const mp_cutoffs *cutoffs) MP_WUR;
+MP_PRIVATE void s_mp_cutoffs_get_global(mp_cutoffs *cutoffs);
+#ifndef MP_FIXED_CUTOFFS
+MP_PRIVATE void s_mp_cutoffs_set_global(const mp_cutoffs *cutoffs);
+#  ifndef MP_NO_FILE
+MP_PRIVATE mp_err s_mp_cutoffs_load(const char *path);
+#  endif
+#endif
+
+/* If MP_CUTOFFS_FROM_ENV is defined, the file named by the environment variable LTM_CUTOFFS
+ * is loaded at the first use of the cutoffs by mp_mul, mp_div, mp_exptmod or mp_cutoffs_*.
+ */
+#if defined(MP_CUTOFFS_FROM_ENV) && !defined(MP_FIXED_CUTOFFS) && !defined(MP_NO_FILE)
+#  define MP_HAS_CUTOFFS_ENV
+#  ifdef MP_THREAD_LOCAL
+extern MP_PRIVATE MP_THREAD_LOCAL bool s_mp_cutoffs_env_done;
+#  else
+extern MP_PRIVATE bool s_mp_cutoffs_env_done;
+#  endif
+MP_PRIVATE void s_mp_cutoffs_env(void);
+#  define MP_CUTOFFS_ENV() do { if (!s_mp_cutoffs_env_done) { s_mp_cutoffs_env(); } } while (0)
+#else
+#  define MP_CUTOFFS_ENV() do { } while (0)
+#endif
+
+/* Heap macros
+ * -----------
+ *
+ *  - In the default settings, the heap functions can be replaced at
+ *    runtime by mp_set_allocator. They default to libc.
+ *
+ *  - Defining MP_FIXED_ALLOCATOR at compile time calls libc directly,
+ *    without the indirection.
+ *
+ *  - Defining MP_MALLOC, MP_REALLOC, MP_CALLOC and MP_FREE at compile
+ *    time calls the given heap functions directly.
+ *
+ *  - Defining MP_ALLOC_STATS at compile time counts the calls of the
+ *    first two variants per thread, see mp_alloc_stats_get. It needs
+ *    thread local storage.
+ */
+#if defined(MP_ALLOC_STATS) && (defined(MP_MALLOC) || !defined(MP_THREAD_LOCAL))
+#   undef MP_ALLOC_STATS
 #endif
 
-/* define heap macros */
 #ifndef MP_MALLOC
+#   ifdef MP_FIXED_ALLOCATOR
 /* default to libc stuff */
-#   include <stdlib.h>
-#   define MP_MALLOC(size)                   malloc(size)
-#   define MP_REALLOC(mem, oldsize, newsize) realloc((mem), (newsize))
-#   define MP_CALLOC(nmemb, size)            calloc((nmemb), (size))
-#   define MP_FREE(mem, size)                free(mem)
+#      include <stdlib.h>
+#      define MP_HEAP_MALLOC(size)                   malloc(size)
+#      define MP_HEAP_REALLOC(mem, oldsize, newsize) realloc((mem), (newsize))
+#      define MP_HEAP_CALLOC(nmemb, size)            calloc((nmemb), (size))
+#      define MP_HEAP_FREE(mem, size)                free(mem)
+#   else
+#      define MP_RUNTIME_ALLOCATOR
+#      define MP_HEAP_MALLOC(size)                   s_mp_allocator.malloc_fn(s_mp_allocator.ctx, (size))
+#      define MP_HEAP_REALLOC(mem, oldsize, newsize) s_mp_allocator.realloc_fn(s_mp_allocator.ctx, (mem), (oldsize), (newsize))
+#      define MP_HEAP_CALLOC(nmemb, size)            s_mp_calloc((nmemb), (size))
+#      define MP_HEAP_FREE(mem, size)                s_mp_allocator.free_fn(s_mp_allocator.ctx, (mem), (size))
+#   endif
+#   ifdef MP_ALLOC_STATS
+#      define MP_MALLOC(size)                   s_mp_alloc_stats_malloc(size)
+#      define MP_REALLOC(mem, oldsize, newsize) s_mp_alloc_stats_realloc((mem), (oldsize), (newsize))
+#      define MP_CALLOC(nmemb, size)            s_mp_calloc((nmemb), (size))
+#      define MP_FREE(mem, size)                s_mp_alloc_stats_free((mem), (size))
+#   else
+#      define MP_MALLOC(size)                   MP_HEAP_MALLOC(size)
+#      define MP_REALLOC(mem, oldsize, newsize) MP_HEAP_REALLOC((mem), (oldsize), (newsize))
+#      define MP_CALLOC(nmemb, size)            MP_HEAP_CALLOC((nmemb), (size))
+#      define MP_FREE(mem, size)                MP_HEAP_FREE((mem), (size))
+#   endif
 #else
 /* prototypes for our heap functions */
 extern void *MP_MALLOC(size_t size);
@@ -130,6 +247,12 @@ extern void MP_FREE(void *mem, size_t size);
 #define MP_MAX_COMBA            (int)(1uL << (MP_SIZEOF_BITS(mp_word) - (2u * (size_t)MP_DIGIT_BIT)))
 #define MP_WARRAY               (int)(1uL << ((MP_SIZEOF_BITS(mp_word) - (2u * (size_t)MP_DIGIT_BIT)) + 1u))
 
+/* digits per block of s_mp_add_digs and s_mp_sub_digs, and the
+ * number of digits from which on they are used by s_mp_add and s_mp_sub
+ */
+#define MP_CARRY_BLOCK          64
+#define MP_CARRY_DIGS           (2 * MP_CARRY_BLOCK)
+
 #if defined(MP_16BIT)
 typedef uint32_t mp_word;
 #elif defined(MP_64BIT)
@@ -157,6 +280,14 @@ MP_STATIC_ASSERT(correct_word_size, sizeof(mp_word) == (2u * sizeof(mp_digit)))
 #define MP_MIN_DIGIT_COUNT MP_MAX(3, (((int)MP_SIZEOF_BITS(uint64_t) + MP_DIGIT_BIT) - 1) / MP_DIGIT_BIT)
 MP_STATIC_ASSERT(prec_geq_min_prec, MP_DEFAULT_DIGIT_COUNT >= MP_MIN_DIGIT_COUNT)
 
+/* true if the digits are stored in the mp_int itself */
+#ifdef MP_INLINE_DIGITS
+MP_STATIC_ASSERT(inline_geq_min_prec, MP_INLINE_DIGITS >= MP_MIN_DIGIT_COUNT)
+#  define MP_INLINE_OWNS(a) ((a)->dp == (a)->inl)
+#else
+#  define MP_INLINE_OWNS(a) false
+#endif
+
 /* Maximum number of digits.
  * - Must be small enough such that mp_bit_count does not overflow.
  * - Must be small enough such that mp_radix_size for base 2 does not overflow.
@@ -171,6 +302,202 @@ MP_STATIC_ASSERT(prec_geq_min_prec, MP_DEFAULT_DIGIT_COUNT >= MP_MIN_DIGIT_COUNT
 #define MP_HAS_SET_DOUBLE
 #endif
 
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#define MP_HAS_MMAP
+#endif
+
+#if !defined(MP_NO_THREADS) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__)))
+#define MP_HAS_PTHREAD
+#endif
+
+/* Native limb file format
+ * -----------------------
+ *
+ * Header written by mp_fwrite_limbs, followed by "used" digits in
+ * native byte order, such that the digits can be mapped directly.
+ * The magic number is stored in native byte order as well, files
+ * of a different endianness or digit size are rejected.
+ */
+#define MP_LIMBS_MAGIC 0x4C544D4Eu /* "LTMN" */
+typedef struct {
+   uint32_t magic;
+   uint8_t  digit_size;
+   uint8_t  digit_bit;
+   uint8_t  sign;
+   uint8_t  reserved;
+   uint64_t used;
+} s_mp_limbs_header;
+
+MP_STATIC_ASSERT(limbs_header_size, sizeof(s_mp_limbs_header) == 16u)
+MP_STATIC_ASSERT(limbs_header_align, (sizeof(s_mp_limbs_header) % sizeof(mp_digit)) == 0u)
+
+/* runtime allocator */
+extern MP_PRIVATE mp_allocator s_mp_allocator;
+extern MP_PRIVATE const mp_allocator s_mp_allocator_default;
+
+/* Scratch arena
+ * -------------
+ *
+ * Temporaries which do not escape a function can be initialized with
+ * s_mp_scratch_init inside of a scope opened by s_mp_scratch_begin.
+ * Their digits are then allocated from a thread local region, which
+ * works like a stack: freed blocks are released as soon as all blocks
+ * above them are freed, and grown blocks move to the top unless they
+ * are at the top already. The whole region is released when the
+ * outermost scope is closed by s_mp_scratch_end. If the region is too
+ * small, the heap is used as well and the region is enlarged up to
+ * MP_SCRATCH_MAX bytes when the outermost scope is closed.
+ *
+ * In strict mode the region is supplied by the caller and every
+ * allocation is taken from it, the heap is never used.
+ *
+ * Scratch temporaries must never be exchanged into an mp_int which
+ * outlives the scope.
+ */
+#ifndef MP_SCRATCH_MAX
+#   define MP_SCRATCH_MAX (1u << 20)
+#endif
+#ifndef MP_SCRATCH_BLOCKS
+#   define MP_SCRATCH_BLOCKS 512
+#endif
+
+#ifdef MP_THREAD_LOCAL
+typedef struct {
+   mp_digit *base, *own_base;
+   size_t size, own_size, top, spill, wanted;
+   /* offsets of the blocks, shifted left by one, the lowest bit marks freed blocks */
+   size_t blk[MP_SCRATCH_BLOCKS];
+   int nblk, depth;
+   bool strict;
+} s_mp_scratch_arena;
+extern MP_PRIVATE MP_THREAD_LOCAL s_mp_scratch_arena s_mp_scratch;
+#  define MP_SCRATCH_OWNS(dp) ((s_mp_scratch.base != NULL) && \
+                               ((dp) >= s_mp_scratch.base) && ((dp) < (s_mp_scratch.base + s_mp_scratch.size)))
+#else
+#  define MP_SCRATCH_OWNS(dp) false
+#endif
+
+/* true while running on a caller supplied scratch region */
+#ifdef MP_THREAD_LOCAL
+#  define MP_SCRATCH_STRICT s_mp_scratch.strict
+#else
+#  define MP_SCRATCH_STRICT false
+#endif
+
+/* Digit cache
+ * -----------
+ *
+ * If MP_DIGIT_CACHE is defined, digit buffers with a power of two
+ * number of digits are not freed but kept in per-thread free lists,
+ * at most MP_DIGIT_CACHE_DEPTH of each size. Requests up to the
+ * largest class are rounded up to the next class, such that growing
+ * an mp_int jumps from one class to the next.
+ */
+#if defined(MP_DIGIT_CACHE) && !defined(MP_THREAD_LOCAL)
+#   undef MP_DIGIT_CACHE
+#endif
+
+#ifdef MP_DIGIT_CACHE
+#   ifndef MP_DIGIT_CACHE_DEPTH
+#      define MP_DIGIT_CACHE_DEPTH 8
+#   endif
+/* the classes hold 2^2 up to 2^12 digits */
+#   define MP_DIGIT_CACHE_MIN     2
+#   define MP_DIGIT_CACHE_CLASSES 11
+typedef struct {
+   mp_digit *slot[MP_DIGIT_CACHE_CLASSES][MP_DIGIT_CACHE_DEPTH];
+   int count[MP_DIGIT_CACHE_CLASSES];
+   mp_digit_cache_stats stats;
+} s_mp_digit_cache_state;
+extern MP_PRIVATE MP_THREAD_LOCAL s_mp_digit_cache_state s_mp_digit_cache;
+#endif
+
+/* Heap statistics
+ * ---------------
+ *
+ * The functions listed in mp_alloc_op tag the calling thread on entry,
+ * nested calls keep the tag of the outermost one.
+ */
+#ifdef MP_ALLOC_STATS
+typedef struct {
+   mp_alloc_stats stats;
+   mp_alloc_op op;
+   int depth;
+} s_mp_alloc_stats_state;
+extern MP_PRIVATE MP_THREAD_LOCAL s_mp_alloc_stats_state s_mp_alloc_stats;
+#  define MP_ALLOC_OP_ENTER(o) do { if (s_mp_alloc_stats.depth++ == 0) { s_mp_alloc_stats.op = (o); } } while (0)
+#  define MP_ALLOC_OP_LEAVE()  do { if (--s_mp_alloc_stats.depth == 0) { s_mp_alloc_stats.op = MP_ALLOC_OP_NONE; } } while (0)
+#else
+#  define MP_ALLOC_OP_ENTER(o) do { } while (0)
+#  define MP_ALLOC_OP_LEAVE()  do { } while (0)
+#endif
+
+/* Dispatch statistics
+ * -------------------
+ *
+ * Defining MP_STATS at compile time counts the paths taken by mp_mul,
+ * mp_exptmod and mp_div per thread, with the size of the operand which
+ * the choice depends on. Nested calls, e.g. the products of Karatsuba,
+ * are counted as well. Without it MP_STATS_COUNT is empty.
+ */
+#if defined(MP_STATS) && !defined(MP_THREAD_LOCAL)
+#  undef MP_STATS
+#endif
+#ifdef MP_STATS
+extern MP_PRIVATE MP_THREAD_LOCAL mp_stats s_mp_stats;
+#  define MP_STATS_COUNT(path, size) s_mp_stats_count((path), (size))
+#else
+#  define MP_STATS_COUNT(path, size) do { } while (0)
+#endif
+
+/* Batch pool
+ * ----------
+ *
+ * A batch is run by the calling thread together with the workers of the
+ * pool, each of them takes a chunk of the remaining elements at a time.
+ * The pool runs one batch at a time, a batch started while it is busy,
+ * e.g. from within a batch, runs on the calling thread only. The workers
+ * use the cutoffs of the thread which started the batch.
+ */
+typedef mp_err(*s_mp_batch_op)(const void *args, size_t i);
+typedef struct {
+   s_mp_batch_op op;
+   const void *args;
+   mp_err *errs;
+   size_t n, next, done;
+   size_t failed;      /* first element which failed */
+   mp_err err;
+   int workers;
+#if !defined(MP_FIXED_CUTOFFS) && defined(MP_THREAD_LOCAL)
+   s_mp_cutoffs_state cutoffs;
+#endif
+} s_mp_batch_job;
+
+#ifdef MP_HAS_PTHREAD
+#include <pthread.h>
+#ifndef MP_BATCH_MAX_THREADS
+#  define MP_BATCH_MAX_THREADS 256
+#endif
+typedef struct {
+   mp_batch_config config;
+   bool configured;
+   pthread_t thread[MP_BATCH_MAX_THREADS];
+   int threads;        /* number of running workers */
+   int busy;           /* workers inside of the current job */
+   bool stop;
+   unsigned long gen;  /* incremented for each job */
+   s_mp_batch_job *job;
+} s_mp_batch_pool_state;
+extern MP_PRIVATE s_mp_batch_pool_state s_mp_batch_pool;
+extern MP_PRIVATE pthread_mutex_t s_mp_batch_lock;
+extern MP_PRIVATE pthread_cond_t s_mp_batch_work_cond, s_mp_batch_idle_cond;
+#  define MP_BATCH_LOCK()   do { (void)pthread_mutex_lock(&s_mp_batch_lock); } while (0)
+#  define MP_BATCH_UNLOCK() do { (void)pthread_mutex_unlock(&s_mp_batch_lock); } while (0)
+#else
+#  define MP_BATCH_LOCK()   do { } while (0)
+#  define MP_BATCH_UNLOCK() do { } while (0)
+#endif
+
 /* random number source */
 extern MP_PRIVATE mp_err(*s_mp_rand_source)(void *out, size_t size);
 
@@ -179,12 +506,26 @@ MP_PRIVATE bool s_mp_get_bit(const mp_int *a, int b) MP_WUR;
 MP_PRIVATE int s_mp_log_2expt(const mp_int *a, mp_digit base) MP_WUR;
 MP_PRIVATE int s_mp_log_d(mp_digit base, mp_digit n) MP_WUR;
 MP_PRIVATE mp_err s_mp_add(const mp_int *a, const mp_int *b, mp_int *c) MP_WUR;
+MP_PRIVATE void *s_mp_alloc_stats_malloc(size_t size) MP_WUR;
+MP_PRIVATE void *s_mp_alloc_stats_realloc(void *mem, size_t oldsize, size_t newsize) MP_WUR;
+MP_PRIVATE void s_mp_alloc_stats_free(void *mem, size_t size);
+MP_PRIVATE mp_err s_mp_batch_run(s_mp_batch_op op, const void *args, mp_err *errs, size_t n) MP_WUR;
+MP_PRIVATE mp_err s_mp_batch_start(void) MP_WUR;
+MP_PRIVATE void s_mp_batch_stop(void);
+MP_PRIVATE void s_mp_batch_work(s_mp_batch_job *job);
+MP_PRIVATE void *s_mp_calloc(size_t nmemb, size_t size) MP_WUR;
+MP_PRIVATE void s_mp_chacha20_block(const uint32_t key[8], uint32_t counter, const uint32_t nonce[3], uint8_t out[64]);
+MP_PRIVATE int s_mp_digit_cache_class(int size) MP_WUR;
+MP_PRIVATE mp_digit *s_mp_digs_alloc(int *size) MP_WUR;
+MP_PRIVATE mp_digit *s_mp_digs_realloc(mp_digit *dp, int oldsize, int *newsize) MP_WUR;
+MP_PRIVATE void s_mp_digs_free(mp_digit *dp, int size);
 MP_PRIVATE mp_err s_mp_div_3(const mp_int *a, mp_int *c, mp_digit *d) MP_WUR;
 MP_PRIVATE mp_err s_mp_div_recursive(const mp_int *a, const mp_int *b, mp_int *q, mp_int *r) MP_WUR;
 MP_PRIVATE mp_err s_mp_div_school(const mp_int *a, const mp_int *b, mp_int *c, mp_int *d) MP_WUR;
 MP_PRIVATE mp_err s_mp_div_small(const mp_int *a, const mp_int *b, mp_int *c, mp_int *d) MP_WUR;
 MP_PRIVATE mp_err s_mp_exptmod(const mp_int *G, const mp_int *X, const mp_int *P, mp_int *Y, int redmode) MP_WUR;
 MP_PRIVATE mp_err s_mp_exptmod_fast(const mp_int *G, const mp_int *X, const mp_int *P, mp_int *Y, int redmode) MP_WUR;
+MP_PRIVATE int s_mp_exptmod_winsize(int bits) MP_WUR;
 MP_PRIVATE mp_err s_mp_invmod(const mp_int *a, const mp_int *b, mp_int *c) MP_WUR;
 MP_PRIVATE mp_err s_mp_invmod_odd(const mp_int *a, const mp_int *b, mp_int *c) MP_WUR;
 MP_PRIVATE mp_err s_mp_log(const mp_int *a, mp_digit base, int *c) MP_WUR;
@@ -197,18 +538,35 @@ MP_PRIVATE mp_err s_mp_mul_high_comba(const mp_int *a, const mp_int *b, mp_int *
 MP_PRIVATE mp_err s_mp_mul_karatsuba(const mp_int *a, const mp_int *b, mp_int *c) MP_WUR;
 MP_PRIVATE mp_err s_mp_mul_toom(const mp_int *a, const mp_int *b, mp_int *c) MP_WUR;
 MP_PRIVATE mp_err s_mp_prime_is_divisible(const mp_int *a, bool *result) MP_WUR;
+MP_PRIVATE mp_err s_mp_rand_chacha(void *p, size_t n) MP_WUR;
+MP_PRIVATE mp_err s_mp_rand_digs(mp_rng *rng, mp_digit *dp, int digits) MP_WUR;
 MP_PRIVATE mp_err s_mp_rand_platform(void *p, size_t n) MP_WUR;
 MP_PRIVATE mp_err s_mp_sqr(const mp_int *a, mp_int *b) MP_WUR;
 MP_PRIVATE mp_err s_mp_sqr_comba(const mp_int *a, mp_int *b) MP_WUR;
 MP_PRIVATE mp_err s_mp_sqr_karatsuba(const mp_int *a, mp_int *b) MP_WUR;
 MP_PRIVATE mp_err s_mp_sqr_toom(const mp_int *a, mp_int *b) MP_WUR;
+MP_PRIVATE void s_mp_stats_count(mp_stats_path path, int size);
 MP_PRIVATE mp_err s_mp_sub(const mp_int *a, const mp_int *b, mp_int *c) MP_WUR;
+MP_PRIVATE mp_digit s_mp_add_digs(const mp_digit *a, const mp_digit *b, mp_digit *c, int n);
+MP_PRIVATE mp_digit s_mp_sub_digs(const mp_digit *a, const mp_digit *b, mp_digit *c, int n);
 MP_PRIVATE void s_mp_copy_digs(mp_digit *d, const mp_digit *s, int digits);
+MP_PRIVATE void s_mp_move_digs(mp_digit *d, const mp_digit *s, int digits);
 MP_PRIVATE void s_mp_zero_buf(void *mem, size_t size);
 MP_PRIVATE void s_mp_zero_digs(mp_digit *d, int digits);
 MP_PRIVATE mp_err s_mp_radix_size_overestimate(const mp_int *a, const int radix, size_t *size);
-
-/* TODO: jenkins prng is not thread safe as of now */
+MP_PRIVATE mp_digit *s_mp_scratch_alloc(int size) MP_WUR;
+MP_PRIVATE void s_mp_scratch_begin(void);
+MP_PRIVATE void s_mp_scratch_end(void);
+MP_PRIVATE mp_err s_mp_scratch_strict_begin(mp_digit *scratch, size_t size) MP_WUR;
+MP_PRIVATE void s_mp_scratch_strict_end(void);
+MP_PRIVATE mp_err s_mp_scratch_init(mp_int *a, int size) MP_WUR;
+MP_PRIVATE mp_err s_mp_scratch_init_multi(mp_int *mp, ...) MP_NULL_TERMINATED MP_WUR;
+MP_PRIVATE mp_digit *s_mp_scratch_realloc(mp_digit *dp, int oldsize, int newsize) MP_WUR;
+MP_PRIVATE void s_mp_scratch_free(mp_digit *dp, int size);
+MP_PRIVATE void s_mp_scratch_release(void);
+MP_PRIVATE void s_mp_thread_atexit(void);
+
+/* the jenkins prng keeps its state per thread, it is shared without MP_THREAD_LOCAL */
 MP_PRIVATE mp_err s_mp_rand_jenkins(void *p, size_t n) MP_WUR;
 MP_PRIVATE void s_mp_rand_jenkins_init(uint64_t seed);
 